@@ -0,0 +1,273 @@
+﻿#pragma once
+
+
+#ifndef FS_AFFINE3X4_H
+#define FS_AFFINE3X4_H
+// === HEADER BEGINS ===
+
+
+#include <Core/Float4.h>
+#include <Core/Float4x4.h>
+
+
+namespace fs
+{
+	// SSE (members are Float4)
+	// affine transform stored as the top 3 rows of a 4x4 matrix. The implicit last row is (0, 0, 0, 1).
+	// row i == (m[i][0], m[i][1], m[i][2], translation[i])
+	// 48 bytes instead of 64, and composing or transforming skips the constant row.
+	// header-only and trivially copyable (except the batch functions)
+	class alignas(16) Affine3x4 final
+	{
+	public:
+		// identity
+		explicit constexpr		Affine3x4();
+		constexpr				Affine3x4(float m00, float m01, float m02, float m03,
+										float m10, float m11, float m12, float m13,
+										float m20, float m21, float m22, float m23);
+		constexpr				Affine3x4(const Float4& row0, const Float4& row1, const Float4& row2);
+		// drops the last row of m, which must be (0, 0, 0, 1)
+		explicit				Affine3x4(const Float4x4& m);
+								Affine3x4(const Affine3x4& b)				= default;
+								Affine3x4(Affine3x4&& b) noexcept			= default;
+								~Affine3x4()								= default;
+
+	public:
+		Affine3x4&				operator=(const Affine3x4& b)				= default;
+		Affine3x4&				operator=(Affine3x4&& b) noexcept			= default;
+
+	public:
+		// compose: (l * r) applies r first
+		Affine3x4				operator*(const Affine3x4& r) const noexcept;
+
+	public:
+		const Float4&			getRow(uint32 rowIndex) const noexcept;
+		// (m03, m13, m23, 0)
+		Float4					getTranslation() const noexcept;
+
+		// exact: the rows are copied and (0, 0, 0, 1) is appended
+		constexpr Float4x4		toFloat4x4() const noexcept;
+
+	public:
+		// Any invertible affine transform. Inverts the 3x3 part with cross products and applies it to the translation.
+		Affine3x4				inverse() const noexcept;
+		// Only when the columns of the 3x3 part are orthogonal, i.e. rotation * scaling (any TRS world matrix).
+		// The 3x3 inverse is then the transpose with each row divided by its squared length: one division, no cross products.
+		Affine3x4				inverseOrthogonal() const noexcept;
+
+		// (x, y, z, 1) -> (x', y', z', 1). The w of p is ignored.
+		Float4					transformPoint(const Float4& p) const noexcept;
+		// (x, y, z, 0) -> (x', y', z', 0). No translation. The w of v is ignored.
+		Float4					transformVector(const Float4& v) const noexcept;
+
+	private:
+		Float4					_row[3];
+
+
+	// static functions
+	public:
+		static Affine3x4		mul(const Affine3x4& l, const Affine3x4& r) noexcept;
+
+		// out[i] = transformPoint(in[i]) / transformVector(in[i]), 4 (SSE) or 8 (AVX2 + FMA, chosen at runtime) at a time.
+		// in and out must have the same size and may be the same.
+		static void				transformPoints(const Affine3x4& m, std::span<const Float4> in, std::span<Float4> out) noexcept;
+		static void				transformVectors(const Affine3x4& m, std::span<const Float4> in, std::span<Float4> out) noexcept;
+
+		static constexpr Affine3x4	translationMatrix(float x, float y, float z) noexcept;
+		static constexpr Affine3x4	scalingMatrix(float x, float y, float z) noexcept;
+		// q must be a unit quaternion
+		static Affine3x4		rotationMatrix(const Quaternion& q) noexcept;
+		// translation * rotation * scaling, built directly (no products). The w of translation and scaling are ignored.
+		static Affine3x4		translationRotationScaling(const Float4& translation, const Quaternion& rotation, const Float4& scaling) noexcept;
+	};
+
+	// alias
+	using affine3x4 = Affine3x4;
+
+	static_assert(std::is_trivially_copyable<Affine3x4>::value, "Affine3x4 must be trivially copyable.");
+	static_assert(sizeof(Affine3x4) == sizeof(float) * 12, "Affine3x4 must be tightly packed.");
+
+
+	constexpr Affine3x4::Affine3x4() : Affine3x4
+		(
+			1, 0, 0, 0,
+			0, 1, 0, 0,
+			0, 0, 1, 0
+		)
+	{
+		__noop;
+	}
+
+	constexpr Affine3x4::Affine3x4(float m00, float m01, float m02, float m03,
+		float m10, float m11, float m12, float m13,
+		float m20, float m21, float m22, float m23) :
+		_row{
+				Float4( m00, m01, m02, m03 ),
+				Float4( m10, m11, m12, m13 ),
+				Float4( m20, m21, m22, m23 )
+			}
+	{
+		__noop;
+	}
+
+	constexpr Affine3x4::Affine3x4(const Float4& row0, const Float4& row1, const Float4& row2)
+		: _row{ row0, row1, row2 }
+	{
+		__noop;
+	}
+
+	inline Affine3x4::Affine3x4(const Float4x4& m)
+		: _row{ m.getRow(0), m.getRow(1), m.getRow(2) }
+	{
+		__noop;
+	}
+
+	inline Affine3x4 Affine3x4::operator*(const Affine3x4& r) const noexcept
+	{
+		return Affine3x4::mul(*this, r);
+	}
+
+	inline const Float4& Affine3x4::getRow(uint32 rowIndex) const noexcept
+	{
+		return _row[rowIndex];
+	}
+
+	inline Float4 Affine3x4::getTranslation() const noexcept
+	{
+		return Float4(_row[0].getW(), _row[1].getW(), _row[2].getW(), 0);
+	}
+
+	constexpr Float4x4 Affine3x4::toFloat4x4() const noexcept
+	{
+		return Float4x4(_row[0], _row[1], _row[2], Float4(0, 0, 0, 1));
+	}
+
+	inline Affine3x4 Affine3x4::inverse() const noexcept
+	{
+		// Float4x4::inverseAffine() never reads the last row and always writes (0, 0, 0, 1), so this is the same math.
+		return Affine3x4(toFloat4x4().inverseAffine());
+	}
+
+	inline Affine3x4 Affine3x4::inverseOrthogonal() const noexcept
+	{
+		// R == Q * S (Q orthonormal, S diagonal)  =>  inverse(R) == inverse(S) * transpose(Q) == transpose(R) / (squared column lengths)
+		const __m128 mask{ _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0)) };
+		const Float4 r0{ _mm_and_ps(_row[0]._data, mask) };
+		const Float4 r1{ _mm_and_ps(_row[1]._data, mask) };
+		const Float4 r2{ _mm_and_ps(_row[2]._data, mask) };
+
+		// squared length of each column, 1 in w so the division stays finite
+		const Float4 squaredLengths{ Float4::multiplyAdd(r2, r2, Float4::multiplyAdd(r1, r1, r0 * r0)) + Float4(0, 0, 0, 1) };
+		const Float4 reciprocal{ _mm_and_ps(_mm_div_ps(_mm_set1_ps(1.0f), squaredLengths._data), mask) };
+
+		// the rows of R / (squared column lengths) are the columns of inverse(R)
+		const Float4 column0{ r0 * reciprocal };
+		const Float4 column1{ r1 * reciprocal };
+		const Float4 column2{ r2 * reciprocal };
+
+		// -inverse(R) * t
+		const Float4 t
+		{
+			Float4::multiplyAdd(column2, _row[2].splatW(),
+			Float4::multiplyAdd(column1, _row[1].splatW(),
+			column0 * _row[0].splatW()))
+		};
+
+		__m128 row0{ column0._data };
+		__m128 row1{ column1._data };
+		__m128 row2{ column2._data };
+		__m128 translation{ _mm_sub_ps(_mm_setzero_ps(), t._data) };
+		_MM_TRANSPOSE4_PS(row0, row1, row2, translation);
+		return Affine3x4(Float4(row0), Float4(row1), Float4(row2));
+	}
+
+	inline Float4 Affine3x4::transformPoint(const Float4& p) const noexcept
+	{
+		// columns of the 4x4 matrix; column3 == (t, 1)
+		__m128 column0{ _row[0]._data };
+		__m128 column1{ _row[1]._data };
+		__m128 column2{ _row[2]._data };
+		__m128 column3{ _mm_setr_ps(0, 0, 0, 1) };
+		_MM_TRANSPOSE4_PS(column0, column1, column2, column3);
+
+		Float4 result{ Float4::multiplyAdd(Float4(column0), p.splatX(), Float4(column3)) };
+		result = Float4::multiplyAdd(Float4(column1), p.splatY(), result);
+		result = Float4::multiplyAdd(Float4(column2), p.splatZ(), result);
+		return result;
+	}
+
+	inline Float4 Affine3x4::transformVector(const Float4& v) const noexcept
+	{
+		// columns of the 3x3 part (w == 0)
+		__m128 column0{ _row[0]._data };
+		__m128 column1{ _row[1]._data };
+		__m128 column2{ _row[2]._data };
+		__m128 column3{ _mm_setzero_ps() };
+		_MM_TRANSPOSE4_PS(column0, column1, column2, column3);
+
+		Float4 result{ Float4(column0) * v.splatX() };
+		result = Float4::multiplyAdd(Float4(column1), v.splatY(), result);
+		result = Float4::multiplyAdd(Float4(column2), v.splatZ(), result);
+		return result;
+	}
+
+	inline Affine3x4 Affine3x4::mul(const Affine3x4& l, const Affine3x4& r) noexcept
+	{
+		// row i of (l * r) == l[i][0] * r.row0 + l[i][1] * r.row1 + l[i][2] * r.row2 + l[i][3] * (0, 0, 0, 1)
+		const __m128 wMask{ _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1)) };
+		Affine3x4 result{ l };
+		for (uint32 i = 0; i < 3; ++i)
+		{
+			const Float4& lRow{ l._row[i] };
+			Float4 row{ Float4::multiplyAdd(lRow.splatX(), r._row[0], Float4(_mm_and_ps(lRow._data, wMask))) };
+			row = Float4::multiplyAdd(lRow.splatY(), r._row[1], row);
+			row = Float4::multiplyAdd(lRow.splatZ(), r._row[2], row);
+			result._row[i] = row;
+		}
+		return result;
+	}
+
+	constexpr Affine3x4 Affine3x4::translationMatrix(float x, float y, float z) noexcept
+	{
+		return Affine3x4
+		(
+			1, 0, 0, x,
+			0, 1, 0, y,
+			0, 0, 1, z
+		);
+	}
+
+	constexpr Affine3x4 Affine3x4::scalingMatrix(float x, float y, float z) noexcept
+	{
+		return Affine3x4
+		(
+			x, 0, 0, 0,
+			0, y, 0, 0,
+			0, 0, z, 0
+		);
+	}
+
+	inline Affine3x4 Affine3x4::rotationMatrix(const Quaternion& q) noexcept
+	{
+		return Affine3x4(q.toMatrix());
+	}
+
+	inline Affine3x4 Affine3x4::translationRotationScaling(const Float4& translation, const Quaternion& rotation, const Float4& scaling) noexcept
+	{
+		// R * S scales the columns of R; the translation goes to w
+		const __m128 mask{ _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0)) };
+		const __m128 wMask{ _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1)) };
+		const Float4 s{ _mm_and_ps(scaling._data, mask) };
+		const Float4x4 r{ rotation.toMatrix() };
+		return Affine3x4
+		(
+			Float4::multiplyAdd(r.getRow(0), s, Float4(_mm_and_ps(translation.splatX()._data, wMask))),
+			Float4::multiplyAdd(r.getRow(1), s, Float4(_mm_and_ps(translation.splatY()._data, wMask))),
+			Float4::multiplyAdd(r.getRow(2), s, Float4(_mm_and_ps(translation.splatZ()._data, wMask)))
+		);
+	}
+}
+
+
+// === HEADER ENDS ===
+#endif // !FS_AFFINE3X4_H
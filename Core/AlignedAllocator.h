@@ -0,0 +1,67 @@
+﻿#pragma once
+
+
+#ifndef FS_ALIGNED_ALLOCATOR_H
+#define FS_ALIGNED_ALLOCATOR_H
+// === HEADER BEGINS ===
+
+
+#include <Core/_CommonTypes.h>
+#include <new>
+
+
+namespace fs
+{
+	// std::allocator that aligns every allocation to Alignment bytes (e.g. 64 == one cache line, one AVX-512 register)
+	template <typename T, size_t Alignment>
+	class AlignedAllocator
+	{
+		static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two.");
+
+	public:
+		using value_type = T;
+
+		template <typename U>
+		struct rebind
+		{
+			using other = AlignedAllocator<U, Alignment>;
+		};
+
+	public:
+		AlignedAllocator() noexcept = default;
+		template <typename U>
+		AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept
+		{
+			__noop;
+		}
+
+	public:
+		T* allocate(size_t count)
+		{
+			return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ Alignment }));
+		}
+
+		void deallocate(T* pointer, size_t count) noexcept
+		{
+			(void)count;
+			::operator delete(pointer, std::align_val_t{ Alignment });
+		}
+
+	public:
+		template <typename U>
+		bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept
+		{
+			return true;
+		}
+
+		template <typename U>
+		bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept
+		{
+			return false;
+		}
+	};
+}
+
+
+// === HEADER ENDS ===
+#endif // !FS_ALIGNED_ALLOCATOR_H
@@ -0,0 +1,88 @@
+﻿#pragma once
+
+
+#ifndef FS_BATCH_KERNELS_H
+#define FS_BATCH_KERNELS_H
+// === HEADER BEGINS ===
+
+
+#include <Core/CpuFeatures.h>
+
+#include <immintrin.h>
+#include <type_traits>
+
+
+// Internal to the Float4 batch kernels (Float4.cpp, Float4x4.cpp, Affine3x4.cpp). Do not include from public headers.
+namespace fs
+{
+	// 4 Float4s (AoS) -> x, y, z, w (SoA)
+	inline void loadTransposed4(const float* in, __m128& x, __m128& y, __m128& z, __m128& w) noexcept
+	{
+		x = _mm_loadu_ps(in + 0);
+		y = _mm_loadu_ps(in + 4);
+		z = _mm_loadu_ps(in + 8);
+		w = _mm_loadu_ps(in + 12);
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+	}
+
+	// x, y, z, w (SoA) -> 4 Float4s (AoS)
+	inline void storeTransposed4(float* out, __m128 x, __m128 y, __m128 z, __m128 w) noexcept
+	{
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+		_mm_storeu_ps(out + 0, x);
+		_mm_storeu_ps(out + 4, y);
+		_mm_storeu_ps(out + 8, z);
+		_mm_storeu_ps(out + 12, w);
+	}
+
+	// Transposes the 4x4 block in each 128-bit lane.
+	FS_TARGET_AVX2 inline void transposeLanes(__m256& a, __m256& b, __m256& c, __m256& d) noexcept
+	{
+		const __m256 t0{ _mm256_unpacklo_ps(a, b) };
+		const __m256 t1{ _mm256_unpacklo_ps(c, d) };
+		const __m256 t2{ _mm256_unpackhi_ps(a, b) };
+		const __m256 t3{ _mm256_unpackhi_ps(c, d) };
+		a = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+		b = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+		c = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+		d = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+	}
+
+	// 8 Float4s (AoS) -> x, y, z, w (SoA). Lane 0 holds v0..v3 and lane 1 holds v4..v7.
+	FS_TARGET_AVX2 inline void loadTransposed8(const float* in, __m256& x, __m256& y, __m256& z, __m256& w) noexcept
+	{
+		// (v0 v1), (v2 v3), (v4 v5), (v6 v7) -> (v0 v4), (v1 v5), (v2 v6), (v3 v7)
+		const __m256 p0{ _mm256_loadu_ps(in + 0) };
+		const __m256 p1{ _mm256_loadu_ps(in + 8) };
+		const __m256 p2{ _mm256_loadu_ps(in + 16) };
+		const __m256 p3{ _mm256_loadu_ps(in + 24) };
+		x = _mm256_permute2f128_ps(p0, p2, 0x20);
+		y = _mm256_permute2f128_ps(p0, p2, 0x31);
+		z = _mm256_permute2f128_ps(p1, p3, 0x20);
+		w = _mm256_permute2f128_ps(p1, p3, 0x31);
+		transposeLanes(x, y, z, w);
+	}
+
+	// x, y, z, w (SoA) -> 8 Float4s (AoS), the inverse of loadTransposed8()
+	FS_TARGET_AVX2 inline void storeTransposed8(float* out, __m256 x, __m256 y, __m256 z, __m256 w) noexcept
+	{
+		transposeLanes(x, y, z, w);
+		_mm256_storeu_ps(out + 0, _mm256_permute2f128_ps(x, y, 0x20));
+		_mm256_storeu_ps(out + 8, _mm256_permute2f128_ps(z, w, 0x20));
+		_mm256_storeu_ps(out + 16, _mm256_permute2f128_ps(x, y, 0x31));
+		_mm256_storeu_ps(out + 24, _mm256_permute2f128_ps(z, w, 0x31));
+	}
+
+	// Picks Avx2Kernel or Sse2Kernel only once per pair.
+	template <auto Sse2Kernel, auto Avx2Kernel>
+	inline auto getBatchKernel() noexcept
+	{
+		static_assert(std::is_same_v<decltype(Sse2Kernel), decltype(Avx2Kernel)>, "Both kernels must have the same signature.");
+		static const auto kKernel{ (getSimdLevel() >= ESimdLevel::AVX2) ? Avx2Kernel : Sse2Kernel };
+		return kKernel;
+	}
+}
+
+
+// === HEADER ENDS ===
+#endif // !FS_BATCH_KERNELS_H
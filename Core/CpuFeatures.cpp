@@ -0,0 +1,79 @@
+﻿#include "CpuFeatures.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+
+namespace fs
+{
+	static void cpuid(uint32 leaf, uint32 subLeaf, uint32 (&registers)[4]) noexcept
+	{
+#if defined(_MSC_VER)
+		int result[4]{};
+		__cpuidex(result, static_cast<int>(leaf), static_cast<int>(subLeaf));
+		for (uint32 i = 0; i < 4; ++i)
+		{
+			registers[i] = static_cast<uint32>(result[i]);
+		}
+#else
+		__cpuid_count(leaf, subLeaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+	}
+
+	// XCR0: OS가 저장/복원해 주는 레지스터 상태
+	static uint64 xgetbv() noexcept
+	{
+#if defined(_MSC_VER)
+		return _xgetbv(0);
+#else
+		uint32 low{}, high{};
+		__asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+		return (static_cast<uint64>(high) << 32) | low;
+#endif
+	}
+
+	static ESimdLevel detectSimdLevel() noexcept
+	{
+		// EAX, EBX, ECX, EDX
+		uint32 registers[4]{};
+		cpuid(0, 0, registers);
+		const uint32 maxLeaf{ registers[0] };
+
+		cpuid(1, 0, registers);
+		const bool hasSse41{ (registers[2] & (1u << 19)) != 0 };
+		const bool hasFma{ (registers[2] & (1u << 12)) != 0 };
+		const bool hasOsxsave{ (registers[2] & (1u << 27)) != 0 };
+		const bool hasAvx{ (registers[2] & (1u << 28)) != 0 };
+		if (hasSse41 == false) return ESimdLevel::SSE2;
+		if (hasOsxsave == false || hasAvx == false || maxLeaf < 7) return ESimdLevel::SSE41;
+
+		// XMM, YMM 상태
+		const uint64 xcr0{ xgetbv() };
+		if ((xcr0 & 0x6) != 0x6) return ESimdLevel::SSE41;
+
+		cpuid(7, 0, registers);
+		const bool hasAvx2{ (registers[1] & (1u << 5)) != 0 };
+		const bool hasAvx512f{ (registers[1] & (1u << 16)) != 0 };
+		if (hasAvx2 == false || hasFma == false) return ESimdLevel::SSE41;
+
+		// opmask, ZMM 상태
+		if (hasAvx512f == true && (xcr0 & 0xE6) == 0xE6) return ESimdLevel::AVX512;
+		return ESimdLevel::AVX2;
+	}
+
+	static ESimdLevel sMaxSimdLevel{ ESimdLevel::AVX512 };
+
+	ESimdLevel getSimdLevel() noexcept
+	{
+		static const ESimdLevel kSimdLevel{ detectSimdLevel() };
+		return (kSimdLevel < sMaxSimdLevel) ? kSimdLevel : sMaxSimdLevel;
+	}
+
+	void limitSimdLevel(ESimdLevel maxSimdLevel) noexcept
+	{
+		sMaxSimdLevel = maxSimdLevel;
+	}
+}
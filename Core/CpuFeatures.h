@@ -0,0 +1,65 @@
+﻿#pragma once
+
+
+#ifndef FS_CPU_FEATURES_H
+#define FS_CPU_FEATURES_H
+// === HEADER BEGINS ===
+
+
+#include <Core/_CommonTypes.h>
+
+
+// GCC/Clang은 함수 단위로 명령어 집합을 켜야 intrinsic을 쓸 수 있다. (MSVC는 필요 없음)
+#if defined(_MSC_VER)
+#define FS_TARGET_SSE41
+#define FS_TARGET_AVX2
+#define FS_TARGET_AVX512
+#else
+#define FS_TARGET_SSE41		__attribute__((target("sse4.1")))
+#define FS_TARGET_AVX2		__attribute__((target("avx2,fma")))
+#define FS_TARGET_AVX512	__attribute__((target("avx512f,avx2,fma")))
+#endif
+
+// 컴파일할 때부터 켜져 있는 명령어 집합 (/arch:AVX2, -mavx2 -mfma 등).
+// 호출 비용이 중요한 헤더의 inline 함수는 runtime dispatch 대신 이것으로 고른다.
+// GCC/Clang은 -mavx2만으로는 __FMA__를 정의하지 않고 FMA intrinsic도 쓸 수 없다. MSVC는 /arch:AVX2에 FMA가 포함되지만 __FMA__가 없다.
+#if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define FS_SIMD_FMA		1
+#else
+#define FS_SIMD_FMA		0
+#endif
+
+#if defined(__SSE4_1__) || defined(__AVX__)
+#define FS_SIMD_SSE41	1
+#else
+#define FS_SIMD_SSE41	0
+#endif
+
+
+namespace fs
+{
+	// 순서대로 상위 집합이다.
+	enum class ESimdLevel : uint32
+	{
+		SSE2,
+		SSE41,
+
+		// AVX2 + FMA
+		AVX2,
+
+		// AVX-512F
+		AVX512,
+	};
+
+	// 실행 중인 CPU(와 OS)가 지원하는 가장 높은 SIMD 수준. 처음 호출될 때 한 번만 검사한다.
+	// limitSimdLevel()로 제한했으면 그 수준을 넘지 않는다.
+	ESimdLevel getSimdLevel() noexcept;
+
+	// 테스트와 벤치마크에서 낮은 수준의 커널을 고르게 한다.
+	// 커널은 처음 쓸 때 한 번만 고르므로, 다른 스레드를 만들기 전, 어떤 커널도 쓰기 전에 호출해야 한다.
+	void limitSimdLevel(ESimdLevel maxSimdLevel) noexcept;
+}
+
+
+// === HEADER ENDS ===
+#endif // !FS_CPU_FEATURES_H
@@ -0,0 +1,168 @@
+﻿#include "DirtyRegionTracker.h"
+
+#include <utility>
+
+
+namespace fs
+{
+	DirtyRegionTracker::DirtyRegionTracker(uint32 tileSize)
+		: _tileSize{ (tileSize == 0) ? kDefaultTileSize : tileSize }
+	{
+		__noop;
+	}
+
+	DirtyRegionTracker::~DirtyRegionTracker()
+	{
+		__noop;
+	}
+
+	void DirtyRegionTracker::beginFrame(uint32 width, uint32 height, uint64 backgroundHash)
+	{
+		if (width != _width || height != _height)
+		{
+			_width = width;
+			_height = height;
+			_tileCountX = (width + _tileSize - 1) / _tileSize;
+			_tileCountY = (height + _tileSize - 1) / _tileSize;
+			_vPrevTileHashes.assign(static_cast<size_t>(_tileCountX) * _tileCountY, 0);
+			_bInvalidated = true;
+		}
+		if (backgroundHash != _backgroundHash)
+		{
+			_backgroundHash = backgroundHash;
+			_bInvalidated = true;
+		}
+		_vTileHashes.assign(static_cast<size_t>(_tileCountX) * _tileCountY, 0);
+	}
+
+	void DirtyRegionTracker::addDraw(const PixelRect& bounds, uint64 hash) noexcept
+	{
+		const int32 left{ (bounds.left < 0) ? 0 : bounds.left };
+		const int32 top{ (bounds.top < 0) ? 0 : bounds.top };
+		const int32 right{ (bounds.right > static_cast<int32>(_width)) ? static_cast<int32>(_width) : bounds.right };
+		const int32 bottom{ (bounds.bottom > static_cast<int32>(_height)) ? static_cast<int32>(_height) : bounds.bottom };
+		if (left >= right || top >= bottom) return;
+
+		const int32 tileSize{ static_cast<int32>(_tileSize) };
+		const int32 tileLeft{ left / tileSize };
+		const int32 tileTop{ top / tileSize };
+		const int32 tileRight{ (right - 1) / tileSize };
+		const int32 tileBottom{ (bottom - 1) / tileSize };
+		for (int32 tileY = tileTop; tileY <= tileBottom; ++tileY)
+		{
+			uint64* const tileHashes{ &_vTileHashes[static_cast<size_t>(tileY) * _tileCountX] };
+			for (int32 tileX = tileLeft; tileX <= tileRight; ++tileX)
+			{
+				tileHashes[tileX] = combineHash(tileHashes[tileX], hash);
+			}
+		}
+	}
+
+	void DirtyRegionTracker::endFrame()
+	{
+		_vDirtyRects.clear();
+		_dirtyPixelCount = 0;
+		_vOpenRects.clear();
+
+		for (uint32 tileY = 0; tileY < _tileCountY; ++tileY)
+		{
+			// 이 행에서 dirty 타일이 가로로 이어진 구간들 (왼쪽부터)
+			_vRowRuns.clear();
+			const size_t rowOffset{ static_cast<size_t>(tileY) * _tileCountX };
+			for (uint32 tileX = 0; tileX < _tileCountX; ++tileX)
+			{
+				const bool bDirty{ _bInvalidated == true || _vTileHashes[rowOffset + tileX] != _vPrevTileHashes[rowOffset + tileX] };
+				if (bDirty == false) continue;
+
+				if (_vRowRuns.empty() == false && _vRowRuns.back().right == static_cast<int32>(tileX))
+				{
+					++_vRowRuns.back().right;
+				}
+				else
+				{
+					_vRowRuns.push_back(PixelRect{ static_cast<int32>(tileX), static_cast<int32>(tileY), static_cast<int32>(tileX) + 1, static_cast<int32>(tileY) + 1 });
+				}
+			}
+
+			// 윗 행에서 폭이 같은 직사각형이 있으면 아래로 늘리고, 이어지지 않는 직사각형은 닫는다.
+			// 둘 다 왼쪽부터 정렬되어 있고 서로 겹치지 않는다.
+			size_t openIndex{};
+			for (auto& run : _vRowRuns)
+			{
+				while (openIndex < _vOpenRects.size() && _vOpenRects[openIndex].left < run.left)
+				{
+					const PixelRect& open{ _vOpenRects[openIndex++] };
+					addRect(open.left, open.top, open.right, open.bottom);
+				}
+				if (openIndex < _vOpenRects.size() && _vOpenRects[openIndex].left == run.left && _vOpenRects[openIndex].right == run.right)
+				{
+					run.top = _vOpenRects[openIndex++].top;
+				}
+			}
+			for (; openIndex < _vOpenRects.size(); ++openIndex)
+			{
+				const PixelRect& open{ _vOpenRects[openIndex] };
+				addRect(open.left, open.top, open.right, open.bottom);
+			}
+			_vOpenRects.swap(_vRowRuns);
+		}
+		for (const auto& open : _vOpenRects)
+		{
+			addRect(open.left, open.top, open.right, open.bottom);
+		}
+
+		if (_vDirtyRects.size() > kMaxRectCount)
+		{
+			PixelRect bounds{ _vDirtyRects.front() };
+			for (const auto& rect : _vDirtyRects)
+			{
+				bounds.left = (rect.left < bounds.left) ? rect.left : bounds.left;
+				bounds.top = (rect.top < bounds.top) ? rect.top : bounds.top;
+				bounds.right = (rect.right > bounds.right) ? rect.right : bounds.right;
+				bounds.bottom = (rect.bottom > bounds.bottom) ? rect.bottom : bounds.bottom;
+			}
+			_vDirtyRects.clear();
+			_vDirtyRects.emplace_back(bounds);
+			_dirtyPixelCount = static_cast<uint64>(bounds.right - bounds.left) * static_cast<uint64>(bounds.bottom - bounds.top);
+		}
+
+		_vTileHashes.swap(_vPrevTileHashes);
+		_bInvalidated = false;
+	}
+
+	void DirtyRegionTracker::invalidate() noexcept
+	{
+		_bInvalidated = true;
+	}
+
+	const std::vector<PixelRect>& DirtyRegionTracker::getDirtyRects() const noexcept
+	{
+		return _vDirtyRects;
+	}
+
+	uint64 DirtyRegionTracker::getDirtyPixelCount() const noexcept
+	{
+		return _dirtyPixelCount;
+	}
+
+	uint32 DirtyRegionTracker::getTileSize() const noexcept
+	{
+		return _tileSize;
+	}
+
+	uint64 DirtyRegionTracker::combineHash(uint64 seed, uint64 hash) noexcept
+	{
+		return seed ^ (hash + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2));
+	}
+
+	void DirtyRegionTracker::addRect(int32 tileLeft, int32 tileTop, int32 tileRight, int32 tileBottom)
+	{
+		// 타일 단위 -> 픽셀 단위. 오른쪽/아래 끝의 타일은 화면 밖으로 나가지 않게 자른다.
+		const int32 tileSize{ static_cast<int32>(_tileSize) };
+		PixelRect rect{ tileLeft * tileSize, tileTop * tileSize, tileRight * tileSize, tileBottom * tileSize };
+		rect.right = (rect.right > static_cast<int32>(_width)) ? static_cast<int32>(_width) : rect.right;
+		rect.bottom = (rect.bottom > static_cast<int32>(_height)) ? static_cast<int32>(_height) : rect.bottom;
+		_vDirtyRects.emplace_back(rect);
+		_dirtyPixelCount += static_cast<uint64>(rect.right - rect.left) * static_cast<uint64>(rect.bottom - rect.top);
+	}
+}
@@ -0,0 +1,92 @@
+﻿#pragma once
+
+
+#ifndef FS_DIRTY_REGION_TRACKER_H
+#define FS_DIRTY_REGION_TRACKER_H
+// === HEADER BEGINS ===
+
+
+#include <Core/_CommonTypes.h>
+
+
+namespace fs
+{
+	// [left, right) x [top, bottom) 픽셀 영역
+	struct PixelRect
+	{
+		int32	left{};
+		int32	top{};
+		int32	right{};
+		int32	bottom{};
+	};
+
+
+	// 프레임마다 그린 명령들을 비교해서, 이전 프레임과 달라진 영역만 찾는다.
+	// 화면을 타일로 나누고, 타일마다 그 타일에 닿는 명령들의 hash를 그리는 순서대로 섞는다.
+	// 이전 프레임과 hash가 다른 타일만 dirty이므로, 명령이 추가/삭제/변경되거나 순서가 바뀐 곳만 다시 그리면 된다.
+	// dirty 타일들은 가로로 이어진 것끼리, 다시 세로로 같은 폭인 것끼리 합쳐서 겹치지 않는 직사각형 목록으로 만든다.
+	// Windows에 의존하지 않는다.
+	class DirtyRegionTracker final
+	{
+	public:
+		static constexpr uint32 kDefaultTileSize{ 32 };
+
+		// 직사각형이 이보다 많으면 모두를 감싸는 하나로 합친다. (출력 호출 수 제한)
+		static constexpr uint32 kMaxRectCount{ 16 };
+
+	public:
+		explicit DirtyRegionTracker(uint32 tileSize = kDefaultTileSize);
+		~DirtyRegionTracker();
+
+	public:
+		// 크기나 backgroundHash(배경색 등)가 이전 프레임과 다르면 전체가 dirty이다.
+		void beginFrame(uint32 width, uint32 height, uint64 backgroundHash);
+
+		// 그리는 순서대로 호출한다. 영역은 화면 밖으로 나가도 된다.
+		void addDraw(const PixelRect& bounds, uint64 hash) noexcept;
+
+		// dirty 영역을 계산한다. 이후 getDirtyRects()로 얻는다.
+		void endFrame();
+
+		// 다음 프레임은 전체가 dirty이다.
+		void invalidate() noexcept;
+
+	public:
+		// 서로 겹치지 않는다.
+		const std::vector<PixelRect>& getDirtyRects() const noexcept;
+		uint64 getDirtyPixelCount() const noexcept;
+		uint32 getTileSize() const noexcept;
+
+	public:
+		// 두 hash를 순서에 의존하도록 섞는다.
+		static uint64 combineHash(uint64 seed, uint64 hash) noexcept;
+
+	private:
+		void addRect(int32 tileLeft, int32 tileTop, int32 tileRight, int32 tileBottom);
+
+	private:
+		uint32					_tileSize{};
+		uint32					_width{};
+		uint32					_height{};
+		uint32					_tileCountX{};
+		uint32					_tileCountY{};
+		uint64					_backgroundHash{};
+		bool					_bInvalidated{ true };
+
+	private:
+		// 이번 프레임과 이전 프레임의 타일별 hash
+		std::vector<uint64>		_vTileHashes{};
+		std::vector<uint64>		_vPrevTileHashes{};
+
+		// endFrame()에서 아직 아래로 이어질 수 있는 직사각형들 (타일 단위)
+		std::vector<PixelRect>	_vOpenRects{};
+		std::vector<PixelRect>	_vRowRuns{};
+
+		std::vector<PixelRect>	_vDirtyRects{};
+		uint64					_dirtyPixelCount{};
+	};
+}
+
+
+// === HEADER ENDS ===
+#endif // !FS_DIRTY_REGION_TRACKER_H
@@ -0,0 +1,473 @@
+﻿#include "DrawCommandList.h"
+#include <Core/Framebuffer.h>
+#include <Core/TextLayout.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+
+namespace fs
+{
+	// sortKey 중 종류와 상태 부분
+	static constexpr uint64 kStateMask{ 0x0000'FFFF'FFFF'FF00ull };
+
+
+	DrawCommandList::DrawCommandList()
+	{
+		__noop;
+	}
+
+	DrawCommandList::~DrawCommandList()
+	{
+		__noop;
+	}
+
+	void DrawCommandList::setLayer(uint16 layer) noexcept
+	{
+		_layer = layer;
+	}
+
+	uint16 DrawCommandList::getLayer() const noexcept
+	{
+		return _layer;
+	}
+
+	void DrawCommandList::setSortByState(bool bSortByState) noexcept
+	{
+		_bSortByState = bSortByState;
+	}
+
+	void DrawCommandList::add(DrawCommand command, const wchar_t* text)
+	{
+		command.sortKey = makeSortKey(_layer, command);
+		if (command.eType == EDrawCommandType::Text)
+		{
+			command.textOffset = static_cast<uint32>(_vTextArena.size());
+			_vTextArena.insert(_vTextArena.end(), text, text + command.textLength);
+		}
+		_vCommands.emplace_back(command);
+	}
+
+	void DrawCommandList::add(DrawCommand command, std::span<const Float2> points)
+	{
+		assert(command.eType == EDrawCommandType::Polyline);
+		command.sortKey = makeSortKey(_layer, command);
+		command.textOffset = static_cast<uint32>(_vPointArena.size());
+		command.textLength = static_cast<uint32>(points.size());
+		_vPointArena.insert(_vPointArena.end(), points.begin(), points.end());
+		_vCommands.emplace_back(command);
+	}
+
+	void DrawCommandList::clear() noexcept
+	{
+		_vCommands.clear();
+		_vTextArena.clear();
+		_vPointArena.clear();
+	}
+
+	void DrawCommandList::replay(IDrawCommandExecutor& executor)
+	{
+		sort();
+
+		_stateRunCount = 0;
+		uint64 prevState{ ~0ull };
+		for (const auto& sortEntry : _vSortEntries)
+		{
+			const DrawCommand& command{ _vCommands[sortEntry.index] };
+			const uint64 state{ command.sortKey & kStateMask };
+			if (state != prevState)
+			{
+				executor.beginStateRun(command);
+				prevState = state;
+				++_stateRunCount;
+			}
+			if (command.eType == EDrawCommandType::Polyline)
+			{
+				executor.executePolyline(command, getPoints(command));
+			}
+			else
+			{
+				executor.execute(command, getText(command));
+			}
+		}
+		executor.endReplay();
+	}
+
+	uint32 DrawCommandList::getCommandCount() const noexcept
+	{
+		return static_cast<uint32>(_vCommands.size());
+	}
+
+	const DrawCommand& DrawCommandList::getCommand(uint32 index) const noexcept
+	{
+		assert(index < static_cast<uint32>(_vCommands.size()));
+		return _vCommands[index];
+	}
+
+	const wchar_t* DrawCommandList::getText(const DrawCommand& command) const noexcept
+	{
+		if (command.eType != EDrawCommandType::Text || command.textLength == 0)
+		{
+			return nullptr;
+		}
+		return &_vTextArena[command.textOffset];
+	}
+
+	std::span<const Float2> DrawCommandList::getPoints(const DrawCommand& command) const noexcept
+	{
+		if (command.eType != EDrawCommandType::Polyline || command.textLength == 0)
+		{
+			return {};
+		}
+		return std::span<const Float2>(&_vPointArena[command.textOffset], command.textLength);
+	}
+
+	uint32 DrawCommandList::getSortedIndex(uint32 order) const noexcept
+	{
+		assert(order < static_cast<uint32>(_vSortEntries.size()));
+		return _vSortEntries[order].index;
+	}
+
+	uint32 DrawCommandList::getStateRunCount() const noexcept
+	{
+		return _stateRunCount;
+	}
+
+	DrawCommand DrawCommandList::makeRectangle(int32 x, int32 y, int32 width, int32 height, uint32 color, uint8 alpha) noexcept
+	{
+		DrawCommand command{};
+		command.eType = EDrawCommandType::Rectangle;
+		command.alpha = alpha;
+		command.color = color;
+		command.x0 = x;
+		command.y0 = y;
+		command.x1 = x + width;
+		command.y1 = y + height;
+		return command;
+	}
+
+	DrawCommand DrawCommandList::makeImage(EDrawCommandType eType, uint32 imageIndex, int32 x, int32 y, int32 width, int32 height, uint8 alpha) noexcept
+	{
+		DrawCommand command{};
+		command.eType = eType;
+		command.alpha = alpha;
+		command.resource = imageIndex;
+		command.x0 = x;
+		command.y0 = y;
+		command.x1 = x + width;
+		command.y1 = y + height;
+		return command;
+	}
+
+	DrawCommand DrawCommandList::makeText(uint32 fontIndex, int32 x0, int32 y0, int32 x1, int32 y1, uint32 color, uint32 format, uint32 textLength) noexcept
+	{
+		DrawCommand command{};
+		command.eType = EDrawCommandType::Text;
+		command.color = color;
+		command.resource = fontIndex;
+		command.param = format;
+		command.x0 = x0;
+		command.y0 = y0;
+		command.x1 = x1;
+		command.y1 = y1;
+		command.textLength = textLength;
+		return command;
+	}
+
+	DrawCommand DrawCommandList::makeLine(int32 xA, int32 yA, int32 xB, int32 yB, uint32 color) noexcept
+	{
+		DrawCommand command{};
+		command.eType = EDrawCommandType::Line;
+		command.color = color;
+		command.x0 = xA;
+		command.y0 = yA;
+		command.x1 = xB;
+		command.y1 = yB;
+		return command;
+	}
+
+	DrawCommand DrawCommandList::makeLineAntialiased(float xA, float yA, float xB, float yB, uint32 color) noexcept
+	{
+		constexpr float kScale{ static_cast<float>(1 << kLineSubpixelShift) };
+		DrawCommand command{ makeLine(static_cast<int32>(lroundf(xA * kScale)), static_cast<int32>(lroundf(yA * kScale)),
+			static_cast<int32>(lroundf(xB * kScale)), static_cast<int32>(lroundf(yB * kScale)), color) };
+		command.param = kLineAntialiased;
+		return command;
+	}
+
+	DrawCommand DrawCommandList::makePolyline(std::span<const Float2> points, float width, ELineJoin eJoin, ELineCap eCap, uint32 color, uint8 alpha) noexcept
+	{
+		DrawCommand command{};
+		command.eType = EDrawCommandType::Polyline;
+		command.alpha = alpha;
+		command.color = color;
+		const uint32 widthFixed{ static_cast<uint32>(lroundf(width * 256.0f)) };
+		command.param = ((widthFixed & 0xFFFFFF) << 8) | (static_cast<uint32>(eCap) << 4) | static_cast<uint32>(eJoin);
+		PolylineRasterizer::computeBounds(points, static_cast<float>(widthFixed) / 256.0f, eJoin, eCap, command.x0, command.y0, command.x1, command.y1);
+		command.textLength = static_cast<uint32>(points.size());
+
+		// 32비트 FNV-1a
+		uint32 hash{ 0x811C9DC5u };
+		for (const auto& point : points)
+		{
+			uint32 bits[2]{};
+			memcpy(bits, &point, sizeof(bits));
+			hash = (hash ^ bits[0]) * 0x01000193u;
+			hash = (hash ^ bits[1]) * 0x01000193u;
+		}
+		command.resource = hash;
+		return command;
+	}
+
+	DrawCommand DrawCommandList::makeTextLayout(uint32 layoutIndex, uint32 fontIndex, int32 left, int32 top, int32 right, int32 bottom, uint32 color) noexcept
+	{
+		DrawCommand command{};
+		command.eType = EDrawCommandType::TextLayout;
+		command.color = color;
+		command.resource = layoutIndex;
+		command.param = fontIndex;
+		command.x0 = left;
+		command.y0 = top;
+		command.x1 = right;
+		command.y1 = bottom;
+		return command;
+	}
+
+	void DrawCommandList::computeBounds(const DrawCommand& command, int32& left, int32& top, int32& right, int32& bottom) noexcept
+	{
+		if (command.eType == EDrawCommandType::Line && (command.param & kLineAntialiased) != 0)
+		{
+			// 선이 지나는 픽셀의 양 옆(위아래)까지 칠해진다.
+			left = ((command.x0 < command.x1) ? command.x0 : command.x1) >> kLineSubpixelShift;
+			top = ((command.y0 < command.y1) ? command.y0 : command.y1) >> kLineSubpixelShift;
+			right = ((command.x0 < command.x1) ? command.x1 : command.x0) >> kLineSubpixelShift;
+			bottom = ((command.y0 < command.y1) ? command.y1 : command.y0) >> kLineSubpixelShift;
+			left -= 1;
+			top -= 1;
+			right += 2;
+			bottom += 2;
+			return;
+		}
+		if (command.eType == EDrawCommandType::Line)
+		{
+			left = (command.x0 < command.x1) ? command.x0 : command.x1;
+			top = (command.y0 < command.y1) ? command.y0 : command.y1;
+			right = ((command.x0 < command.x1) ? command.x1 : command.x0) + 1;
+			bottom = ((command.y0 < command.y1) ? command.y1 : command.y0) + 1;
+			return;
+		}
+		left = command.x0;
+		top = command.y0;
+		right = command.x1;
+		bottom = command.y1;
+	}
+
+	uint64 DrawCommandList::computeHash(const DrawCommand& command, const wchar_t* text) noexcept
+	{
+		uint64 hash{ 0xCBF29CE484222325ull };
+		const auto mix
+		{
+			[&hash](uint32 value)
+			{
+				for (uint32 shift = 0; shift < 32; shift += 8)
+				{
+					hash = (hash ^ ((value >> shift) & 0xFF)) * 0x100000001B3ull;
+				}
+			}
+		};
+		mix(static_cast<uint32>(command.eType) | (static_cast<uint32>(command.alpha) << 8));
+		mix(command.color);
+		mix(command.resource);
+		mix(command.param);
+		mix(static_cast<uint32>(command.x0));
+		mix(static_cast<uint32>(command.y0));
+		mix(static_cast<uint32>(command.x1));
+		mix(static_cast<uint32>(command.y1));
+		mix(command.textLength);
+		if (command.eType == EDrawCommandType::Text && text != nullptr)
+		{
+			for (uint32 i = 0; i < command.textLength; ++i)
+			{
+				mix(static_cast<uint32>(text[i]));
+			}
+		}
+		return hash;
+	}
+
+	uint64 DrawCommandList::makeSortKey(uint16 layer, const DrawCommand& command) noexcept
+	{
+		uint32 state{};
+		switch (command.eType)
+		{
+		case EDrawCommandType::Rectangle:
+		case EDrawCommandType::Line:
+		case EDrawCommandType::Polyline:
+			// brush, pen
+			state = command.color & 0xFFFFFF;
+			break;
+		case EDrawCommandType::Text:
+			// 폰트, 글자색
+			state = ((command.resource & 0xFF) << 24) | (command.color & 0xFFFFFF);
+			break;
+		case EDrawCommandType::TextLayout:
+			// 폰트(resource는 layout index), 글자색
+			state = ((command.param & 0xFF) << 24) | (command.color & 0xFFFFFF);
+			break;
+		default:
+			// 이미지
+			state = command.resource;
+			break;
+		}
+		return (static_cast<uint64>(layer) << 48) | (static_cast<uint64>(command.eType) << 40) | (static_cast<uint64>(state) << 8);
+	}
+
+	void DrawCommandList::sort()
+	{
+		_vSortEntries.resize(_vCommands.size());
+		for (uint32 i = 0; i < static_cast<uint32>(_vCommands.size()); ++i)
+		{
+			_vSortEntries[i].key = (_bSortByState == true) ? _vCommands[i].sortKey : 0;
+			_vSortEntries[i].index = i;
+		}
+
+		if (_bSortByState == true)
+		{
+			// index를 함께 비교하므로 같은 상태 안에서는 기록한 순서가 유지된다.
+			std::sort(_vSortEntries.begin(), _vSortEntries.end(),
+				[](const SortEntry& a, const SortEntry& b)
+				{
+					return (a.key != b.key) ? (a.key < b.key) : (a.index < b.index);
+				});
+		}
+	}
+
+
+	FramebufferCommandExecutor::FramebufferCommandExecutor(Framebuffer& target) : _target{ target }
+	{
+		__noop;
+	}
+
+	FramebufferCommandExecutor::~FramebufferCommandExecutor()
+	{
+		__noop;
+	}
+
+	void FramebufferCommandExecutor::execute(const DrawCommand& command, const wchar_t* text)
+	{
+		if (command.eType == EDrawCommandType::Text)
+		{
+			int32 left{};
+			int32 top{};
+			int32 right{};
+			int32 bottom{};
+			prepareText(command, text, left, top, right, bottom);
+		}
+		executeOn(_target, command, {}, text);
+	}
+
+	void FramebufferCommandExecutor::executePolyline(const DrawCommand& command, std::span<const Float2> points)
+	{
+		executeOn(_target, command, points);
+	}
+
+	void FramebufferCommandExecutor::executeOn(Framebuffer& target, const DrawCommand& command, std::span<const Float2> points, const wchar_t* text) const
+	{
+		switch (command.eType)
+		{
+		case EDrawCommandType::Rectangle:
+			target.fillRectangle(command.x0, command.y0, command.x1 - command.x0, command.y1 - command.y0, command.color, command.alpha);
+			break;
+		case EDrawCommandType::Image:
+			if (const Framebuffer* const image{ getImage(command.resource) })
+			{
+				target.drawImage(*image, command.x0, command.y0);
+			}
+			break;
+		case EDrawCommandType::ImageColorKey:
+			if (const Framebuffer* const image{ getImage(command.resource) })
+			{
+				target.drawImageColorKey(*image, command.x0, command.y0, 0);
+			}
+			break;
+		case EDrawCommandType::ImageAlpha:
+			if (const Framebuffer* const image{ getImage(command.resource) })
+			{
+				target.drawImageAlpha(*image, command.x0, command.y0, command.alpha);
+			}
+			break;
+		case EDrawCommandType::ImagePremultipliedAlpha:
+			if (const Framebuffer* const image{ getImage(command.resource) })
+			{
+				target.drawImagePremultipliedAlpha(*image, command.x0, command.y0);
+			}
+			break;
+		case EDrawCommandType::Line:
+			if ((command.param & DrawCommandList::kLineAntialiased) != 0)
+			{
+				constexpr float kInvScale{ 1.0f / static_cast<float>(1 << DrawCommandList::kLineSubpixelShift) };
+				target.drawLineAntialiased(command.x0 * kInvScale, command.y0 * kInvScale, command.x1 * kInvScale, command.y1 * kInvScale, command.color);
+			}
+			else
+			{
+				target.drawLine(command.x0, command.y0, command.x1, command.y1, command.color);
+			}
+			break;
+		case EDrawCommandType::Polyline:
+		{
+			// 누적 버퍼는 스레드마다 하나씩 재사용한다.
+			thread_local PolylineRasterizer polylineRasterizer{};
+			polylineRasterizer.drawPolyline(target, points, static_cast<float>(command.param >> 8) / 256.0f,
+				static_cast<ELineJoin>(command.param & 0xF), static_cast<ELineCap>((command.param >> 4) & 0xF), command.color, command.alpha);
+			break;
+		}
+		case EDrawCommandType::Text:
+			drawText(target, command, text);
+			break;
+		case EDrawCommandType::TextLayout:
+		{
+			const TextLayout* const textLayout{ getTextLayout(command.resource) };
+			const GlyphAtlas* const glyphAtlas{ getGlyphAtlas(command.param) };
+			if (textLayout != nullptr && glyphAtlas != nullptr)
+			{
+				textLayout->draw(target, *glyphAtlas, command.color);
+			}
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	const Framebuffer* FramebufferCommandExecutor::getImage(uint32 imageIndex) const
+	{
+		(void)imageIndex;
+		return nullptr;
+	}
+
+	const TextLayout* FramebufferCommandExecutor::getTextLayout(uint32 layoutIndex) const
+	{
+		(void)layoutIndex;
+		return nullptr;
+	}
+
+	const GlyphAtlas* FramebufferCommandExecutor::getGlyphAtlas(uint32 fontIndex) const
+	{
+		(void)fontIndex;
+		return nullptr;
+	}
+
+	void FramebufferCommandExecutor::prepareText(const DrawCommand& command, const wchar_t* text, int32& left, int32& top, int32& right, int32& bottom)
+	{
+		(void)text;
+		DrawCommandList::computeBounds(command, left, top, right, bottom);
+	}
+
+	void FramebufferCommandExecutor::drawText(Framebuffer& target, const DrawCommand& command, const wchar_t* text) const
+	{
+		(void)target;
+		(void)command;
+		(void)text;
+	}
+}
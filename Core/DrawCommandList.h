@@ -0,0 +1,220 @@
+﻿#pragma once
+
+
+#ifndef FS_DRAW_COMMAND_LIST_H
+#define FS_DRAW_COMMAND_LIST_H
+// === HEADER BEGINS ===
+
+
+#include <Core/_CommonTypes.h>
+#include <Core/PolylineRasterizer.h>
+
+
+namespace fs
+{
+	class Framebuffer;
+	class GlyphAtlas;
+	class TextLayout;
+
+
+	enum class EDrawCommandType : uint8
+	{
+		Rectangle,
+		Image,
+		ImageColorKey,
+		ImageAlpha,
+		ImagePremultipliedAlpha,
+		Text,
+		Line,
+		Polyline,
+		TextLayout,
+	};
+
+
+	// 그리기 명령 하나. 복사만으로 옮길 수 있는 POD이다.
+	// 좌표는 모두 픽셀 단위이고, Line은 (x0, y0) -> (x1, y1), 나머지는 [x0, x1) x [y0, y1) 영역이다. (Polyline은 칠할 수 있는 영역)
+	struct DrawCommand
+	{
+		// DrawCommandList::add()가 채운다.
+		uint64				sortKey{};
+
+		EDrawCommandType	eType{};
+		uint8				alpha{ 255 };
+
+		// 32비트 BGRA
+		uint32				color{};
+
+		// Image...: 이미지 index, Text: 폰트 index (kUint32Max이면 현재 선택된 폰트)
+		// Polyline: 정점들의 hash (computeHash()가 정점을 보지 않아도 된다.)
+		// TextLayout: text layout index
+		uint32				resource{};
+
+		// Text: 백엔드가 해석하는 정렬 플래그 (GDI에서는 DT_...)
+		// Line: DrawCommandList::kLineAntialiased이면 좌표가 24.8 고정소수점이다.
+		// Polyline: [31..8] 24.8 고정소수점 두께, [7..4] ELineCap, [3..0] ELineJoin
+		// TextLayout: 폰트(glyph atlas) index
+		uint32				param{};
+
+		int32				x0{};
+		int32				y0{};
+		int32				x1{};
+		int32				y1{};
+
+		// Text: DrawCommandList의 텍스트 arena 안에서의 위치. (textOffset은 DrawCommandList::add()가 채운다.)
+		// Polyline: 정점 arena 안에서의 위치와 정점 수
+		uint32				textOffset{};
+		uint32				textLength{};
+	};
+
+
+	// DrawCommandList::replay()가 정렬된 명령들을 넘겨주는 대상.
+	class IDrawCommandExecutor
+	{
+	public:
+		virtual ~IDrawCommandExecutor() {}
+
+	public:
+		// 종류와 상태(색, 폰트, 이미지)가 이전 명령과 다를 때마다 execute()보다 먼저 호출된다.
+		virtual void beginStateRun(const DrawCommand& command) { (void)command; }
+
+		// text는 Text 명령일 때만 유효하며 null 종료되지 않는다. (길이는 command.textLength)
+		virtual void execute(const DrawCommand& command, const wchar_t* text) = 0;
+
+		// Polyline 명령은 execute() 대신 이 함수로 정점과 함께 넘어온다.
+		virtual void executePolyline(const DrawCommand& command, std::span<const Float2> points) { (void)command; (void)points; }
+
+		// 모든 명령을 실행한 뒤 호출된다.
+		virtual void endReplay() {}
+	};
+
+
+	// 한 프레임의 그리기 명령을 모아 두었다가, (layer, 종류, 상태) 순으로 정렬해 한 번에 실행한다.
+	// 같은 layer 안에서는 상태가 다른 명령끼리 순서가 바뀔 수 있다. 순서가 중요하면 layer를 나누세요.
+	// clear() 후에도 메모리는 그대로 유지되므로, 정상 상태에서는 프레임마다 할당이 일어나지 않는다.
+	class DrawCommandList final
+	{
+	public:
+		// Line의 param
+		static constexpr uint32 kLineAntialiased{ 1 };
+		static constexpr int32 kLineSubpixelShift{ 8 };
+
+	public:
+		DrawCommandList();
+		~DrawCommandList();
+
+	public:
+		// layer가 작은 명령이 먼저 그려진다.
+		void setLayer(uint16 layer) noexcept;
+		uint16 getLayer() const noexcept;
+
+		// false이면 정렬하지 않고 기록한 순서대로 실행한다.
+		void setSortByState(bool bSortByState) noexcept;
+
+	public:
+		void add(DrawCommand command, const wchar_t* text = nullptr);
+		// Polyline 명령. points는 복사된다.
+		void add(DrawCommand command, std::span<const Float2> points);
+		void clear() noexcept;
+
+		void replay(IDrawCommandExecutor& executor);
+
+		// replay()를 거치지 않고 직접 실행하려는 쪽(TileRasterizer 등)을 위해 실행 순서만 정한다.
+		// 이후 getSortedIndex()로 순서를 얻는다.
+		void sort();
+
+	public:
+		uint32 getCommandCount() const noexcept;
+		const DrawCommand& getCommand(uint32 index) const noexcept;
+		const wchar_t* getText(const DrawCommand& command) const noexcept;
+		// Polyline이 아니면 비어 있다.
+		std::span<const Float2> getPoints(const DrawCommand& command) const noexcept;
+
+		// sort() 후 order번째로 실행될 명령의 index
+		uint32 getSortedIndex(uint32 order) const noexcept;
+
+		// 마지막 replay()에서 beginStateRun()이 호출된 횟수
+		uint32 getStateRunCount() const noexcept;
+
+	public:
+		static DrawCommand makeRectangle(int32 x, int32 y, int32 width, int32 height, uint32 color, uint8 alpha) noexcept;
+		static DrawCommand makeImage(EDrawCommandType eType, uint32 imageIndex, int32 x, int32 y, int32 width, int32 height, uint8 alpha = 255) noexcept;
+		static DrawCommand makeText(uint32 fontIndex, int32 x0, int32 y0, int32 x1, int32 y1, uint32 color, uint32 format, uint32 textLength) noexcept;
+		static DrawCommand makeLine(int32 xA, int32 yA, int32 xB, int32 yB, uint32 color) noexcept;
+		// 좌표는 1/256 픽셀 단위로 저장된다. anti-aliasing을 지원하지 않는 백엔드는 가장 가까운 픽셀로 그린다.
+		static DrawCommand makeLineAntialiased(float xA, float yA, float xB, float yB, uint32 color) noexcept;
+		// 영역과 정점 hash를 계산하므로 정점 수만큼 시간이 걸린다.
+		static DrawCommand makePolyline(std::span<const Float2> points, float width, ELineJoin eJoin, ELineCap eCap, uint32 color, uint8 alpha) noexcept;
+		// [left, right) x [top, bottom)는 미리 배치해 둔 글자들의 영역 (TextLayout::getBounds())
+		static DrawCommand makeTextLayout(uint32 layoutIndex, uint32 fontIndex, int32 left, int32 top, int32 right, int32 bottom, uint32 color) noexcept;
+
+		// 명령이 그리는 [left, right) x [top, bottom) 영역. Line은 두 끝점을 모두 포함한다. (anti-aliasing이면 주변 1픽셀까지)
+		// Text는 글자 크기를 알 수 없으므로 명령의 영역을 그대로 돌려준다.
+		static void computeBounds(const DrawCommand& command, int32& left, int32& top, int32& right, int32& bottom) noexcept;
+
+		// 그려지는 결과를 결정하는 모든 값(Text는 글자 포함)의 64비트 FNV-1a hash. sortKey와 textOffset은 제외한다.
+		static uint64 computeHash(const DrawCommand& command, const wchar_t* text) noexcept;
+
+	private:
+		// [63..48] layer, [47..40] EDrawCommandType, [39..8] 상태
+		static uint64 makeSortKey(uint16 layer, const DrawCommand& command) noexcept;
+
+	private:
+		struct SortEntry
+		{
+			uint64	key{};
+			uint32	index{};
+		};
+
+	private:
+		uint16						_layer{};
+		bool						_bSortByState{ true };
+
+	private:
+		std::vector<DrawCommand>	_vCommands{};
+		std::vector<wchar_t>		_vTextArena{};
+		std::vector<Float2>			_vPointArena{};
+		std::vector<SortEntry>		_vSortEntries{};
+		uint32						_stateRunCount{};
+	};
+
+
+	// 명령을 Framebuffer에 그린다. Windows에 의존하지 않으므로 테스트에서 그대로 쓸 수 있다.
+	class FramebufferCommandExecutor : public IDrawCommandExecutor
+	{
+	public:
+		explicit FramebufferCommandExecutor(Framebuffer& target);
+		virtual ~FramebufferCommandExecutor();
+
+	public:
+		virtual void execute(const DrawCommand& command, const wchar_t* text) override;
+		virtual void executePolyline(const DrawCommand& command, std::span<const Float2> points) override;
+
+		// 명령을 target에 그린다. 멤버를 바꾸지 않으므로 여러 스레드에서 동시에 불러도 된다.
+		// points는 Polyline 명령의 정점 (DrawCommandList::getPoints()), text는 Text 명령의 글자 (DrawCommandList::getText())
+		// @주의: Text 명령은 호출한 스레드에서 prepareText()를 먼저 호출해야 한다.
+		void executeOn(Framebuffer& target, const DrawCommand& command, std::span<const Float2> points = {}, const wchar_t* text = nullptr) const;
+
+		// Text 명령을 그릴 준비를 하고 (글자 rasterize 등) 칠할 수 있는 [left, right) x [top, bottom) 영역을 구한다.
+		// 기본 구현은 명령의 영역을 그대로 돌려준다.
+		virtual void prepareText(const DrawCommand& command, const wchar_t* text, int32& left, int32& top, int32& right, int32& bottom);
+
+	protected:
+		// imageIndex에 해당하는 이미지. 없으면 nullptr
+		virtual const Framebuffer* getImage(uint32 imageIndex) const;
+
+		// TextLayout 명령이 쓰는 배치와 glyph atlas. 없으면 nullptr
+		virtual const TextLayout* getTextLayout(uint32 layoutIndex) const;
+		virtual const GlyphAtlas* getGlyphAtlas(uint32 fontIndex) const;
+
+		// prepareText()가 끝난 Text 명령을 target에 그린다. executeOn()처럼 여러 스레드에서 동시에 불릴 수 있다.
+		// Framebuffer는 텍스트를 그리지 못하므로 기본 구현은 아무것도 하지 않는다.
+		virtual void drawText(Framebuffer& target, const DrawCommand& command, const wchar_t* text) const;
+
+	protected:
+		Framebuffer&				_target;
+	};
+}
+
+
+// === HEADER ENDS ===
+#endif // !FS_DRAW_COMMAND_LIST_H
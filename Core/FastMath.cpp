@@ -0,0 +1,228 @@
+﻿#include "FastMath.h"
+#include <Core/CpuFeatures.h>
+
+#include <cassert>
+
+
+namespace fs
+{
+	namespace fastmath
+	{
+		// 4 lanes: the inline kernels of FastMath.h
+		static void sinCosSse2(const float* angles, float* sines, float* cosines, size_t count) noexcept
+		{
+			size_t i{};
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 cosine;
+				const __m128 sine{ sinCos4(_mm_loadu_ps(angles + i), cosine) };
+				_mm_storeu_ps(sines + i, sine);
+				_mm_storeu_ps(cosines + i, cosine);
+			}
+			for (; i < count; ++i)
+			{
+				Fast::sinCos(angles[i], sines[i], cosines[i]);
+			}
+		}
+
+		static void tanSse2(const float* angles, float* out, size_t count) noexcept
+		{
+			size_t i{};
+			for (; i + 4 <= count; i += 4)
+			{
+				_mm_storeu_ps(out + i, tan4(_mm_loadu_ps(angles + i)));
+			}
+			for (; i < count; ++i)
+			{
+				out[i] = Fast::tan(angles[i]);
+			}
+		}
+
+		static void rsqrtSse2(const float* values, float* out, size_t count) noexcept
+		{
+			size_t i{};
+			for (; i + 4 <= count; i += 4)
+			{
+				_mm_storeu_ps(out + i, rsqrt4(_mm_loadu_ps(values + i)));
+			}
+			for (; i < count; ++i)
+			{
+				out[i] = Fast::rsqrt(values[i]);
+			}
+		}
+
+		static void sqrtSse2(const float* values, float* out, size_t count) noexcept
+		{
+			size_t i{};
+			for (; i + 4 <= count; i += 4)
+			{
+				_mm_storeu_ps(out + i, sqrt4(_mm_loadu_ps(values + i)));
+			}
+			for (; i < count; ++i)
+			{
+				out[i] = Fast::sqrt(values[i]);
+			}
+		}
+
+
+		// 8 lanes: the same polynomials with FMA
+		FS_TARGET_AVX2 static inline __m256i reduce8(__m256& x) noexcept
+		{
+			__m256i j{ _mm256_cvttps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(kFourOverPi))) };
+			j = _mm256_and_si256(_mm256_add_epi32(j, _mm256_set1_epi32(1)), _mm256_set1_epi32(~1));
+			const __m256 y{ _mm256_cvtepi32_ps(j) };
+			x = _mm256_fnmadd_ps(y, _mm256_set1_ps(kPiOver4A), x);
+			x = _mm256_fnmadd_ps(y, _mm256_set1_ps(kPiOver4B), x);
+			x = _mm256_fnmadd_ps(y, _mm256_set1_ps(kPiOver4C), x);
+			return j;
+		}
+
+		FS_TARGET_AVX2 static inline __m256 sinCos8(__m256 x, __m256& cosine) noexcept
+		{
+			const __m256 signMask{ _mm256_set1_ps(-0.0f) };
+			__m256 sinSign{ _mm256_and_ps(x, signMask) };
+			x = _mm256_andnot_ps(signMask, x);
+
+			const __m256i j{ reduce8(x) };
+
+			sinSign = _mm256_xor_ps(sinSign, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(j, _mm256_set1_epi32(4)), 29)));
+			const __m256 cosSign{ _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_andnot_si256(_mm256_sub_epi32(j, _mm256_set1_epi32(2)), _mm256_set1_epi32(4)), 29)) };
+			const __m256 swapMask{ _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(j, _mm256_set1_epi32(2)), _mm256_set1_epi32(2))) };
+
+			const __m256 z{ _mm256_mul_ps(x, x) };
+
+			__m256 cosPoly{ _mm256_set1_ps(2.443315711809948E-5f) };
+			cosPoly = _mm256_fmadd_ps(cosPoly, z, _mm256_set1_ps(-1.388731625493765E-3f));
+			cosPoly = _mm256_fmadd_ps(cosPoly, z, _mm256_set1_ps(4.166664568298827E-2f));
+			cosPoly = _mm256_mul_ps(_mm256_mul_ps(cosPoly, z), z);
+			cosPoly = _mm256_add_ps(_mm256_fnmadd_ps(z, _mm256_set1_ps(0.5f), cosPoly), _mm256_set1_ps(1.0f));
+
+			__m256 sinPoly{ _mm256_set1_ps(-1.9515295891E-4f) };
+			sinPoly = _mm256_fmadd_ps(sinPoly, z, _mm256_set1_ps(8.3321608736E-3f));
+			sinPoly = _mm256_fmadd_ps(sinPoly, z, _mm256_set1_ps(-1.6666654611E-1f));
+			sinPoly = _mm256_fmadd_ps(_mm256_mul_ps(sinPoly, z), x, x);
+
+			cosine = _mm256_xor_ps(_mm256_blendv_ps(cosPoly, sinPoly, swapMask), cosSign);
+			return _mm256_xor_ps(_mm256_blendv_ps(sinPoly, cosPoly, swapMask), sinSign);
+		}
+
+		FS_TARGET_AVX2 static inline __m256 tan8(__m256 x) noexcept
+		{
+			const __m256 signMask{ _mm256_set1_ps(-0.0f) };
+			const __m256 sign{ _mm256_and_ps(x, signMask) };
+			x = _mm256_andnot_ps(signMask, x);
+
+			const __m256i j{ reduce8(x) };
+			const __m256 z{ _mm256_mul_ps(x, x) };
+
+			__m256 poly{ _mm256_set1_ps(9.38540185543E-3f) };
+			poly = _mm256_fmadd_ps(poly, z, _mm256_set1_ps(3.11992232697E-3f));
+			poly = _mm256_fmadd_ps(poly, z, _mm256_set1_ps(2.44301354525E-2f));
+			poly = _mm256_fmadd_ps(poly, z, _mm256_set1_ps(5.34112807005E-2f));
+			poly = _mm256_fmadd_ps(poly, z, _mm256_set1_ps(1.33387994085E-1f));
+			poly = _mm256_fmadd_ps(poly, z, _mm256_set1_ps(3.33331568548E-1f));
+			poly = _mm256_fmadd_ps(_mm256_mul_ps(poly, z), x, x);
+
+			const __m256 cotMask{ _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(j, _mm256_set1_epi32(2)), _mm256_set1_epi32(2))) };
+			poly = _mm256_blendv_ps(poly, _mm256_div_ps(_mm256_set1_ps(-1.0f), poly), cotMask);
+			return _mm256_xor_ps(poly, sign);
+		}
+
+		FS_TARGET_AVX2 static inline __m256 rsqrt8(const __m256& x) noexcept
+		{
+			const __m256 y{ _mm256_rsqrt_ps(x) };
+			const __m256 xyy{ _mm256_mul_ps(_mm256_mul_ps(x, y), y) };
+			return _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), y), _mm256_sub_ps(_mm256_set1_ps(3.0f), xyy));
+		}
+
+		FS_TARGET_AVX2 static void sinCosAvx2(const float* angles, float* sines, float* cosines, size_t count) noexcept
+		{
+			size_t i{};
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256 cosine;
+				const __m256 sine{ sinCos8(_mm256_loadu_ps(angles + i), cosine) };
+				_mm256_storeu_ps(sines + i, sine);
+				_mm256_storeu_ps(cosines + i, cosine);
+			}
+			sinCosSse2(angles + i, sines + i, cosines + i, count - i);
+		}
+
+		FS_TARGET_AVX2 static void tanAvx2(const float* angles, float* out, size_t count) noexcept
+		{
+			size_t i{};
+			for (; i + 8 <= count; i += 8)
+			{
+				_mm256_storeu_ps(out + i, tan8(_mm256_loadu_ps(angles + i)));
+			}
+			tanSse2(angles + i, out + i, count - i);
+		}
+
+		FS_TARGET_AVX2 static void rsqrtAvx2(const float* values, float* out, size_t count) noexcept
+		{
+			size_t i{};
+			for (; i + 8 <= count; i += 8)
+			{
+				_mm256_storeu_ps(out + i, rsqrt8(_mm256_loadu_ps(values + i)));
+			}
+			rsqrtSse2(values + i, out + i, count - i);
+		}
+
+		FS_TARGET_AVX2 static void sqrtAvx2(const float* values, float* out, size_t count) noexcept
+		{
+			size_t i{};
+			for (; i + 8 <= count; i += 8)
+			{
+				const __m256 x{ _mm256_loadu_ps(values + i) };
+				const __m256 positive{ _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_GT_OQ) };
+				_mm256_storeu_ps(out + i, _mm256_and_ps(positive, _mm256_mul_ps(x, rsqrt8(x))));
+			}
+			sqrtSse2(values + i, out + i, count - i);
+		}
+
+
+		struct FastMathKernels
+		{
+			void (*sinCos)(const float* angles, float* sines, float* cosines, size_t count) noexcept;
+			void (*tan)(const float* angles, float* out, size_t count) noexcept;
+			void (*rsqrt)(const float* values, float* out, size_t count) noexcept;
+			void (*sqrt)(const float* values, float* out, size_t count) noexcept;
+		};
+
+		// Picks the kernels only once.
+		static const FastMathKernels& getFastMathKernels() noexcept
+		{
+			static const FastMathKernels kFastMathKernels
+			{
+				(getSimdLevel() >= ESimdLevel::AVX2) ?
+					FastMathKernels{ sinCosAvx2, tanAvx2, rsqrtAvx2, sqrtAvx2 } :
+					FastMathKernels{ sinCosSse2, tanSse2, rsqrtSse2, sqrtSse2 }
+			};
+			return kFastMathKernels;
+		}
+
+		void sinCos(std::span<const float> angles, std::span<float> sines, std::span<float> cosines) noexcept
+		{
+			assert(angles.size() == sines.size() && angles.size() == cosines.size());
+			getFastMathKernels().sinCos(angles.data(), sines.data(), cosines.data(), angles.size());
+		}
+
+		void tan(std::span<const float> angles, std::span<float> out) noexcept
+		{
+			assert(angles.size() == out.size());
+			getFastMathKernels().tan(angles.data(), out.data(), angles.size());
+		}
+
+		void rsqrt(std::span<const float> values, std::span<float> out) noexcept
+		{
+			assert(values.size() == out.size());
+			getFastMathKernels().rsqrt(values.data(), out.data(), values.size());
+		}
+
+		void sqrt(std::span<const float> values, std::span<float> out) noexcept
+		{
+			assert(values.size() == out.size());
+			getFastMathKernels().sqrt(values.data(), out.data(), values.size());
+		}
+	}
+}
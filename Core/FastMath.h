@@ -0,0 +1,267 @@
+﻿#pragma once
+
+
+#ifndef FS_FAST_MATH_H
+#define FS_FAST_MATH_H
+// === HEADER BEGINS ===
+
+
+#include <Core/_CommonTypes.h>
+#include <immintrin.h>
+#include <cmath>
+#include <span>
+#include <type_traits>
+
+
+namespace fs
+{
+	// Polynomial approximations of sin, cos, tan and 1/sqrt, 4 lanes (SSE2) inline or 8 lanes (AVX2 + FMA) through the span kernels.
+	// sin/cos/tan use the Cephes reduction to [-pi/4, pi/4] with pi/4 split in three parts. NaN and infinity are not handled.
+	//
+	// Max error against double precision:
+	//   sin, cos  2 ulp for |x| <= pi. Up to |x| == 8192 the absolute error stays below 1e-7,
+	//             but near the zeros of large arguments that is many ulp.
+	//   tan       3 ulp for |x| <= pi, away from the poles (|cos x| > 0.01)
+	//   rsqrt     4 ulp for x in [1e-30, 1e30] (hardware estimate + one Newton-Raphson step)
+	//   sqrt      4 ulp, same range (x * rsqrt(x), 0 for x == 0)
+	namespace fastmath
+	{
+		// 4 / pi
+		static constexpr float	kFourOverPi{ 1.27323954473516f };
+		// pi / 4 == kPiOver4A + kPiOver4B + kPiOver4C (kPiOver4A and kPiOver4B are exact in a few bits, so y * them is exact)
+		static constexpr float	kPiOver4A{ 0.78515625f };
+		static constexpr float	kPiOver4B{ 2.4187564849853515625e-4f };
+		static constexpr float	kPiOver4C{ 3.77489497744594108e-8f };
+
+
+		// x -> (octant j rounded up to even, x - j * pi / 4), for x >= 0
+		inline __m128i reduce4(__m128& x) noexcept
+		{
+			__m128i j{ _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(kFourOverPi))) };
+			j = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+			const __m128 y{ _mm_cvtepi32_ps(j) };
+			x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(kPiOver4A)));
+			x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(kPiOver4B)));
+			x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(kPiOver4C)));
+			return j;
+		}
+
+		inline __m128 select4(const __m128& mask, const __m128& a, const __m128& b) noexcept
+		{
+			return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+		}
+
+		// returns sin(x), cosine = cos(x)
+		inline __m128 sinCos4(__m128 x, __m128& cosine) noexcept
+		{
+			const __m128 signMask{ _mm_set1_ps(-0.0f) };
+			__m128 sinSign{ _mm_and_ps(x, signMask) };
+			x = _mm_andnot_ps(signMask, x);
+
+			const __m128i j{ reduce4(x) };
+
+			// octants 4..7 negate sin, octants 2..5 negate cos
+			sinSign = _mm_xor_ps(sinSign, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, _mm_set1_epi32(4)), 29)));
+			const __m128 cosSign{ _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(j, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29)) };
+			// octants 2, 3, 6, 7 swap sin and cos
+			const __m128 swapMask{ _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, _mm_set1_epi32(2)), _mm_set1_epi32(2))) };
+
+			const __m128 z{ _mm_mul_ps(x, x) };
+
+			// cos(x) == 1 - z / 2 + z^2 (c0 z^2 + c1 z + c2)
+			__m128 cosPoly{ _mm_set1_ps(2.443315711809948E-5f) };
+			cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, z), _mm_set1_ps(-1.388731625493765E-3f));
+			cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, z), _mm_set1_ps(4.166664568298827E-2f));
+			cosPoly = _mm_mul_ps(_mm_mul_ps(cosPoly, z), z);
+			cosPoly = _mm_add_ps(_mm_sub_ps(cosPoly, _mm_mul_ps(z, _mm_set1_ps(0.5f))), _mm_set1_ps(1.0f));
+
+			// sin(x) == x + x z (s0 z^2 + s1 z + s2)
+			__m128 sinPoly{ _mm_set1_ps(-1.9515295891E-4f) };
+			sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, z), _mm_set1_ps(8.3321608736E-3f));
+			sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, z), _mm_set1_ps(-1.6666654611E-1f));
+			sinPoly = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sinPoly, z), x), x);
+
+			cosine = _mm_xor_ps(select4(swapMask, sinPoly, cosPoly), cosSign);
+			return _mm_xor_ps(select4(swapMask, cosPoly, sinPoly), sinSign);
+		}
+
+		inline __m128 tan4(__m128 x) noexcept
+		{
+			const __m128 signMask{ _mm_set1_ps(-0.0f) };
+			const __m128 sign{ _mm_and_ps(x, signMask) };
+			x = _mm_andnot_ps(signMask, x);
+
+			const __m128i j{ reduce4(x) };
+			const __m128 z{ _mm_mul_ps(x, x) };
+
+			// tan(x) == x + x z P(z)
+			__m128 poly{ _mm_set1_ps(9.38540185543E-3f) };
+			poly = _mm_add_ps(_mm_mul_ps(poly, z), _mm_set1_ps(3.11992232697E-3f));
+			poly = _mm_add_ps(_mm_mul_ps(poly, z), _mm_set1_ps(2.44301354525E-2f));
+			poly = _mm_add_ps(_mm_mul_ps(poly, z), _mm_set1_ps(5.34112807005E-2f));
+			poly = _mm_add_ps(_mm_mul_ps(poly, z), _mm_set1_ps(1.33387994085E-1f));
+			poly = _mm_add_ps(_mm_mul_ps(poly, z), _mm_set1_ps(3.33331568548E-1f));
+			poly = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(poly, z), x), x);
+
+			// octants 2, 3, 6, 7: tan(x + pi / 2) == -1 / tan(x)
+			const __m128 cotMask{ _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, _mm_set1_epi32(2)), _mm_set1_epi32(2))) };
+			poly = select4(cotMask, _mm_div_ps(_mm_set1_ps(-1.0f), poly), poly);
+			return _mm_xor_ps(poly, sign);
+		}
+
+		// x > 0
+		inline __m128 rsqrt4(const __m128& x) noexcept
+		{
+			// y' = y (1.5 - 0.5 x y^2) doubles the 12 correct bits of rsqrtps
+			const __m128 y{ _mm_rsqrt_ps(x) };
+			const __m128 xyy{ _mm_mul_ps(_mm_mul_ps(x, y), y) };
+			return _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), y), _mm_sub_ps(_mm_set1_ps(3.0f), xyy));
+		}
+
+		// x >= 0
+		inline __m128 sqrt4(const __m128& x) noexcept
+		{
+			const __m128 positive{ _mm_cmpgt_ps(x, _mm_setzero_ps()) };
+			return _mm_and_ps(positive, _mm_mul_ps(x, rsqrt4(x)));
+		}
+
+
+		// The same polynomials in scalar code, for constant evaluation (neither libm nor the intrinsics are constexpr).
+		constexpr void sinCosScalar(float x, float& sine, float& cosine) noexcept
+		{
+			const bool bNegative{ x < 0.0f };
+			if (bNegative == true)
+			{
+				x = -x;
+			}
+
+			int32 j{ static_cast<int32>(x * kFourOverPi) };
+			j = (j + 1) & ~1;
+			const float y{ static_cast<float>(j) };
+			x = ((x - y * kPiOver4A) - y * kPiOver4B) - y * kPiOver4C;
+
+			const float z{ x * x };
+			const float cosPoly{ ((2.443315711809948E-5f * z - 1.388731625493765E-3f) * z + 4.166664568298827E-2f) * z * z - z * 0.5f + 1.0f };
+			const float sinPoly{ ((-1.9515295891E-4f * z + 8.3321608736E-3f) * z - 1.6666654611E-1f) * z * x + x };
+
+			const bool bSwap{ (j & 2) != 0 };
+			sine = (bSwap == true) ? cosPoly : sinPoly;
+			cosine = (bSwap == true) ? sinPoly : cosPoly;
+			if (((j & 4) != 0) != bNegative)
+			{
+				sine = -sine;
+			}
+			if (((j - 2) & 4) == 0)
+			{
+				cosine = -cosine;
+			}
+		}
+
+		constexpr float tanScalar(float x) noexcept
+		{
+			const bool bNegative{ x < 0.0f };
+			if (bNegative == true)
+			{
+				x = -x;
+			}
+
+			int32 j{ static_cast<int32>(x * kFourOverPi) };
+			j = (j + 1) & ~1;
+			const float y{ static_cast<float>(j) };
+			x = ((x - y * kPiOver4A) - y * kPiOver4B) - y * kPiOver4C;
+
+			const float z{ x * x };
+			float result{ (((((9.38540185543E-3f * z + 3.11992232697E-3f) * z + 2.44301354525E-2f) * z
+				+ 5.34112807005E-2f) * z + 1.33387994085E-1f) * z + 3.33331568548E-1f) * z * x + x };
+			if ((j & 2) != 0)
+			{
+				result = -1.0f / result;
+			}
+			return (bNegative == true) ? -result : result;
+		}
+
+
+		// 8 lanes (AVX2 + FMA, chosen at runtime) with 4-lane and scalar tails. The output may be the input.
+		// All spans must have the same size.
+		void					sinCos(std::span<const float> angles, std::span<float> sines, std::span<float> cosines) noexcept;
+		void					tan(std::span<const float> angles, std::span<float> out) noexcept;
+		void					rsqrt(std::span<const float> values, std::span<float> out) noexcept;
+		void					sqrt(std::span<const float> values, std::span<float> out) noexcept;
+
+
+		// Precision policies for the matrix and quaternion builders, e.g. Float4x4::rotationMatrixX<fastmath::Fast>(angle).
+		// sinCos() and tan() are constexpr in both; in constant evaluation they use the scalar polynomials.
+		// libm (the default)
+		struct Precise
+		{
+			static constexpr void sinCos(float angle, float& sine, float& cosine) noexcept
+			{
+				if (std::is_constant_evaluated() == true)
+				{
+					sinCosScalar(angle, sine, cosine);
+					return;
+				}
+				sine = sinf(angle);
+				cosine = cosf(angle);
+			}
+
+			static constexpr float tan(float angle) noexcept
+			{
+				if (std::is_constant_evaluated() == true)
+				{
+					return tanScalar(angle);
+				}
+				return tanf(angle);
+			}
+
+			static float sqrt(float x) noexcept
+			{
+				return sqrtf(x);
+			}
+
+			static float rsqrt(float x) noexcept
+			{
+				return 1.0f / sqrtf(x);
+			}
+		};
+
+		// the kernels above in lane 0
+		struct Fast
+		{
+			static constexpr void sinCos(float angle, float& sine, float& cosine) noexcept
+			{
+				if (std::is_constant_evaluated() == true)
+				{
+					sinCosScalar(angle, sine, cosine);
+					return;
+				}
+				__m128 cosine4;
+				sine = _mm_cvtss_f32(sinCos4(_mm_set_ss(angle), cosine4));
+				cosine = _mm_cvtss_f32(cosine4);
+			}
+
+			static constexpr float tan(float angle) noexcept
+			{
+				if (std::is_constant_evaluated() == true)
+				{
+					return tanScalar(angle);
+				}
+				return _mm_cvtss_f32(tan4(_mm_set_ss(angle)));
+			}
+
+			static float sqrt(float x) noexcept
+			{
+				return _mm_cvtss_f32(sqrt4(_mm_set_ss(x)));
+			}
+
+			static float rsqrt(float x) noexcept
+			{
+				return _mm_cvtss_f32(rsqrt4(_mm_set_ss(x)));
+			}
+		};
+	}
+}
+
+
+// === HEADER ENDS ===
+#endif // !FS_FAST_MATH_H
@@ -0,0 +1,117 @@
+﻿#pragma once
+
+
+#ifndef FS_FIXED_WSTRING_H
+#define FS_FIXED_WSTRING_H
+// === HEADER BEGINS ===
+
+
+#include <Core/_CommonTypes.h>
+
+#include <charconv>
+#include <string_view>
+
+
+namespace fs
+{
+	// 크기가 고정된 wide 문자열 버퍼. 숫자는 std::to_chars로 쓰므로 힙 할당이 전혀 없다.
+	// FPS처럼 매 프레임 바뀌는 숫자를 그릴 때 std::to_wstring()과 문자열 연결 대신 쓴다.
+	// 자리가 모자라면 아무것도 쓰지 않고 false를 리턴한다. (글자가 중간에 잘리지 않는다.)
+	template <uint32 Capacity>
+	class FixedWstring final
+	{
+	public:
+		// 한 번에 쓸 수 있는 숫자의 최대 길이 (부호, 소수점 포함)
+		static constexpr uint32 kNumberBufferSize{ 64 };
+
+	public:
+		FixedWstring()
+		{
+			__noop;
+		}
+		FixedWstring(std::wstring_view text)
+		{
+			append(text);
+		}
+
+	public:
+		void clear() noexcept
+		{
+			_length = 0;
+		}
+
+		bool append(std::wstring_view text) noexcept
+		{
+			if (text.size() > static_cast<size_t>(Capacity - _length)) return false;
+
+			for (const wchar_t character : text)
+			{
+				_buffer[_length++] = character;
+			}
+			return true;
+		}
+
+		// 정수 (int32, uint32, int64, uint64 등)
+		template <typename Integer>
+		bool appendInteger(Integer value) noexcept
+		{
+			char digits[kNumberBufferSize];
+			const std::to_chars_result result{ std::to_chars(digits, digits + kNumberBufferSize, value) };
+			return appendDigits(digits, result);
+		}
+
+		// 소수점 아래 precision자리까지 쓴다.
+		template <typename Float>
+		bool appendFloat(Float value, int32 precision) noexcept
+		{
+			char digits[kNumberBufferSize];
+			const std::to_chars_result result{ std::to_chars(digits, digits + kNumberBufferSize, value, std::chars_format::fixed, precision) };
+			return appendDigits(digits, result);
+		}
+
+	public:
+		std::wstring_view view() const noexcept
+		{
+			return std::wstring_view(_buffer, _length);
+		}
+
+		const wchar_t* data() const noexcept
+		{
+			return _buffer;
+		}
+
+		uint32 size() const noexcept
+		{
+			return _length;
+		}
+
+		bool empty() const noexcept
+		{
+			return (_length == 0);
+		}
+
+	private:
+		bool appendDigits(const char* digits, const std::to_chars_result& result) noexcept
+		{
+			if (result.ec != std::errc{}) return false;
+
+			const uint32 count{ static_cast<uint32>(result.ptr - digits) };
+			if (count > Capacity - _length) return false;
+
+			// to_chars는 ASCII만 쓰므로 그대로 넓힌다.
+			for (uint32 i = 0; i < count; ++i)
+			{
+				_buffer[_length++] = static_cast<wchar_t>(digits[i]);
+			}
+			return true;
+		}
+
+	private:
+		wchar_t		_buffer[Capacity]{};
+		uint32		_length{};
+	};
+}
+
+
+// === HEADER ENDS ===
+#endif // !FS_FIXED_WSTRING_H
@@ -0,0 +1,183 @@
+﻿#include "pch.h"
+#include "Float4.h"
+#include <Core/BatchKernels.h>
+
+#include <cassert>
+
+
+namespace fs
+{
+	// The batch kernels read and write Float4 arrays as raw floats.
+	static_assert(sizeof(Float4) == sizeof(float) * 4, "Float4 must be tightly packed.");
+	static_assert(sizeof(Quaternion) == sizeof(float) * 4, "Quaternion must be tightly packed.");
+
+	static void rotateBatchScalar(const Quaternion& q, const Float4* in, Float4* out, size_t count) noexcept
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			out[i] = q.rotate(in[i]);
+		}
+	}
+
+	// q == (b, c, d, a), the layout of Quaternion::_data
+	// 4 vectors at a time: AoS -> SoA, rotate, SoA -> AoS
+	static void rotateBatchSse2(const float* q, const float* in, float* out, size_t count) noexcept
+	{
+		const __m128 qx{ _mm_set1_ps(q[0]) };
+		const __m128 qy{ _mm_set1_ps(q[1]) };
+		const __m128 qz{ _mm_set1_ps(q[2]) };
+		const __m128 qw{ _mm_set1_ps(q[3]) };
+		const __m128 two{ _mm_set1_ps(2.0f) };
+
+		size_t i{};
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 x, y, z, w;
+			loadTransposed4(in + i * 4, x, y, z, w);
+
+			// t = 2 (u x v)
+			const __m128 tx{ _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qy, z), _mm_mul_ps(qz, y))) };
+			const __m128 ty{ _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qz, x), _mm_mul_ps(qx, z))) };
+			const __m128 tz{ _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qx, y), _mm_mul_ps(qy, x))) };
+
+			// v + qw t + u x t
+			x = _mm_add_ps(_mm_add_ps(x, _mm_mul_ps(qw, tx)), _mm_sub_ps(_mm_mul_ps(qy, tz), _mm_mul_ps(qz, ty)));
+			y = _mm_add_ps(_mm_add_ps(y, _mm_mul_ps(qw, ty)), _mm_sub_ps(_mm_mul_ps(qz, tx), _mm_mul_ps(qx, tz)));
+			z = _mm_add_ps(_mm_add_ps(z, _mm_mul_ps(qw, tz)), _mm_sub_ps(_mm_mul_ps(qx, ty), _mm_mul_ps(qy, tx)));
+
+			storeTransposed4(out + i * 4, x, y, z, w);
+		}
+
+		const Quaternion quaternion(q[3], q[0], q[1], q[2]);
+		rotateBatchScalar(quaternion, reinterpret_cast<const Float4*>(in + i * 4), reinterpret_cast<Float4*>(out + i * 4), count - i);
+	}
+
+	// 8 vectors at a time with FMA
+	FS_TARGET_AVX2 static void rotateBatchAvx2(const float* q, const float* in, float* out, size_t count) noexcept
+	{
+		const __m256 qx{ _mm256_set1_ps(q[0]) };
+		const __m256 qy{ _mm256_set1_ps(q[1]) };
+		const __m256 qz{ _mm256_set1_ps(q[2]) };
+		const __m256 qw{ _mm256_set1_ps(q[3]) };
+		const __m256 two{ _mm256_set1_ps(2.0f) };
+
+		size_t i{};
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 x, y, z, w;
+			loadTransposed8(in + i * 4, x, y, z, w);
+
+			const __m256 tx{ _mm256_mul_ps(two, _mm256_fmsub_ps(qy, z, _mm256_mul_ps(qz, y))) };
+			const __m256 ty{ _mm256_mul_ps(two, _mm256_fmsub_ps(qz, x, _mm256_mul_ps(qx, z))) };
+			const __m256 tz{ _mm256_mul_ps(two, _mm256_fmsub_ps(qx, y, _mm256_mul_ps(qy, x))) };
+
+			x = _mm256_add_ps(_mm256_fmadd_ps(qw, tx, x), _mm256_fmsub_ps(qy, tz, _mm256_mul_ps(qz, ty)));
+			y = _mm256_add_ps(_mm256_fmadd_ps(qw, ty, y), _mm256_fmsub_ps(qz, tx, _mm256_mul_ps(qx, tz)));
+			z = _mm256_add_ps(_mm256_fmadd_ps(qw, tz, z), _mm256_fmsub_ps(qx, ty, _mm256_mul_ps(qy, tx)));
+
+			storeTransposed8(out + i * 4, x, y, z, w);
+		}
+		rotateBatchSse2(q, in + i * 4, out + i * 4, count - i);
+	}
+
+	void Quaternion::rotate(std::span<const Float4> in, std::span<Float4> out) const noexcept
+	{
+		assert(in.size() == out.size());
+
+		const float q[4]{ _data.getX(), _data.getY(), _data.getZ(), _data.getW() };
+		getBatchKernel<rotateBatchSse2, rotateBatchAvx2>()(q, reinterpret_cast<const float*>(in.data()), reinterpret_cast<float*>(out.data()), in.size());
+	}
+
+
+	static void nlerpBatchScalar(const Quaternion* a, const Quaternion* b, float t, Quaternion* out, size_t count) noexcept
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			out[i] = Quaternion::nlerp(a[i], b[i], t);
+		}
+	}
+
+	// 4 quaternions at a time: AoS -> SoA, lerp along the shorter arc, normalize, SoA -> AoS
+	static void nlerpBatchSse2(const float* a, const float* b, float t, float* out, size_t count) noexcept
+	{
+		const __m128 tt{ _mm_set1_ps(t) };
+		const __m128 signMask{ _mm_set1_ps(-0.0f) };
+
+		size_t i{};
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 ax, ay, az, aw;
+			loadTransposed4(a + i * 4, ax, ay, az, aw);
+			__m128 bx, by, bz, bw;
+			loadTransposed4(b + i * 4, bx, by, bz, bw);
+
+			// copies the sign of dot(a, b) onto b
+			const __m128 dot{ _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz)), _mm_mul_ps(aw, bw)) };
+			const __m128 sign{ _mm_and_ps(dot, signMask) };
+			bx = _mm_xor_ps(bx, sign);
+			by = _mm_xor_ps(by, sign);
+			bz = _mm_xor_ps(bz, sign);
+			bw = _mm_xor_ps(bw, sign);
+
+			__m128 x{ _mm_add_ps(_mm_mul_ps(_mm_sub_ps(bx, ax), tt), ax) };
+			__m128 y{ _mm_add_ps(_mm_mul_ps(_mm_sub_ps(by, ay), tt), ay) };
+			__m128 z{ _mm_add_ps(_mm_mul_ps(_mm_sub_ps(bz, az), tt), az) };
+			__m128 w{ _mm_add_ps(_mm_mul_ps(_mm_sub_ps(bw, aw), tt), aw) };
+
+			const __m128 length{ _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)), _mm_mul_ps(w, w))) };
+			x = _mm_div_ps(x, length);
+			y = _mm_div_ps(y, length);
+			z = _mm_div_ps(z, length);
+			w = _mm_div_ps(w, length);
+
+			storeTransposed4(out + i * 4, x, y, z, w);
+		}
+		nlerpBatchScalar(reinterpret_cast<const Quaternion*>(a + i * 4), reinterpret_cast<const Quaternion*>(b + i * 4), t,
+			reinterpret_cast<Quaternion*>(out + i * 4), count - i);
+	}
+
+	// 8 quaternions at a time with FMA
+	FS_TARGET_AVX2 static void nlerpBatchAvx2(const float* a, const float* b, float t, float* out, size_t count) noexcept
+	{
+		const __m256 tt{ _mm256_set1_ps(t) };
+		const __m256 signMask{ _mm256_set1_ps(-0.0f) };
+
+		size_t i{};
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 ax, ay, az, aw;
+			loadTransposed8(a + i * 4, ax, ay, az, aw);
+			__m256 bx, by, bz, bw;
+			loadTransposed8(b + i * 4, bx, by, bz, bw);
+
+			const __m256 dot{ _mm256_fmadd_ps(aw, bw, _mm256_fmadd_ps(az, bz, _mm256_fmadd_ps(ay, by, _mm256_mul_ps(ax, bx)))) };
+			const __m256 sign{ _mm256_and_ps(dot, signMask) };
+			bx = _mm256_xor_ps(bx, sign);
+			by = _mm256_xor_ps(by, sign);
+			bz = _mm256_xor_ps(bz, sign);
+			bw = _mm256_xor_ps(bw, sign);
+
+			__m256 x{ _mm256_fmadd_ps(_mm256_sub_ps(bx, ax), tt, ax) };
+			__m256 y{ _mm256_fmadd_ps(_mm256_sub_ps(by, ay), tt, ay) };
+			__m256 z{ _mm256_fmadd_ps(_mm256_sub_ps(bz, az), tt, az) };
+			__m256 w{ _mm256_fmadd_ps(_mm256_sub_ps(bw, aw), tt, aw) };
+
+			const __m256 length{ _mm256_sqrt_ps(_mm256_fmadd_ps(w, w, _mm256_fmadd_ps(z, z, _mm256_fmadd_ps(y, y, _mm256_mul_ps(x, x))))) };
+			x = _mm256_div_ps(x, length);
+			y = _mm256_div_ps(y, length);
+			z = _mm256_div_ps(z, length);
+			w = _mm256_div_ps(w, length);
+
+			storeTransposed8(out + i * 4, x, y, z, w);
+		}
+		nlerpBatchSse2(a + i * 4, b + i * 4, t, out + i * 4, count - i);
+	}
+
+	void Quaternion::nlerp(std::span<const Quaternion> a, std::span<const Quaternion> b, float t, std::span<Quaternion> out) noexcept
+	{
+		assert(a.size() == b.size() && a.size() == out.size());
+
+		getBatchKernel<nlerpBatchSse2, nlerpBatchAvx2>()(reinterpret_cast<const float*>(a.data()), reinterpret_cast<const float*>(b.data()), t,
+			reinterpret_cast<float*>(out.data()), a.size());
+	}
+}
@@ -0,0 +1,610 @@
+﻿#pragma once
+
+
+#ifndef FS_FLOAT4_H
+#define FS_FLOAT4_H
+// === HEADER BEGINS ===
+
+
+#include <Core/_CommonTypes.h>
+#include <Core/CpuFeatures.h>
+#include <Core/FastMath.h>
+#include <immintrin.h>
+#include <cmath>
+#include <span>
+#include <type_traits>
+
+
+namespace fs
+{
+	class Float4;
+	class Quaternion;
+	class Float4x4;
+	class Affine3x4;
+
+	// SSE
+	// private fields
+	// header-only and trivially copyable, so every operation can be inlined
+	class alignas(16) Float4 final
+	{
+		friend class Float4x4;
+		friend class Affine3x4;
+
+	public:
+		// constexpr: usable in constant expressions (e.g. static tables); SSE when evaluated at runtime
+		explicit constexpr		Float4();
+		explicit constexpr		Float4(float x, float y, float z, float w);
+		explicit constexpr		Float4(const __m128& m);
+		// converts Quaternion to Float4
+		explicit				Float4(const Quaternion& q);
+								Float4(const Float4& b)				= default;
+								Float4(Float4&& b) noexcept			= default;
+								~Float4()							= default;
+
+	public:
+		Float4&					operator=(const Float4& b)			= default;
+		Float4&					operator=(Float4&& b) noexcept		= default;
+
+	public:
+		Float4&					operator+=(const Float4& b);
+		Float4&					operator-=(const Float4& b);
+
+		// component-wise
+		Float4&					operator*=(const Float4& b);
+		// component-wise
+		Float4&					operator/=(const Float4& b);
+
+		// scalar
+		Float4&					operator*=(float s);
+		// scalar
+		Float4&					operator/=(float s);
+
+	public:
+		Float4					operator+(const Float4& b) const;
+		Float4					operator-(const Float4& b) const;
+
+		// component-wise
+		Float4					operator*(const Float4& b) const;
+		// component-wise
+		Float4					operator/(const Float4& b) const;
+
+		// scalar
+		Float4					operator*(float s) const;
+		// scalar
+		Float4					operator/(float s) const;
+
+	public:
+		Float4					operator==(const Float4& b) const noexcept;
+		Float4					operator!=(const Float4& b) const noexcept;
+
+	public:
+		void					set(float x, float y, float z, float w);
+
+		void					setX(float s) noexcept;
+		void					setY(float s) noexcept;
+		void					setZ(float s) noexcept;
+		void					setW(float s) noexcept;
+
+		float					get(uint32 index) const noexcept;
+		float					getX() const noexcept;
+		float					getY() const noexcept;
+		float					getZ() const noexcept;
+		float					getW() const noexcept;
+
+		// (x, x, x, x), (y, y, y, y), ...
+		Float4					splatX() const noexcept;
+		Float4					splatY() const noexcept;
+		Float4					splatZ() const noexcept;
+		Float4					splatW() const noexcept;
+
+	private:
+		__m128					_data;
+
+	// static functions
+	public:
+		static float			dot(const Float4& a, const Float4& b) noexcept;
+		// a . b in every component. Stays in the register (SSE4.1 dpps if enabled at compile time, shuffles otherwise)
+		static Float4			dotSplat(const Float4& a, const Float4& b) noexcept;
+		// a * b + c (fused if FMA is enabled at compile time)
+		static Float4			multiplyAdd(const Float4& a, const Float4& b, const Float4& c) noexcept;
+		static Float4			cross(const Float4& a, const Float4& b) noexcept;
+		// Precision: fastmath::Precise (libm) or fastmath::Fast
+		template <typename Precision = fastmath::Precise>
+		static float			length(const Float4& a) noexcept;
+		template <typename Precision = fastmath::Precise>
+		static Float4			normalize(const Float4& a) noexcept;
+	};
+
+	// alias
+	using float4				= Float4;
+
+
+	// q == a + bi + cj + dk
+	//      w    x    y    z (Float4)
+	class alignas(16) Quaternion final
+	{
+		friend class Float4;
+
+	public:
+		explicit				Quaternion();
+		explicit				Quaternion(const float a, const float b, const float c, const float d);
+		// converts Float4 to Quaternion
+		explicit				Quaternion(const Float4& v);
+								Quaternion(const Quaternion& q)				= default;
+								Quaternion(Quaternion&& q) noexcept			= default;
+								~Quaternion()								= default;
+
+	public:
+		Quaternion&				operator=(const Quaternion& q)				= default;
+		Quaternion&				operator=(Quaternion&& q) noexcept			= default;
+
+	public:
+		// Hamilton product
+		Quaternion				operator*(const Quaternion& q) const noexcept;
+		Quaternion				operator/(const float s) const noexcept;
+
+	public:
+		Quaternion				reciprocal() const noexcept;
+
+		// q v q^(-1) for a unit quaternion, as v + 2a(u x v) + 2u x (u x v) with u = (b, c, d). The w of v is kept.
+		// (no Hamilton products, no reciprocal)
+		Float4					rotate(const Float4& v) const noexcept;
+		// out[i] = rotate(in[i]), 4 (SSE) or 8 (AVX2) vectors at a time. in and out must have the same size and may be the same.
+		void					rotate(std::span<const Float4> in, std::span<Float4> out) const noexcept;
+
+		// rotation matrix of a unit quaternion (defined in Float4x4.h)
+		Float4x4				toMatrix() const noexcept;
+
+	private:
+		float					getA() const noexcept;
+		float					getB() const noexcept;
+		float					getC() const noexcept;
+		float					getD() const noexcept;
+
+	// static functions
+	private:
+		// q*
+		static Quaternion		conjugate(const Quaternion& q) noexcept;
+
+		// ||q||
+		static float			norm(const Quaternion& q) noexcept;
+
+	// static functions
+	public:
+		template <typename Precision = fastmath::Precise>
+		static Quaternion		rotationQuaternion(const Float4& axis, float angle) noexcept;
+
+		// q^(-1)
+		static Quaternion		reciprocal(const Quaternion& q) noexcept;
+
+		// q / ||q||
+		static Quaternion		normalize(const Quaternion& q) noexcept;
+
+		// 4D dot product. |dot| == 1 means the same rotation.
+		static float			dot(const Quaternion& a, const Quaternion& b) noexcept;
+
+		// unit quaternion of the rotation part of m (Shepperd's method, defined in Float4x4.h)
+		static Quaternion		fromMatrix(const Float4x4& m) noexcept;
+
+		// Both take the shorter arc (b is negated when dot(a, b) < 0) and return a unit quaternion.
+		// nlerp() is cheaper but its angular speed is not constant; slerp() falls back to it when a and b are almost equal.
+		static Quaternion		nlerp(const Quaternion& a, const Quaternion& b, float t) noexcept;
+		static Quaternion		slerp(const Quaternion& a, const Quaternion& b, float t) noexcept;
+
+		// out[i] = nlerp(a[i], b[i], t), 4 (SSE) or 8 (AVX2) quaternions at a time.
+		// All spans must have the same size. out may be a or b.
+		static void				nlerp(std::span<const Quaternion> a, std::span<const Quaternion> b, float t, std::span<Quaternion> out) noexcept;
+
+	private:
+		Float4					_data;
+	};
+
+	// alias
+	using quaternion = Quaternion;
+
+	static_assert(std::is_trivially_copyable<Float4>::value, "Float4 must be trivially copyable.");
+	static_assert(std::is_trivially_copyable<Quaternion>::value, "Quaternion must be trivially copyable.");
+	static_assert(sizeof(Float4) == 16 && alignof(Float4) == 16, "Float4 must be exactly one __m128.");
+
+
+	// __m128 can be aggregate-initialized in constant expressions: it is a union of arrays on MSVC and a vector type on GCC/Clang.
+	// The intrinsics cannot, so they are used only at runtime.
+	constexpr Float4::Float4()
+	{
+		if (std::is_constant_evaluated() == true)
+		{
+			_data = __m128{};
+		}
+		else
+		{
+			_data = _mm_setzero_ps();
+		}
+	}
+
+	constexpr Float4::Float4(float x, float y, float z, float w)
+	{
+		if (std::is_constant_evaluated() == true)
+		{
+			_data = __m128{ x, y, z, w };
+		}
+		else
+		{
+			_data = _mm_set_ps(w, z, y, x);
+		}
+	}
+
+	constexpr Float4::Float4(const __m128& m) : _data{ m }
+	{
+		__noop;
+	}
+
+	inline Float4::Float4(const Quaternion& q) : Float4(q.getB(), q.getC(), q.getD(), 1)
+	{
+		__noop;
+	}
+
+	inline Float4& Float4::operator+=(const Float4& b)
+	{
+		_data = _mm_add_ps(_data, b._data);
+		return *this;
+	}
+
+	inline Float4& Float4::operator-=(const Float4& b)
+	{
+		_data = _mm_sub_ps(_data, b._data);
+		return *this;
+	}
+
+	inline Float4& Float4::operator*=(const Float4& b)
+	{
+		_data = _mm_mul_ps(_data, b._data);
+		return *this;
+	}
+
+	inline Float4& Float4::operator/=(const Float4& b)
+	{
+		_data = _mm_div_ps(_data, b._data);
+		return *this;
+	}
+
+	inline Float4& Float4::operator*=(float s)
+	{
+		_data = _mm_mul_ps(_data, _mm_set1_ps(s));
+		return *this;
+	}
+
+	inline Float4& Float4::operator/=(float s)
+	{
+		_data = _mm_div_ps(_data, _mm_set1_ps(s));
+		return *this;
+	}
+
+	inline Float4 Float4::operator+(const Float4& b) const
+	{
+		return Float4(_mm_add_ps(_data, b._data));
+	}
+
+	inline Float4 Float4::operator-(const Float4& b) const
+	{
+		return Float4(_mm_sub_ps(_data, b._data));
+	}
+
+	inline Float4 Float4::operator*(const Float4& b) const
+	{
+		return Float4(_mm_mul_ps(_data, b._data));
+	}
+
+	inline Float4 Float4::operator/(const Float4& b) const
+	{
+		return Float4(_mm_div_ps(_data, b._data));
+	}
+
+	inline Float4 Float4::operator*(float s) const
+	{
+		return Float4(_mm_mul_ps(_data, _mm_set1_ps(s)));
+	}
+
+	inline Float4 Float4::operator/(float s) const
+	{
+		return Float4(_mm_div_ps(_data, _mm_set1_ps(s)));
+	}
+
+	inline Float4 Float4::operator==(const Float4& b) const noexcept
+	{
+		return Float4(_mm_cmpeq_ps(_data, b._data));
+	}
+
+	inline Float4 Float4::operator!=(const Float4& b) const noexcept
+	{
+		return Float4(_mm_cmpneq_ps(_data, b._data));
+	}
+
+	inline void Float4::set(float x, float y, float z, float w)
+	{
+		_data = _mm_set_ps(w, z, y, x);
+	}
+
+	inline void Float4::setX(float s) noexcept
+	{
+		_data = _mm_move_ss(_data, _mm_set_ss(s));
+	}
+
+	// No portable way to address a lane by index (m128_f32 is MSVC only), so go through memory.
+	// Compilers turn this into a single insert/extract.
+	inline void Float4::setY(float s) noexcept
+	{
+		alignas(16) float f[4];
+		_mm_store_ps(f, _data);
+		f[1] = s;
+		_data = _mm_load_ps(f);
+	}
+
+	inline void Float4::setZ(float s) noexcept
+	{
+		alignas(16) float f[4];
+		_mm_store_ps(f, _data);
+		f[2] = s;
+		_data = _mm_load_ps(f);
+	}
+
+	inline void Float4::setW(float s) noexcept
+	{
+		alignas(16) float f[4];
+		_mm_store_ps(f, _data);
+		f[3] = s;
+		_data = _mm_load_ps(f);
+	}
+
+	inline float Float4::get(uint32 index) const noexcept
+	{
+		alignas(16) float f[4];
+		_mm_store_ps(f, _data);
+		return f[index];
+	}
+
+	inline float Float4::getX() const noexcept
+	{
+		return _mm_cvtss_f32(_data);
+	}
+
+	inline float Float4::getY() const noexcept
+	{
+		return _mm_cvtss_f32(_mm_shuffle_ps(_data, _data, _MM_SHUFFLE(1, 1, 1, 1)));
+	}
+
+	inline float Float4::getZ() const noexcept
+	{
+		return _mm_cvtss_f32(_mm_shuffle_ps(_data, _data, _MM_SHUFFLE(2, 2, 2, 2)));
+	}
+
+	inline float Float4::getW() const noexcept
+	{
+		return _mm_cvtss_f32(_mm_shuffle_ps(_data, _data, _MM_SHUFFLE(3, 3, 3, 3)));
+	}
+
+	inline Float4 Float4::splatX() const noexcept
+	{
+		return Float4(_mm_shuffle_ps(_data, _data, _MM_SHUFFLE(0, 0, 0, 0)));
+	}
+
+	inline Float4 Float4::splatY() const noexcept
+	{
+		return Float4(_mm_shuffle_ps(_data, _data, _MM_SHUFFLE(1, 1, 1, 1)));
+	}
+
+	inline Float4 Float4::splatZ() const noexcept
+	{
+		return Float4(_mm_shuffle_ps(_data, _data, _MM_SHUFFLE(2, 2, 2, 2)));
+	}
+
+	inline Float4 Float4::splatW() const noexcept
+	{
+		return Float4(_mm_shuffle_ps(_data, _data, _MM_SHUFFLE(3, 3, 3, 3)));
+	}
+
+	inline float Float4::dot(const Float4& a, const Float4& b) noexcept
+	{
+		return _mm_cvtss_f32(dotSplat(a, b)._data);
+	}
+
+	inline Float4 Float4::dotSplat(const Float4& a, const Float4& b) noexcept
+	{
+#if FS_SIMD_SSE41
+		return Float4(_mm_dp_ps(a._data, b._data, 0xFF));
+#else
+		// (m0 + m1, m1 + m0, m2 + m3, m3 + m2), then add the swapped halves
+		const __m128 m{ _mm_mul_ps(a._data, b._data) };
+		const __m128 pairSum{ _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1))) };
+		return Float4(_mm_add_ps(pairSum, _mm_shuffle_ps(pairSum, pairSum, _MM_SHUFFLE(1, 0, 3, 2))));
+#endif
+	}
+
+	inline Float4 Float4::multiplyAdd(const Float4& a, const Float4& b, const Float4& c) noexcept
+	{
+#if FS_SIMD_FMA
+		return Float4(_mm_fmadd_ps(a._data, b._data, c._data));
+#else
+		return Float4(_mm_add_ps(_mm_mul_ps(a._data, b._data), c._data));
+#endif
+	}
+
+	inline Float4 Float4::cross(const Float4& a, const Float4& b) noexcept
+	{
+		// (a * b.yzx - a.yzx * b).yzx
+		const __m128 aYZX{ _mm_shuffle_ps(a._data, a._data, _MM_SHUFFLE(3, 0, 2, 1)) };
+		const __m128 bYZX{ _mm_shuffle_ps(b._data, b._data, _MM_SHUFFLE(3, 0, 2, 1)) };
+		const __m128 result{ _mm_sub_ps(_mm_mul_ps(a._data, bYZX), _mm_mul_ps(aYZX, b._data)) };
+		return Float4(_mm_shuffle_ps(result, result, _MM_SHUFFLE(3, 0, 2, 1)));
+	}
+
+	template <typename Precision>
+	inline float Float4::length(const Float4& a) noexcept
+	{
+		return Precision::sqrt(Float4::dot(a, a));
+	}
+
+	template <typename Precision>
+	inline Float4 Float4::normalize(const Float4& a) noexcept
+	{
+		float length{ Float4::length<Precision>(a) };
+		return (a / length);
+	}
+
+
+	inline Quaternion::Quaternion()
+	{
+		__noop;
+	}
+
+	inline Quaternion::Quaternion(const float a, const float b, const float c, const float d) : _data{ b, c, d, a }
+	{
+		__noop;
+	}
+
+	inline Quaternion::Quaternion(const Float4& v) : _data{ v.getX(), v.getY(), v.getZ(), 0 }
+	{
+		__noop;
+	}
+
+	inline Quaternion Quaternion::operator*(const Quaternion& q) const noexcept
+	{
+		const float a1 = getA();
+		const float b1 = getB();
+		const float c1 = getC();
+		const float d1 = getD();
+
+		const float a2 = q.getA();
+		const float b2 = q.getB();
+		const float c2 = q.getC();
+		const float d2 = q.getD();
+
+		return Quaternion
+		(
+			+ a1 * a2 - b1 * b2 - c1 * c2 - d1 * d2,
+			+ a1 * b2 + b1 * a2 + c1 * d2 - d1 * c2, // i
+			+ a1 * c2 - b1 * d2 + c1 * a2 + d1 * b2, // j
+			+ a1 * d2 + b1 * c2 - c1 * b2 + d1 * a2  // k
+		);
+	}
+
+	inline Quaternion Quaternion::operator/(const float s) const noexcept
+	{
+		return Quaternion(getA() / s, getB() / s, getC() / s, getD() / s);
+	}
+
+	inline Quaternion Quaternion::reciprocal() const noexcept
+	{
+		return Quaternion::reciprocal(*this);
+	}
+
+	inline Float4 Quaternion::rotate(const Float4& v) const noexcept
+	{
+		// Float4::cross() leaves w == 0, so only the vector part of _data takes part.
+		const Float4 t{ Float4::cross(_data, v) * 2.0f };
+		return Float4::multiplyAdd(t, _data.splatW(), v) + Float4::cross(_data, t);
+	}
+
+	inline float Quaternion::getA() const noexcept
+	{
+		return _data.getW();
+	}
+
+	inline float Quaternion::getB() const noexcept
+	{
+		return _data.getX();
+	}
+
+	inline float Quaternion::getC() const noexcept
+	{
+		return _data.getY();
+	}
+
+	inline float Quaternion::getD() const noexcept
+	{
+		return _data.getZ();
+	}
+
+	inline Quaternion Quaternion::conjugate(const Quaternion& q) noexcept
+	{
+		const float a = q.getA();
+		const float b = q.getB();
+		const float c = q.getC();
+		const float d = q.getD();
+		return Quaternion(a, -b, -c, -d);
+	}
+
+	inline float Quaternion::norm(const Quaternion& q) noexcept
+	{
+		return Float4::length(q._data);
+	}
+
+	inline Quaternion Quaternion::reciprocal(const Quaternion& q) noexcept
+	{
+		const Quaternion	conjugate	= Quaternion::conjugate(q);
+		const float			norm		= Quaternion::norm(q);
+		return Quaternion(conjugate / (norm * norm));
+	}
+
+	inline Quaternion Quaternion::normalize(const Quaternion& q) noexcept
+	{
+		Quaternion result;
+		result._data = Float4::normalize(q._data);
+		return result;
+	}
+
+	inline float Quaternion::dot(const Quaternion& a, const Quaternion& b) noexcept
+	{
+		return Float4::dot(a._data, b._data);
+	}
+
+	inline Quaternion Quaternion::nlerp(const Quaternion& a, const Quaternion& b, float t) noexcept
+	{
+		const Float4 bShorter{ (Quaternion::dot(a, b) < 0.0f) ? (Float4() - b._data) : b._data };
+		Quaternion result;
+		result._data = Float4::normalize(Float4::multiplyAdd(bShorter - a._data, Float4(t, t, t, t), a._data));
+		return result;
+	}
+
+	inline Quaternion Quaternion::slerp(const Quaternion& a, const Quaternion& b, float t) noexcept
+	{
+		// Below this angle sin(theta) loses too much precision and nlerp() is just as accurate.
+		static constexpr float kNlerpThreshold{ 0.9995f };
+
+		float cosTheta{ Quaternion::dot(a, b) };
+		Float4 bShorter{ b._data };
+		if (cosTheta < 0.0f)
+		{
+			cosTheta = -cosTheta;
+			bShorter = Float4() - b._data;
+		}
+		if (cosTheta > kNlerpThreshold)
+		{
+			Quaternion bQuaternion;
+			bQuaternion._data = bShorter;
+			return Quaternion::nlerp(a, bQuaternion, t);
+		}
+
+		const float theta{ acosf(cosTheta) };
+		const float sinTheta{ sinf(theta) };
+		const float weightA{ sinf((1.0f - t) * theta) / sinTheta };
+		const float weightB{ sinf(t * theta) / sinTheta };
+		Quaternion result;
+		result._data = Float4::multiplyAdd(a._data, Float4(weightA, weightA, weightA, weightA), bShorter * weightB);
+		return result;
+	}
+
+	template <typename Precision>
+	inline Quaternion Quaternion::rotationQuaternion(const Float4& axis, float angle) noexcept
+	{
+		const Float4	r			= Float4::normalize<Precision>(axis);
+		const float		half_angle	= angle * 0.5f;
+		float			cos_half;
+		float			sin_half;
+		Precision::sinCos(half_angle, sin_half, cos_half);
+		return Quaternion(cos_half, sin_half * r.getX(), sin_half * r.getY(), sin_half * r.getZ());
+	}
+}
+
+
+// === HEADER ENDS ===
+#endif // !FS_FLOAT4_H
@@ -0,0 +1,578 @@
+﻿#include "Float4Stream.h"
+#include <Core/CpuFeatures.h>
+
+#include <cassert>
+#include <immintrin.h>
+
+
+namespace fs
+{
+	// x, y, z, w arrays of a stream
+	struct StreamPointers
+	{
+		const float*	x;
+		const float*	y;
+		const float*	z;
+		const float*	w;
+	};
+
+	struct MutableStreamPointers
+	{
+		float*			x;
+		float*			y;
+		float*			z;
+		float*			w;
+	};
+
+	// Each kernel handles [0, count) with its own width and leaves the rest to the narrower kernel.
+	// (matrix is row-major, 16 floats)
+	struct Float4StreamKernels
+	{
+		void (*dot)(StreamPointers a, StreamPointers b, float* out, size_t count) noexcept;
+		void (*cross)(StreamPointers a, StreamPointers b, MutableStreamPointers out, size_t count) noexcept;
+		void (*length)(StreamPointers a, float* out, size_t count) noexcept;
+		void (*normalize)(StreamPointers a, MutableStreamPointers out, size_t count) noexcept;
+		void (*transform)(const float* matrix, StreamPointers in, MutableStreamPointers out, size_t count) noexcept;
+	};
+
+	static StreamPointers offset(const StreamPointers& p, size_t i) noexcept
+	{
+		return StreamPointers{ p.x + i, p.y + i, p.z + i, p.w + i };
+	}
+
+	static MutableStreamPointers offset(const MutableStreamPointers& p, size_t i) noexcept
+	{
+		return MutableStreamPointers{ p.x + i, p.y + i, p.z + i, p.w + i };
+	}
+
+
+	static void dotScalar(StreamPointers a, StreamPointers b, float* out, size_t count) noexcept
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			out[i] = a.x[i] * b.x[i] + a.y[i] * b.y[i] + a.z[i] * b.z[i] + a.w[i] * b.w[i];
+		}
+	}
+
+	static void crossScalar(StreamPointers a, StreamPointers b, MutableStreamPointers out, size_t count) noexcept
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			const float x{ a.y[i] * b.z[i] - a.z[i] * b.y[i] };
+			const float y{ a.z[i] * b.x[i] - a.x[i] * b.z[i] };
+			const float z{ a.x[i] * b.y[i] - a.y[i] * b.x[i] };
+			out.x[i] = x;
+			out.y[i] = y;
+			out.z[i] = z;
+			out.w[i] = 0.0f;
+		}
+	}
+
+	static void lengthScalar(StreamPointers a, float* out, size_t count) noexcept
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			out[i] = sqrtf(a.x[i] * a.x[i] + a.y[i] * a.y[i] + a.z[i] * a.z[i] + a.w[i] * a.w[i]);
+		}
+	}
+
+	static void normalizeScalar(StreamPointers a, MutableStreamPointers out, size_t count) noexcept
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			const float length{ sqrtf(a.x[i] * a.x[i] + a.y[i] * a.y[i] + a.z[i] * a.z[i] + a.w[i] * a.w[i]) };
+			out.x[i] = a.x[i] / length;
+			out.y[i] = a.y[i] / length;
+			out.z[i] = a.z[i] / length;
+			out.w[i] = a.w[i] / length;
+		}
+	}
+
+	static void transformScalar(const float* matrix, StreamPointers in, MutableStreamPointers out, size_t count) noexcept
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			const float x{ in.x[i] };
+			const float y{ in.y[i] };
+			const float z{ in.z[i] };
+			const float w{ in.w[i] };
+			out.x[i] = matrix[0] * x + matrix[1] * y + matrix[2] * z + matrix[3] * w;
+			out.y[i] = matrix[4] * x + matrix[5] * y + matrix[6] * z + matrix[7] * w;
+			out.z[i] = matrix[8] * x + matrix[9] * y + matrix[10] * z + matrix[11] * w;
+			out.w[i] = matrix[12] * x + matrix[13] * y + matrix[14] * z + matrix[15] * w;
+		}
+	}
+
+
+	// SSE2, 4 lanes
+	static inline __m128 dot4(__m128 ax, __m128 ay, __m128 az, __m128 aw, __m128 bx, __m128 by, __m128 bz, __m128 bw) noexcept
+	{
+		return _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz)), _mm_mul_ps(aw, bw));
+	}
+
+	static void dotSse2(StreamPointers a, StreamPointers b, float* out, size_t count) noexcept
+	{
+		size_t i{};
+		for (; i + 4 <= count; i += 4)
+		{
+			_mm_storeu_ps(out + i, dot4(
+				_mm_loadu_ps(a.x + i), _mm_loadu_ps(a.y + i), _mm_loadu_ps(a.z + i), _mm_loadu_ps(a.w + i),
+				_mm_loadu_ps(b.x + i), _mm_loadu_ps(b.y + i), _mm_loadu_ps(b.z + i), _mm_loadu_ps(b.w + i)));
+		}
+		dotScalar(offset(a, i), offset(b, i), out + i, count - i);
+	}
+
+	static void crossSse2(StreamPointers a, StreamPointers b, MutableStreamPointers out, size_t count) noexcept
+	{
+		size_t i{};
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 ax{ _mm_loadu_ps(a.x + i) }, ay{ _mm_loadu_ps(a.y + i) }, az{ _mm_loadu_ps(a.z + i) };
+			const __m128 bx{ _mm_loadu_ps(b.x + i) }, by{ _mm_loadu_ps(b.y + i) }, bz{ _mm_loadu_ps(b.z + i) };
+			_mm_storeu_ps(out.x + i, _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by)));
+			_mm_storeu_ps(out.y + i, _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz)));
+			_mm_storeu_ps(out.z + i, _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx)));
+			_mm_storeu_ps(out.w + i, _mm_setzero_ps());
+		}
+		crossScalar(offset(a, i), offset(b, i), offset(out, i), count - i);
+	}
+
+	static void lengthSse2(StreamPointers a, float* out, size_t count) noexcept
+	{
+		size_t i{};
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 x{ _mm_loadu_ps(a.x + i) }, y{ _mm_loadu_ps(a.y + i) }, z{ _mm_loadu_ps(a.z + i) }, w{ _mm_loadu_ps(a.w + i) };
+			_mm_storeu_ps(out + i, _mm_sqrt_ps(dot4(x, y, z, w, x, y, z, w)));
+		}
+		lengthScalar(offset(a, i), out + i, count - i);
+	}
+
+	static void normalizeSse2(StreamPointers a, MutableStreamPointers out, size_t count) noexcept
+	{
+		size_t i{};
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 x{ _mm_loadu_ps(a.x + i) }, y{ _mm_loadu_ps(a.y + i) }, z{ _mm_loadu_ps(a.z + i) }, w{ _mm_loadu_ps(a.w + i) };
+			const __m128 length{ _mm_sqrt_ps(dot4(x, y, z, w, x, y, z, w)) };
+			_mm_storeu_ps(out.x + i, _mm_div_ps(x, length));
+			_mm_storeu_ps(out.y + i, _mm_div_ps(y, length));
+			_mm_storeu_ps(out.z + i, _mm_div_ps(z, length));
+			_mm_storeu_ps(out.w + i, _mm_div_ps(w, length));
+		}
+		normalizeScalar(offset(a, i), offset(out, i), count - i);
+	}
+
+	static void transformSse2(const float* matrix, StreamPointers in, MutableStreamPointers out, size_t count) noexcept
+	{
+		__m128 m[16];
+		for (size_t j = 0; j < 16; ++j)
+		{
+			m[j] = _mm_set1_ps(matrix[j]);
+		}
+
+		float* const outRows[4]{ out.x, out.y, out.z, out.w };
+		size_t i{};
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 x{ _mm_loadu_ps(in.x + i) }, y{ _mm_loadu_ps(in.y + i) }, z{ _mm_loadu_ps(in.z + i) }, w{ _mm_loadu_ps(in.w + i) };
+			__m128 result[4];
+			for (size_t row = 0; row < 4; ++row)
+			{
+				result[row] = dot4(m[row * 4 + 0], m[row * 4 + 1], m[row * 4 + 2], m[row * 4 + 3], x, y, z, w);
+			}
+			for (size_t row = 0; row < 4; ++row)
+			{
+				_mm_storeu_ps(outRows[row] + i, result[row]);
+			}
+		}
+		transformScalar(matrix, offset(in, i), offset(out, i), count - i);
+	}
+
+
+	// AVX2 + FMA, 8 lanes
+	FS_TARGET_AVX2 static inline __m256 dot8(__m256 ax, __m256 ay, __m256 az, __m256 aw, __m256 bx, __m256 by, __m256 bz, __m256 bw) noexcept
+	{
+		return _mm256_fmadd_ps(aw, bw, _mm256_fmadd_ps(az, bz, _mm256_fmadd_ps(ay, by, _mm256_mul_ps(ax, bx))));
+	}
+
+	FS_TARGET_AVX2 static void dotAvx2(StreamPointers a, StreamPointers b, float* out, size_t count) noexcept
+	{
+		size_t i{};
+		for (; i + 8 <= count; i += 8)
+		{
+			_mm256_storeu_ps(out + i, dot8(
+				_mm256_loadu_ps(a.x + i), _mm256_loadu_ps(a.y + i), _mm256_loadu_ps(a.z + i), _mm256_loadu_ps(a.w + i),
+				_mm256_loadu_ps(b.x + i), _mm256_loadu_ps(b.y + i), _mm256_loadu_ps(b.z + i), _mm256_loadu_ps(b.w + i)));
+		}
+		dotSse2(offset(a, i), offset(b, i), out + i, count - i);
+	}
+
+	FS_TARGET_AVX2 static void crossAvx2(StreamPointers a, StreamPointers b, MutableStreamPointers out, size_t count) noexcept
+	{
+		size_t i{};
+		for (; i + 8 <= count; i += 8)
+		{
+			const __m256 ax{ _mm256_loadu_ps(a.x + i) }, ay{ _mm256_loadu_ps(a.y + i) }, az{ _mm256_loadu_ps(a.z + i) };
+			const __m256 bx{ _mm256_loadu_ps(b.x + i) }, by{ _mm256_loadu_ps(b.y + i) }, bz{ _mm256_loadu_ps(b.z + i) };
+			_mm256_storeu_ps(out.x + i, _mm256_fmsub_ps(ay, bz, _mm256_mul_ps(az, by)));
+			_mm256_storeu_ps(out.y + i, _mm256_fmsub_ps(az, bx, _mm256_mul_ps(ax, bz)));
+			_mm256_storeu_ps(out.z + i, _mm256_fmsub_ps(ax, by, _mm256_mul_ps(ay, bx)));
+			_mm256_storeu_ps(out.w + i, _mm256_setzero_ps());
+		}
+		crossSse2(offset(a, i), offset(b, i), offset(out, i), count - i);
+	}
+
+	FS_TARGET_AVX2 static void lengthAvx2(StreamPointers a, float* out, size_t count) noexcept
+	{
+		size_t i{};
+		for (; i + 8 <= count; i += 8)
+		{
+			const __m256 x{ _mm256_loadu_ps(a.x + i) }, y{ _mm256_loadu_ps(a.y + i) }, z{ _mm256_loadu_ps(a.z + i) }, w{ _mm256_loadu_ps(a.w + i) };
+			_mm256_storeu_ps(out + i, _mm256_sqrt_ps(dot8(x, y, z, w, x, y, z, w)));
+		}
+		lengthSse2(offset(a, i), out + i, count - i);
+	}
+
+	FS_TARGET_AVX2 static void normalizeAvx2(StreamPointers a, MutableStreamPointers out, size_t count) noexcept
+	{
+		size_t i{};
+		for (; i + 8 <= count; i += 8)
+		{
+			const __m256 x{ _mm256_loadu_ps(a.x + i) }, y{ _mm256_loadu_ps(a.y + i) }, z{ _mm256_loadu_ps(a.z + i) }, w{ _mm256_loadu_ps(a.w + i) };
+			const __m256 length{ _mm256_sqrt_ps(dot8(x, y, z, w, x, y, z, w)) };
+			_mm256_storeu_ps(out.x + i, _mm256_div_ps(x, length));
+			_mm256_storeu_ps(out.y + i, _mm256_div_ps(y, length));
+			_mm256_storeu_ps(out.z + i, _mm256_div_ps(z, length));
+			_mm256_storeu_ps(out.w + i, _mm256_div_ps(w, length));
+		}
+		normalizeSse2(offset(a, i), offset(out, i), count - i);
+	}
+
+	FS_TARGET_AVX2 static void transformAvx2(const float* matrix, StreamPointers in, MutableStreamPointers out, size_t count) noexcept
+	{
+		__m256 m[16];
+		for (size_t j = 0; j < 16; ++j)
+		{
+			m[j] = _mm256_set1_ps(matrix[j]);
+		}
+
+		float* const outRows[4]{ out.x, out.y, out.z, out.w };
+		size_t i{};
+		for (; i + 8 <= count; i += 8)
+		{
+			const __m256 x{ _mm256_loadu_ps(in.x + i) }, y{ _mm256_loadu_ps(in.y + i) }, z{ _mm256_loadu_ps(in.z + i) }, w{ _mm256_loadu_ps(in.w + i) };
+			__m256 result[4];
+			for (size_t row = 0; row < 4; ++row)
+			{
+				result[row] = dot8(m[row * 4 + 0], m[row * 4 + 1], m[row * 4 + 2], m[row * 4 + 3], x, y, z, w);
+			}
+			for (size_t row = 0; row < 4; ++row)
+			{
+				_mm256_storeu_ps(outRows[row] + i, result[row]);
+			}
+		}
+		transformSse2(matrix, offset(in, i), offset(out, i), count - i);
+	}
+
+
+	// AVX-512F, 16 lanes
+	FS_TARGET_AVX512 static inline __m512 dot16(__m512 ax, __m512 ay, __m512 az, __m512 aw, __m512 bx, __m512 by, __m512 bz, __m512 bw) noexcept
+	{
+		return _mm512_fmadd_ps(aw, bw, _mm512_fmadd_ps(az, bz, _mm512_fmadd_ps(ay, by, _mm512_mul_ps(ax, bx))));
+	}
+
+	FS_TARGET_AVX512 static void dotAvx512(StreamPointers a, StreamPointers b, float* out, size_t count) noexcept
+	{
+		size_t i{};
+		for (; i + 16 <= count; i += 16)
+		{
+			_mm512_storeu_ps(out + i, dot16(
+				_mm512_loadu_ps(a.x + i), _mm512_loadu_ps(a.y + i), _mm512_loadu_ps(a.z + i), _mm512_loadu_ps(a.w + i),
+				_mm512_loadu_ps(b.x + i), _mm512_loadu_ps(b.y + i), _mm512_loadu_ps(b.z + i), _mm512_loadu_ps(b.w + i)));
+		}
+		dotAvx2(offset(a, i), offset(b, i), out + i, count - i);
+	}
+
+	FS_TARGET_AVX512 static void crossAvx512(StreamPointers a, StreamPointers b, MutableStreamPointers out, size_t count) noexcept
+	{
+		size_t i{};
+		for (; i + 16 <= count; i += 16)
+		{
+			const __m512 ax{ _mm512_loadu_ps(a.x + i) }, ay{ _mm512_loadu_ps(a.y + i) }, az{ _mm512_loadu_ps(a.z + i) };
+			const __m512 bx{ _mm512_loadu_ps(b.x + i) }, by{ _mm512_loadu_ps(b.y + i) }, bz{ _mm512_loadu_ps(b.z + i) };
+			_mm512_storeu_ps(out.x + i, _mm512_fmsub_ps(ay, bz, _mm512_mul_ps(az, by)));
+			_mm512_storeu_ps(out.y + i, _mm512_fmsub_ps(az, bx, _mm512_mul_ps(ax, bz)));
+			_mm512_storeu_ps(out.z + i, _mm512_fmsub_ps(ax, by, _mm512_mul_ps(ay, bx)));
+			_mm512_storeu_ps(out.w + i, _mm512_setzero_ps());
+		}
+		crossAvx2(offset(a, i), offset(b, i), offset(out, i), count - i);
+	}
+
+	FS_TARGET_AVX512 static void lengthAvx512(StreamPointers a, float* out, size_t count) noexcept
+	{
+		size_t i{};
+		for (; i + 16 <= count; i += 16)
+		{
+			const __m512 x{ _mm512_loadu_ps(a.x + i) }, y{ _mm512_loadu_ps(a.y + i) }, z{ _mm512_loadu_ps(a.z + i) }, w{ _mm512_loadu_ps(a.w + i) };
+			_mm512_storeu_ps(out + i, _mm512_sqrt_ps(dot16(x, y, z, w, x, y, z, w)));
+		}
+		lengthAvx2(offset(a, i), out + i, count - i);
+	}
+
+	FS_TARGET_AVX512 static void normalizeAvx512(StreamPointers a, MutableStreamPointers out, size_t count) noexcept
+	{
+		size_t i{};
+		for (; i + 16 <= count; i += 16)
+		{
+			const __m512 x{ _mm512_loadu_ps(a.x + i) }, y{ _mm512_loadu_ps(a.y + i) }, z{ _mm512_loadu_ps(a.z + i) }, w{ _mm512_loadu_ps(a.w + i) };
+			const __m512 length{ _mm512_sqrt_ps(dot16(x, y, z, w, x, y, z, w)) };
+			_mm512_storeu_ps(out.x + i, _mm512_div_ps(x, length));
+			_mm512_storeu_ps(out.y + i, _mm512_div_ps(y, length));
+			_mm512_storeu_ps(out.z + i, _mm512_div_ps(z, length));
+			_mm512_storeu_ps(out.w + i, _mm512_div_ps(w, length));
+		}
+		normalizeAvx2(offset(a, i), offset(out, i), count - i);
+	}
+
+	FS_TARGET_AVX512 static void transformAvx512(const float* matrix, StreamPointers in, MutableStreamPointers out, size_t count) noexcept
+	{
+		__m512 m[16];
+		for (size_t j = 0; j < 16; ++j)
+		{
+			m[j] = _mm512_set1_ps(matrix[j]);
+		}
+
+		float* const outRows[4]{ out.x, out.y, out.z, out.w };
+		size_t i{};
+		for (; i + 16 <= count; i += 16)
+		{
+			const __m512 x{ _mm512_loadu_ps(in.x + i) }, y{ _mm512_loadu_ps(in.y + i) }, z{ _mm512_loadu_ps(in.z + i) }, w{ _mm512_loadu_ps(in.w + i) };
+			__m512 result[4];
+			for (size_t row = 0; row < 4; ++row)
+			{
+				result[row] = dot16(m[row * 4 + 0], m[row * 4 + 1], m[row * 4 + 2], m[row * 4 + 3], x, y, z, w);
+			}
+			for (size_t row = 0; row < 4; ++row)
+			{
+				_mm512_storeu_ps(outRows[row] + i, result[row]);
+			}
+		}
+		transformAvx2(matrix, offset(in, i), offset(out, i), count - i);
+	}
+
+
+	// Picks the widest kernels only once.
+	static const Float4StreamKernels& getFloat4StreamKernels() noexcept
+	{
+		static const Float4StreamKernels kFloat4StreamKernels
+		{
+			(getSimdLevel() >= ESimdLevel::AVX512) ? Float4StreamKernels{ dotAvx512, crossAvx512, lengthAvx512, normalizeAvx512, transformAvx512 } :
+			(getSimdLevel() >= ESimdLevel::AVX2) ? Float4StreamKernels{ dotAvx2, crossAvx2, lengthAvx2, normalizeAvx2, transformAvx2 } :
+			Float4StreamKernels{ dotSse2, crossSse2, lengthSse2, normalizeSse2, transformSse2 }
+		};
+		return kFloat4StreamKernels;
+	}
+
+	static StreamPointers getPointers(const Float4Stream& stream) noexcept
+	{
+		return StreamPointers{ stream.getX(), stream.getY(), stream.getZ(), stream.getW() };
+	}
+
+	static MutableStreamPointers getPointers(Float4Stream& stream) noexcept
+	{
+		return MutableStreamPointers{ stream.getX(), stream.getY(), stream.getZ(), stream.getW() };
+	}
+
+
+	Float4Stream::Float4Stream()
+	{
+		__noop;
+	}
+
+	Float4Stream::Float4Stream(size_t count)
+	{
+		resize(count);
+	}
+
+	Float4Stream::Float4Stream(const std::vector<Float4>& vVectors)
+	{
+		assign(vVectors);
+	}
+
+	Float4Stream::~Float4Stream()
+	{
+		__noop;
+	}
+
+	void Float4Stream::resize(size_t count)
+	{
+		_x.resize(count);
+		_y.resize(count);
+		_z.resize(count);
+		_w.resize(count);
+	}
+
+	void Float4Stream::clear() noexcept
+	{
+		_x.clear();
+		_y.clear();
+		_z.clear();
+		_w.clear();
+	}
+
+	void Float4Stream::assign(const Float4* vectors, size_t count)
+	{
+		resize(count);
+
+		// 4 vectors at a time: AoS -> SoA is a 4x4 transpose
+		const float* const data{ reinterpret_cast<const float*>(vectors) };
+		size_t i{};
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 x{ _mm_loadu_ps(data + i * 4 + 0) };
+			__m128 y{ _mm_loadu_ps(data + i * 4 + 4) };
+			__m128 z{ _mm_loadu_ps(data + i * 4 + 8) };
+			__m128 w{ _mm_loadu_ps(data + i * 4 + 12) };
+			_MM_TRANSPOSE4_PS(x, y, z, w);
+			_mm_storeu_ps(&_x[i], x);
+			_mm_storeu_ps(&_y[i], y);
+			_mm_storeu_ps(&_z[i], z);
+			_mm_storeu_ps(&_w[i], w);
+		}
+		for (; i < count; ++i)
+		{
+			set(i, vectors[i]);
+		}
+	}
+
+	void Float4Stream::assign(const std::vector<Float4>& vVectors)
+	{
+		assign(vVectors.data(), vVectors.size());
+	}
+
+	void Float4Stream::copyTo(Float4* out) const noexcept
+	{
+		float* const data{ reinterpret_cast<float*>(out) };
+		const size_t count{ size() };
+		size_t i{};
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 x{ _mm_loadu_ps(&_x[i]) };
+			__m128 y{ _mm_loadu_ps(&_y[i]) };
+			__m128 z{ _mm_loadu_ps(&_z[i]) };
+			__m128 w{ _mm_loadu_ps(&_w[i]) };
+			_MM_TRANSPOSE4_PS(x, y, z, w);
+			_mm_storeu_ps(data + i * 4 + 0, x);
+			_mm_storeu_ps(data + i * 4 + 4, y);
+			_mm_storeu_ps(data + i * 4 + 8, z);
+			_mm_storeu_ps(data + i * 4 + 12, w);
+		}
+		for (; i < count; ++i)
+		{
+			out[i] = get(i);
+		}
+	}
+
+	std::vector<Float4> Float4Stream::toVector() const
+	{
+		std::vector<Float4> vVectors(size());
+		copyTo(vVectors.data());
+		return vVectors;
+	}
+
+	void Float4Stream::set(size_t index, const Float4& v) noexcept
+	{
+		_x[index] = v.getX();
+		_y[index] = v.getY();
+		_z[index] = v.getZ();
+		_w[index] = v.getW();
+	}
+
+	Float4 Float4Stream::get(size_t index) const noexcept
+	{
+		return Float4(_x[index], _y[index], _z[index], _w[index]);
+	}
+
+	size_t Float4Stream::size() const noexcept
+	{
+		return _x.size();
+	}
+
+	float* Float4Stream::getX() noexcept
+	{
+		return _x.data();
+	}
+
+	float* Float4Stream::getY() noexcept
+	{
+		return _y.data();
+	}
+
+	float* Float4Stream::getZ() noexcept
+	{
+		return _z.data();
+	}
+
+	float* Float4Stream::getW() noexcept
+	{
+		return _w.data();
+	}
+
+	const float* Float4Stream::getX() const noexcept
+	{
+		return _x.data();
+	}
+
+	const float* Float4Stream::getY() const noexcept
+	{
+		return _y.data();
+	}
+
+	const float* Float4Stream::getZ() const noexcept
+	{
+		return _z.data();
+	}
+
+	const float* Float4Stream::getW() const noexcept
+	{
+		return _w.data();
+	}
+
+	void Float4Stream::dot(const Float4Stream& a, const Float4Stream& b, float* out) noexcept
+	{
+		assert(a.size() == b.size());
+		getFloat4StreamKernels().dot(getPointers(a), getPointers(b), out, a.size());
+	}
+
+	void Float4Stream::cross(const Float4Stream& a, const Float4Stream& b, Float4Stream& out)
+	{
+		assert(a.size() == b.size());
+		out.resize(a.size());
+		getFloat4StreamKernels().cross(getPointers(a), getPointers(b), getPointers(out), a.size());
+	}
+
+	void Float4Stream::length(const Float4Stream& a, float* out) noexcept
+	{
+		getFloat4StreamKernels().length(getPointers(a), out, a.size());
+	}
+
+	void Float4Stream::normalize(const Float4Stream& a, Float4Stream& out)
+	{
+		out.resize(a.size());
+		getFloat4StreamKernels().normalize(getPointers(a), getPointers(out), a.size());
+	}
+
+	void Float4Stream::transform(const Float4x4& m, const Float4Stream& in, Float4Stream& out)
+	{
+		const float matrix[16]
+		{
+			m.getRow(0).getX(), m.getRow(0).getY(), m.getRow(0).getZ(), m.getRow(0).getW(),
+			m.getRow(1).getX(), m.getRow(1).getY(), m.getRow(1).getZ(), m.getRow(1).getW(),
+			m.getRow(2).getX(), m.getRow(2).getY(), m.getRow(2).getZ(), m.getRow(2).getW(),
+			m.getRow(3).getX(), m.getRow(3).getY(), m.getRow(3).getZ(), m.getRow(3).getW(),
+		};
+		out.resize(in.size());
+		getFloat4StreamKernels().transform(matrix, getPointers(in), getPointers(out), in.size());
+	}
+}
@@ -0,0 +1,81 @@
+﻿#pragma once
+
+
+#ifndef FS_FLOAT4_STREAM_H
+#define FS_FLOAT4_STREAM_H
+// === HEADER BEGINS ===
+
+
+#include <Core/Float4x4.h>
+#include <Core/AlignedAllocator.h>
+
+
+namespace fs
+{
+	// Structure of arrays: x, y, z and w are stored in separate arrays, so bulk operations use every SIMD lane.
+	// (Float4 is one vector per register and wastes lanes on w or on horizontal adds.)
+	// The static functions process 4 (SSE), 8 (AVX2 + FMA) or 16 (AVX-512) vectors at a time, chosen at runtime.
+	class Float4Stream final
+	{
+	public:
+		// one cache line, one AVX-512 register
+		static constexpr size_t	kAlignment{ 64 };
+		using FloatArray		= std::vector<float, AlignedAllocator<float, kAlignment>>;
+
+	public:
+		Float4Stream();
+		explicit Float4Stream(size_t count);
+		explicit Float4Stream(const std::vector<Float4>& vVectors);
+		~Float4Stream();
+
+	public:
+		void					resize(size_t count);
+		void					clear() noexcept;
+
+		// AoS -> SoA
+		void					assign(const Float4* vectors, size_t count);
+		void					assign(const std::vector<Float4>& vVectors);
+
+		// SoA -> AoS. out must have room for size() vectors.
+		void					copyTo(Float4* out) const noexcept;
+		std::vector<Float4>		toVector() const;
+
+	public:
+		void					set(size_t index, const Float4& v) noexcept;
+		Float4					get(size_t index) const noexcept;
+		size_t					size() const noexcept;
+
+		float*					getX() noexcept;
+		float*					getY() noexcept;
+		float*					getZ() noexcept;
+		float*					getW() noexcept;
+		const float*			getX() const noexcept;
+		const float*			getY() const noexcept;
+		const float*			getZ() const noexcept;
+		const float*			getW() const noexcept;
+
+	private:
+		FloatArray				_x{};
+		FloatArray				_y{};
+		FloatArray				_z{};
+		FloatArray				_w{};
+
+	// static functions
+	// a and b must have the same size. out is resized to the size of the input.
+	public:
+		// out[i] = Float4::dot(a[i], b[i]). out must have room for a.size() floats.
+		static void				dot(const Float4Stream& a, const Float4Stream& b, float* out) noexcept;
+		// out[i] = Float4::cross(a[i], b[i]) (w == 0)
+		static void				cross(const Float4Stream& a, const Float4Stream& b, Float4Stream& out);
+		// out[i] = Float4::length(a[i]). out must have room for a.size() floats.
+		static void				length(const Float4Stream& a, float* out) noexcept;
+		// out[i] = Float4::normalize(a[i]) (in == out is allowed)
+		static void				normalize(const Float4Stream& a, Float4Stream& out);
+		// out[i] = m * in[i] (in == out is allowed)
+		static void				transform(const Float4x4& m, const Float4Stream& in, Float4Stream& out);
+	};
+}
+
+
+// === HEADER ENDS ===
+#endif // !FS_FLOAT4_STREAM_H
@@ -0,0 +1,94 @@
+﻿#include "pch.h"
+#include "Float4x4.h"
+#include <Core/BatchKernels.h>
+
+
+namespace fs
+{
+	// mulBatch() reads and writes Float4 arrays as raw floats.
+	static_assert(sizeof(Float4) == sizeof(float) * 4, "Float4 must be tightly packed.");
+
+	// matrix is row-major. Sums in the same order as Float4x4::mul(), so without FMA the results are equal.
+	static void mulBatchScalar(const float* matrix, const float* in, float* out, size_t count) noexcept
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			const float x{ in[i * 4 + 0] };
+			const float y{ in[i * 4 + 1] };
+			const float z{ in[i * 4 + 2] };
+			const float w{ in[i * 4 + 3] };
+			for (size_t row = 0; row < 4; ++row)
+			{
+				const float* const m{ matrix + row * 4 };
+				out[i * 4 + row] = m[0] * x + m[1] * y + m[2] * z + m[3] * w;
+			}
+		}
+	}
+
+	// 4 vertices at a time: AoS -> SoA, 16 mul + 12 add, SoA -> AoS
+	static void mulBatchSse2(const float* matrix, const float* in, float* out, size_t count) noexcept
+	{
+		__m128 m[16];
+		for (size_t i = 0; i < 16; ++i)
+		{
+			m[i] = _mm_set1_ps(matrix[i]);
+		}
+
+		size_t i{};
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 x, y, z, w;
+			loadTransposed4(in + i * 4, x, y, z, w);
+
+			__m128 outRow[4];
+			for (size_t row = 0; row < 4; ++row)
+			{
+				outRow[row] = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+					_mm_mul_ps(m[row * 4 + 0], x), _mm_mul_ps(m[row * 4 + 1], y)),
+					_mm_mul_ps(m[row * 4 + 2], z)), _mm_mul_ps(m[row * 4 + 3], w));
+			}
+
+			storeTransposed4(out + i * 4, outRow[0], outRow[1], outRow[2], outRow[3]);
+		}
+		mulBatchScalar(matrix, in + i * 4, out + i * 4, count - i);
+	}
+
+	// 8 vertices at a time with FMA
+	FS_TARGET_AVX2 static void mulBatchAvx2(const float* matrix, const float* in, float* out, size_t count) noexcept
+	{
+		__m256 m[16];
+		for (size_t i = 0; i < 16; ++i)
+		{
+			m[i] = _mm256_set1_ps(matrix[i]);
+		}
+
+		size_t i{};
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 x, y, z, w;
+			loadTransposed8(in + i * 4, x, y, z, w);
+
+			__m256 outRow[4];
+			for (size_t row = 0; row < 4; ++row)
+			{
+				outRow[row] = _mm256_fmadd_ps(m[row * 4 + 3], w, _mm256_fmadd_ps(m[row * 4 + 2], z,
+					_mm256_fmadd_ps(m[row * 4 + 1], y, _mm256_mul_ps(m[row * 4 + 0], x))));
+			}
+
+			storeTransposed8(out + i * 4, outRow[0], outRow[1], outRow[2], outRow[3]);
+		}
+		mulBatchSse2(matrix, in + i * 4, out + i * 4, count - i);
+	}
+
+	void Float4x4::mulBatch(const Float4x4& m, const Float4* in, Float4* out, size_t count) noexcept
+	{
+		const float matrix[16]
+		{
+			m._row[0].getX(), m._row[0].getY(), m._row[0].getZ(), m._row[0].getW(),
+			m._row[1].getX(), m._row[1].getY(), m._row[1].getZ(), m._row[1].getW(),
+			m._row[2].getX(), m._row[2].getY(), m._row[2].getZ(), m._row[2].getW(),
+			m._row[3].getX(), m._row[3].getY(), m._row[3].getZ(), m._row[3].getW(),
+		};
+		getBatchKernel<mulBatchSse2, mulBatchAvx2>()(matrix, reinterpret_cast<const float*>(in), reinterpret_cast<float*>(out), count);
+	}
+}
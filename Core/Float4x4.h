@@ -0,0 +1,586 @@
+﻿#pragma once
+
+
+#ifndef FS_FLOAT4X4_H
+#define FS_FLOAT4X4_H
+// === HEADER BEGINS ===
+
+
+#include <Core/Float4.h>
+#include <Core/Matrix.h>
+
+
+namespace fs
+{
+	// SSE (members are Float4)
+	// right-handed 4x4 matrix
+	// header-only and trivially copyable (except mulBatch())
+	class alignas(16) Float4x4
+	{
+	public:
+		// constexpr, like the factory functions below except rotationMatrixAxisAngle()
+		explicit constexpr		Float4x4();
+		constexpr				Float4x4(float m00, float m01, float m02, float m03,
+										float m10, float m11, float m12, float m13,
+										float m20, float m21, float m22, float m23,
+										float m30, float m31, float m32, float m33);
+		constexpr				Float4x4(const Float4& row0, const Float4& row1, const Float4& row2, const Float4& row3);
+		// from the generic matrix (see Matrix.h)
+		explicit constexpr		Float4x4(const Matrix<float, 4, 4>& m);
+								Float4x4(const Float4x4& b)				= default;
+								Float4x4(Float4x4&& b) noexcept			= default;
+								~Float4x4()								= default;
+
+	public:
+		Float4x4&				operator=(const Float4x4& b)			= default;
+		Float4x4&				operator=(Float4x4&& b) noexcept		= default;
+
+	public:
+		Float4x4				operator+(const Float4x4& b) const;
+		Float4x4				operator-(const Float4x4& b) const;
+
+		// scalar
+		Float4x4				operator*(float s) const;
+		// scalar
+		Float4x4				operator/(float s) const;
+
+		// matrix(l) * matrix(r)
+		Float4x4				operator*(const Float4x4& r) const;
+		// matrix * vector
+		Float4					operator*(const Float4& v) const;
+
+	public:
+		void					set(float m00, float m01, float m02, float m03,
+									float m10, float m11, float m12, float m13,
+									float m20, float m21, float m22, float m23,
+									float m30, float m31, float m32, float m33);
+		void					set(const Float4& row0, const Float4& row1, const Float4& row2, const Float4& row3);
+		void					setZero();
+		void					setIdentity();
+
+		const Float4&			getRow(uint32 rowIndex) const noexcept;
+
+		// to the generic matrix (see Matrix.h), which has the closed-form determinant/minor/cofactor used below
+		Matrix<float, 4, 4>		getElements() const noexcept;
+
+	public:
+		Float3x3				minor(uint32 rowIndex, uint32 columnIndex) const noexcept;
+		float					determinant() const noexcept;
+		Float4x4				transpose() const noexcept;
+		Float4x4				cofactor() const noexcept;
+		Float4x4				adjugate() const noexcept;
+		// SSE, 2x2 block method (no minor())
+		Float4x4				inverse() const noexcept;
+		// Only for affine matrices (last row is 0, 0, 0, 1), e.g. world or camera matrices with rotation, scaling and translation.
+		// Inverts the 3x3 part with cross products and applies it to the translation.
+		Float4x4				inverseAffine() const noexcept;
+
+	public:
+		Float4					mul(const Float4& v) const noexcept;
+		Float4x4				mul(const Float4x4& m) const noexcept;
+
+	private:
+		// for inverse(): 2x2 matrices packed in one register as (m00, m01, m10, m11)
+		// a * b
+		static __m128			mul2x2(const __m128& a, const __m128& b) noexcept;
+		// adjugate(a) * b
+		static __m128			adjugateMul2x2(const __m128& a, const __m128& b) noexcept;
+		// a * adjugate(b)
+		static __m128			mulAdjugate2x2(const __m128& a, const __m128& b) noexcept;
+
+	private:
+		Float4					_row[4];
+
+
+	// static functions
+	public:
+		static Float4			mul(const Float4x4& m, const Float4& v) noexcept;
+		static Float4x4			mul(const Float4x4& l, const Float4x4& r) noexcept;
+
+		// out[i] = m * in[i] for i in [0, count). (in == out is allowed)
+		// Vertices are transposed into SoA blocks of 4 (SSE) or 8 (AVX2 + FMA, chosen at runtime),
+		// so it is much faster than calling mul() for each vertex.
+		static void				mulBatch(const Float4x4& m, const Float4* in, Float4* out, size_t count) noexcept;
+
+		static constexpr Float4x4	translationMatrix(float x, float y, float z) noexcept;
+		static constexpr Float4x4	scalingMatrix(float x, float y, float z) noexcept;
+		// Precision: fastmath::Precise (libm) or fastmath::Fast (polynomials, see FastMath.h for the error bounds)
+		template <typename Precision = fastmath::Precise>
+		static constexpr Float4x4	rotationMatrixX(float angle) noexcept;
+		template <typename Precision = fastmath::Precise>
+		static constexpr Float4x4	rotationMatrixY(float angle) noexcept;
+		template <typename Precision = fastmath::Precise>
+		static constexpr Float4x4	rotationMatrixZ(float angle) noexcept;
+		template <typename Precision = fastmath::Precise>
+		static Float4x4			rotationMatrixAxisAngle(const Float4& axis, float angle) noexcept;
+		template <typename Precision = fastmath::Precise>
+		static constexpr Float4x4	projectionMatrixPerspective(float Fov, float nearZ, float farZ, float ratio) noexcept;
+	};
+
+	// alias
+	using float4x4 = Float4x4;
+
+	static_assert(std::is_trivially_copyable<Float4x4>::value, "Float4x4 must be trivially copyable.");
+
+
+	constexpr Float4x4::Float4x4() : Float4x4
+		(
+			1, 0, 0, 0,
+			0, 1, 0, 0,
+			0, 0, 1, 0,
+			0, 0, 0, 1
+		)
+	{
+		__noop;
+	}
+
+	constexpr Float4x4::Float4x4(float m00, float m01, float m02, float m03,
+		float m10, float m11, float m12, float m13, 
+		float m20, float m21, float m22, float m23,
+		float m30, float m31, float m32, float m33) : 
+		_row{ 
+				Float4( m00, m01, m02, m03 ),
+				Float4( m10, m11, m12, m13 ), 
+				Float4( m20, m21, m22, m23 ), 
+				Float4( m30 ,m31, m32, m33 ) 
+			}
+	{
+		__noop;
+	}
+
+	constexpr Float4x4::Float4x4(const Matrix<float, 4, 4>& m) : Float4x4
+		(
+			m.m[0][0], m.m[0][1], m.m[0][2], m.m[0][3],
+			m.m[1][0], m.m[1][1], m.m[1][2], m.m[1][3],
+			m.m[2][0], m.m[2][1], m.m[2][2], m.m[2][3],
+			m.m[3][0], m.m[3][1], m.m[3][2], m.m[3][3]
+		)
+	{
+		__noop;
+	}
+
+	constexpr Float4x4::Float4x4(const Float4& row0, const Float4& row1, const Float4& row2, const Float4& row3)
+		: _row{ row0, row1, row2, row3 }
+	{
+		__noop;
+	}
+
+	inline Float4x4 Float4x4::operator+(const Float4x4& b) const
+	{
+		return Float4x4(_row[0] + b._row[0], _row[1] + b._row[1], _row[2] + b._row[2], _row[3] + b._row[3]);
+	}
+
+	inline Float4x4 Float4x4::operator-(const Float4x4& b) const
+	{
+		return Float4x4(_row[0] - b._row[0], _row[1] - b._row[1], _row[2] - b._row[2], _row[3] - b._row[3]);
+	}
+
+	inline Float4x4 Float4x4::operator*(float s) const
+	{
+		return Float4x4(_row[0] * s, _row[1] * s, _row[2] * s, _row[3] * s);
+	}
+
+	inline Float4x4 Float4x4::operator/(float s) const
+	{
+		return Float4x4(_row[0] / s, _row[1] / s, _row[2] / s, _row[3] / s);
+	}
+
+	inline Float4x4 Float4x4::operator*(const Float4x4& r) const
+	{
+		return this->mul(r);
+	}
+
+	inline Float4 Float4x4::operator*(const Float4& v) const
+	{
+		return this->mul(v);
+	}
+
+	inline void Float4x4::set(float m00, float m01, float m02, float m03, 
+		float m10, float m11, float m12, float m13,
+		float m20, float m21, float m22, float m23, 
+		float m30, float m31, float m32, float m33)
+	{
+		_row[0].set(m00, m01, m02, m03);
+		_row[1].set(m10, m11, m12, m13);
+		_row[2].set(m20, m21, m22, m23);
+		_row[3].set(m30, m31, m32, m33);
+	}
+
+	inline void Float4x4::set(const Float4& row0, const Float4& row1, const Float4& row2, const Float4& row3)
+	{
+		_row[0] = row0;
+		_row[1] = row1;
+		_row[2] = row2;
+		_row[3] = row3;
+	}
+
+	inline void Float4x4::setZero()
+	{
+		_row[0].set(0, 0, 0, 0);
+		_row[1].set(0, 0, 0, 0);
+		_row[2].set(0, 0, 0, 0);
+		_row[3].set(0, 0, 0, 0);
+	}
+
+	inline void Float4x4::setIdentity()
+	{
+		_row[0].set(1, 0, 0, 0);
+		_row[1].set(0, 1, 0, 0);
+		_row[2].set(0, 0, 1, 0);
+		_row[3].set(0, 0, 0, 1);
+	}
+
+	inline const Float4& Float4x4::getRow(uint32 rowIndex) const noexcept
+	{
+		return _row[rowIndex];
+	}
+
+	inline Matrix<float, 4, 4> Float4x4::getElements() const noexcept
+	{
+		Matrix<float, 4, 4> result;
+		for (uint32 row = 0; row < 4; ++row)
+		{
+			_mm_storeu_ps(result.m[row], _row[row]._data);
+		}
+		return result;
+	}
+
+	inline Float3x3 Float4x4::minor(uint32 rowIndex, uint32 columnIndex) const noexcept
+	{
+		return getElements().minor(rowIndex, columnIndex);
+	}
+
+	inline float Float4x4::determinant() const noexcept
+	{
+		return getElements().determinant();
+	}
+
+	inline Float4x4 Float4x4::transpose() const noexcept
+	{
+		return Float4x4
+		(
+			_row[0].get(0), _row[1].get(0), _row[2].get(0), _row[3].get(0),
+			_row[0].get(1), _row[1].get(1), _row[2].get(1), _row[3].get(1),
+			_row[0].get(2), _row[1].get(2), _row[2].get(2), _row[3].get(2),
+			_row[0].get(3), _row[1].get(3), _row[2].get(3), _row[3].get(3)
+		);
+	}
+
+	inline Float4x4 Float4x4::cofactor() const noexcept
+	{
+		return Float4x4(getElements().cofactor());
+	}
+
+	inline Float4x4 Float4x4::adjugate() const noexcept
+	{
+		return cofactor().transpose();
+	}
+
+	inline __m128 Float4x4::mul2x2(const __m128& a, const __m128& b) noexcept
+	{
+		return _mm_add_ps(
+			_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+			_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+	}
+
+	inline __m128 Float4x4::adjugateMul2x2(const __m128& a, const __m128& b) noexcept
+	{
+		return _mm_sub_ps(
+			_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+			_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+	}
+
+	inline __m128 Float4x4::mulAdjugate2x2(const __m128& a, const __m128& b) noexcept
+	{
+		return _mm_sub_ps(
+			_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+			_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+	}
+
+	inline Float4x4 Float4x4::inverse() const noexcept
+	{
+		// M = | A B |    inverse(M) = 1/|M| * | X# Y# |#   (# is the adjugate)
+		//     | C D |                         | Z# W# |
+		const __m128 row0{ _row[0]._data };
+		const __m128 row1{ _row[1]._data };
+		const __m128 row2{ _row[2]._data };
+		const __m128 row3{ _row[3]._data };
+		const __m128 a{ _mm_movelh_ps(row0, row1) };
+		const __m128 b{ _mm_movehl_ps(row1, row0) };
+		const __m128 c{ _mm_movelh_ps(row2, row3) };
+		const __m128 d{ _mm_movehl_ps(row3, row2) };
+
+		// (|A|, |B|, |C|, |D|)
+		const __m128 subDeterminants{ _mm_sub_ps(
+			_mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(3, 1, 3, 1))),
+			_mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(2, 0, 2, 0)))) };
+		const __m128 detA{ _mm_shuffle_ps(subDeterminants, subDeterminants, _MM_SHUFFLE(0, 0, 0, 0)) };
+		const __m128 detB{ _mm_shuffle_ps(subDeterminants, subDeterminants, _MM_SHUFFLE(1, 1, 1, 1)) };
+		const __m128 detC{ _mm_shuffle_ps(subDeterminants, subDeterminants, _MM_SHUFFLE(2, 2, 2, 2)) };
+		const __m128 detD{ _mm_shuffle_ps(subDeterminants, subDeterminants, _MM_SHUFFLE(3, 3, 3, 3)) };
+
+		const __m128 adjDC{ adjugateMul2x2(d, c) };
+		const __m128 adjAB{ adjugateMul2x2(a, b) };
+
+		// X# = |D|A - B(D#C)
+		__m128 x{ _mm_sub_ps(_mm_mul_ps(detD, a), mul2x2(b, adjDC)) };
+		// W# = |A|D - C(A#B)
+		__m128 w{ _mm_sub_ps(_mm_mul_ps(detA, d), mul2x2(c, adjAB)) };
+		// Y# = |B|C - D(A#B)#
+		__m128 y{ _mm_sub_ps(_mm_mul_ps(detB, c), mulAdjugate2x2(d, adjAB)) };
+		// Z# = |C|B - A(D#C)#
+		__m128 z{ _mm_sub_ps(_mm_mul_ps(detC, b), mulAdjugate2x2(a, adjDC)) };
+
+		// |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+		__m128 trace{ _mm_mul_ps(adjAB, _mm_shuffle_ps(adjDC, adjDC, _MM_SHUFFLE(3, 1, 2, 0))) };
+		trace = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(2, 3, 0, 1)));
+		trace = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(1, 0, 3, 2)));
+		const __m128 determinant{ _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace) };
+
+		// (1/|M|, -1/|M|, -1/|M|, 1/|M|) also flips the signs for the adjugate
+		const __m128 reciprocalDeterminant{ _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), determinant) };
+		x = _mm_mul_ps(x, reciprocalDeterminant);
+		y = _mm_mul_ps(y, reciprocalDeterminant);
+		z = _mm_mul_ps(z, reciprocalDeterminant);
+		w = _mm_mul_ps(w, reciprocalDeterminant);
+
+		// the remaining adjugate swaps are folded into the shuffles
+		return Float4x4(
+			Float4(_mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3))),
+			Float4(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2))),
+			Float4(_mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3))),
+			Float4(_mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2))));
+	}
+
+	inline Float4x4 Float4x4::inverseAffine() const noexcept
+	{
+		// rows of the 3x3 part (w == 0)
+		const __m128 mask{ _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0)) };
+		const Float4 r0{ _mm_and_ps(_row[0]._data, mask) };
+		const Float4 r1{ _mm_and_ps(_row[1]._data, mask) };
+		const Float4 r2{ _mm_and_ps(_row[2]._data, mask) };
+
+		// inverse(R) == | c0 c1 c2 | / |R| (as columns)
+		const Float4 c0{ Float4::cross(r1, r2) };
+		const Float4 c1{ Float4::cross(r2, r0) };
+		const Float4 c2{ Float4::cross(r0, r1) };
+		const Float4 reciprocalDeterminant{ Float4(_mm_set1_ps(1.0f)) / Float4::dotSplat(r0, c0) };
+		__m128 column0{ (c0 * reciprocalDeterminant)._data };
+		__m128 column1{ (c1 * reciprocalDeterminant)._data };
+		__m128 column2{ (c2 * reciprocalDeterminant)._data };
+
+		// -inverse(R) * t
+		const Float4 t
+		{
+			Float4::multiplyAdd(Float4(column2), _row[2].splatW(),
+			Float4::multiplyAdd(Float4(column1), _row[1].splatW(),
+			Float4(column0) * _row[0].splatW()))
+		};
+		__m128 translation{ _mm_sub_ps(_mm_setzero_ps(), t._data) };
+
+		_MM_TRANSPOSE4_PS(column0, column1, column2, translation);
+		return Float4x4(Float4(column0), Float4(column1), Float4(column2), Float4(0, 0, 0, 1));
+	}
+
+	inline Float4 Float4x4::mul(const Float4& v) const noexcept
+	{
+		return Float4x4::mul(*this, v);
+	}
+
+	inline Float4x4 Float4x4::mul(const Float4x4& m) const noexcept
+	{
+		return Float4x4::mul(*this, m);
+	}
+
+	inline Float4 Float4x4::mul(const Float4x4& m, const Float4& v) noexcept
+	{
+		// m * v == column0 * x + column1 * y + column2 * z + column3 * w
+		__m128 column0{ m._row[0]._data };
+		__m128 column1{ m._row[1]._data };
+		__m128 column2{ m._row[2]._data };
+		__m128 column3{ m._row[3]._data };
+		_MM_TRANSPOSE4_PS(column0, column1, column2, column3);
+
+		Float4 result{ Float4(column0) * v.splatX() };
+		result = Float4::multiplyAdd(Float4(column1), v.splatY(), result);
+		result = Float4::multiplyAdd(Float4(column2), v.splatZ(), result);
+		result = Float4::multiplyAdd(Float4(column3), v.splatW(), result);
+		return result;
+	}
+
+	inline Float4x4 Float4x4::mul(const Float4x4& l, const Float4x4& r) noexcept
+	{
+		// row i of (l * r) == l[i][0] * r.row0 + l[i][1] * r.row1 + l[i][2] * r.row2 + l[i][3] * r.row3
+		Float4x4 result{ l };
+		for (uint32 i = 0; i < 4; ++i)
+		{
+			const Float4& lRow{ l._row[i] };
+			Float4 row{ lRow.splatX() * r._row[0] };
+			row = Float4::multiplyAdd(lRow.splatY(), r._row[1], row);
+			row = Float4::multiplyAdd(lRow.splatZ(), r._row[2], row);
+			row = Float4::multiplyAdd(lRow.splatW(), r._row[3], row);
+			result._row[i] = row;
+		}
+		return result;
+	}
+
+	constexpr Float4x4 Float4x4::translationMatrix(float x, float y, float z) noexcept
+	{
+		return Float4x4
+		(
+			1, 0, 0, x,
+			0, 1, 0, y,
+			0, 0, 1, z,
+			0, 0, 0, 1
+		);
+	}
+
+	constexpr Float4x4 Float4x4::scalingMatrix(float x, float y, float z) noexcept
+	{
+		return Float4x4
+		(
+			x, 0, 0, 0,
+			0, y, 0, 0,
+			0, 0, z, 0,
+			0, 0, 0, 1
+		);
+	}
+	
+	template <typename Precision>
+	constexpr Float4x4 Float4x4::rotationMatrixX(float angle) noexcept
+	{
+		float s{};
+		float c{};
+		Precision::sinCos(angle, s, c);
+		return Float4x4
+		(
+			1	, 0		, 0		, 0,
+			0	, +c	, -s	, 0,
+			0	, +s	, +c	, 0,
+			0	, 0		, 0		, 1
+		);
+	}
+
+	template <typename Precision>
+	constexpr Float4x4 Float4x4::rotationMatrixY(float angle) noexcept
+	{
+		float s{};
+		float c{};
+		Precision::sinCos(angle, s, c);
+		return Float4x4
+		(
+			+c	, 0	, +s	, 0,
+			0	, 1	, 0		, 0,
+			-s	, 0	, +c	, 0,
+			0	, 0	, 0		, 1
+		);
+	}
+
+	template <typename Precision>
+	constexpr Float4x4 Float4x4::rotationMatrixZ(float angle) noexcept
+	{
+		float s{};
+		float c{};
+		Precision::sinCos(angle, s, c);
+		return Float4x4
+		(
+			+c	, -s	, 0	, 0,
+			+s	, +c	, 0	, 0,
+			0	, 0		, 1	, 0,
+			0	, 0		, 0	, 1
+		);
+	}
+	template <typename Precision>
+	inline Float4x4 Float4x4::rotationMatrixAxisAngle(const Float4& axis, float angle) noexcept
+	{
+		// Rodrigues' rotation formula
+		// (v * r)r(1 - cosθ) + vcosθ + (r X v)sinθ
+
+		const Float4 r = Float4::normalize<Precision>(Float4(axis.getX(), axis.getY(), axis.getZ(), 0));
+		float c;
+		float s;
+		Precision::sinCos(angle, s, c);
+
+		const float rx = r.getX();
+		const float ry = r.getY();
+		const float rz = r.getZ();
+		Float4x4 result
+		(
+			(1 - c) * rx * rx  + c            , (1 - c) * ry * rx       - (rz * s), (1 - c) * rz * rx       + (ry * s), 0,
+			(1 - c) * rx * ry       + (rz * s), (1 - c) * ry * ry  + c            , (1 - c) * rz * ry       - (rx * s), 0,
+			(1 - c) * rx * rz       - (ry * s), (1 - c) * ry * rz       + (rx * s), (1 - c) * rz * rz  + c            , 0,
+			0                                 , 0                                 , 0                                 , 1
+		);
+		return result;
+	}
+	template <typename Precision>
+	constexpr Float4x4 Float4x4::projectionMatrixPerspective(float Fov, float nearZ, float farZ, float ratio) noexcept
+	{
+		const float tanFov = Precision::tan(Fov);
+		float a = 1.0f / (tanFov * ratio);
+		float b = 1.0f / (tanFov);
+		// z' / w' == 0 at -nearZ, 1 at -farZ
+		float c = (-farZ) / (farZ - nearZ);
+		float d = -(nearZ * farZ) / (farZ - nearZ);
+		float e = -1.0f;
+
+		return Float4x4
+		(
+			a, 0, 0, 0,
+			0, b, 0, 0,
+			0, 0, c, d,
+			0, 0, e, 0
+		);
+	}
+
+
+	// Quaternion functions that need Float4x4
+	inline Float4x4 Quaternion::toMatrix() const noexcept
+	{
+		const float a = getA();
+		const float b = getB();
+		const float c = getC();
+		const float d = getD();
+		return Float4x4
+		(
+			1 - 2 * (c * c + d * d),     2 * (b * c - a * d),     2 * (b * d + a * c), 0,
+			    2 * (b * c + a * d), 1 - 2 * (b * b + d * d),     2 * (c * d - a * b), 0,
+			    2 * (b * d - a * c),     2 * (c * d + a * b), 1 - 2 * (b * b + c * c), 0,
+			0                      , 0                      , 0                      , 1
+		);
+	}
+
+	inline Quaternion Quaternion::fromMatrix(const Float4x4& m) noexcept
+	{
+		const Float4& row0 = m.getRow(0);
+		const Float4& row1 = m.getRow(1);
+		const Float4& row2 = m.getRow(2);
+		const float m00 = row0.getX(), m01 = row0.getY(), m02 = row0.getZ();
+		const float m10 = row1.getX(), m11 = row1.getY(), m12 = row1.getZ();
+		const float m20 = row2.getX(), m21 = row2.getY(), m22 = row2.getZ();
+
+		// Divide by the largest of 4a^2, 4b^2, 4c^2, 4d^2 so the square root never gets close to 0.
+		const float trace = m00 + m11 + m22;
+		if (trace > 0.0f)
+		{
+			const float s = sqrtf(trace + 1.0f) * 2.0f; // 4a
+			return Quaternion(0.25f * s, (m21 - m12) / s, (m02 - m20) / s, (m10 - m01) / s);
+		}
+		if (m00 > m11 && m00 > m22)
+		{
+			const float s = sqrtf(1.0f + m00 - m11 - m22) * 2.0f; // 4b
+			return Quaternion((m21 - m12) / s, 0.25f * s, (m01 + m10) / s, (m02 + m20) / s);
+		}
+		if (m11 > m22)
+		{
+			const float s = sqrtf(1.0f + m11 - m00 - m22) * 2.0f; // 4c
+			return Quaternion((m02 - m20) / s, (m01 + m10) / s, 0.25f * s, (m12 + m21) / s);
+		}
+		const float s = sqrtf(1.0f + m22 - m00 - m11) * 2.0f; // 4d
+		return Quaternion((m10 - m01) / s, (m02 + m20) / s, (m12 + m21) / s, 0.25f * s);
+	}
+}
+
+
+// === HEADER ENDS ===
+#endif // !FS_FLOAT4X4_H
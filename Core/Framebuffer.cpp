@@ -0,0 +1,604 @@
+﻿#include "Framebuffer.h"
+#include <Core/CpuFeatures.h>
+
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+#include <emmintrin.h>
+#include <immintrin.h>
+
+
+namespace fs
+{
+	// (t / 255)를 반올림한 값과 같다. (t <= 255 * 255)
+	static inline uint32 div255(uint32 t) noexcept
+	{
+		t += 128;
+		return (t + (t >> 8)) >> 8;
+	}
+
+	// src * alpha + dst * (255 - alpha) 를 채널별로 계산한다.
+	static inline uint32 blendPixel(uint32 src, uint32 dst, uint32 alpha) noexcept
+	{
+		const uint32 invAlpha{ 255 - alpha };
+		uint32 result{};
+		for (uint32 shift = 0; shift < 32; shift += 8)
+		{
+			const uint32 s{ (src >> shift) & 0xFF };
+			const uint32 d{ (dst >> shift) & 0xFF };
+			result |= div255(s * alpha + d * invAlpha) << shift;
+		}
+		return result;
+	}
+
+	// src + dst * (255 - srcAlpha) 를 채널별로 계산한다. (src는 premultiplied)
+	static inline uint32 blendPixelPremultiplied(uint32 src, uint32 dst) noexcept
+	{
+		const uint32 invAlpha{ 255 - (src >> 24) };
+		uint32 result{};
+		for (uint32 shift = 0; shift < 32; shift += 8)
+		{
+			const uint32 s{ (src >> shift) & 0xFF };
+			const uint32 d{ (dst >> shift) & 0xFF };
+			const uint32 c{ s + div255(d * invAlpha) };
+			result |= ((c > 255) ? 255 : c) << shift;
+		}
+		return result;
+	}
+
+
+	// span: 한 행(row) 안의 연속된 픽셀들
+
+	static void fillSpanSse2(uint32* dst, size_t count, uint32 color) noexcept
+	{
+		const __m128i color4{ _mm_set1_epi32(static_cast<int>(color)) };
+		size_t i{};
+		for (; i + 4 <= count; i += 4)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), color4);
+		}
+		for (; i < count; ++i)
+		{
+			dst[i] = color;
+		}
+	}
+
+	FS_TARGET_AVX2 static void fillSpanAvx2(uint32* dst, size_t count, uint32 color) noexcept
+	{
+		const __m256i color8{ _mm256_set1_epi32(static_cast<int>(color)) };
+		size_t i{};
+		for (; i + 8 <= count; i += 8)
+		{
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), color8);
+		}
+		for (; i < count; ++i)
+		{
+			dst[i] = color;
+		}
+	}
+
+	// blendPixel()과 비트 단위로 같은 결과를 낸다.
+	// 16비트 lane에서 (color * alpha + 128) + dst * (255 - alpha) 를 계산하고 div255()와 같은 방법으로 나눈다.
+	static void blendSpanSse2(uint32* dst, size_t count, uint32 color, uint32 alpha) noexcept
+	{
+		const __m128i zero{ _mm_setzero_si128() };
+		const __m128i color16{ _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(color)), zero) };
+		const __m128i srcTerm{ _mm_add_epi16(_mm_mullo_epi16(color16, _mm_set1_epi16(static_cast<short>(alpha))), _mm_set1_epi16(128)) };
+		const __m128i invAlpha{ _mm_set1_epi16(static_cast<short>(255 - alpha)) };
+		size_t i{};
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128i d{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i)) };
+			__m128i lo{ _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), invAlpha), srcTerm) };
+			__m128i hi{ _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), invAlpha), srcTerm) };
+			lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+			hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+		}
+		for (; i < count; ++i)
+		{
+			dst[i] = blendPixel(color, dst[i], alpha);
+		}
+	}
+
+	FS_TARGET_AVX2 static void blendSpanAvx2(uint32* dst, size_t count, uint32 color, uint32 alpha) noexcept
+	{
+		const __m256i zero{ _mm256_setzero_si256() };
+		const __m256i color16{ _mm256_unpacklo_epi8(_mm256_set1_epi32(static_cast<int>(color)), zero) };
+		const __m256i srcTerm{ _mm256_add_epi16(_mm256_mullo_epi16(color16, _mm256_set1_epi16(static_cast<short>(alpha))), _mm256_set1_epi16(128)) };
+		const __m256i invAlpha{ _mm256_set1_epi16(static_cast<short>(255 - alpha)) };
+		size_t i{};
+		for (; i + 8 <= count; i += 8)
+		{
+			// unpack/pack 모두 128비트 lane 단위로 동작하므로 픽셀 순서는 그대로 유지된다.
+			const __m256i d{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i)) };
+			__m256i lo{ _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), invAlpha), srcTerm) };
+			__m256i hi{ _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), invAlpha), srcTerm) };
+			lo = _mm256_srli_epi16(_mm256_add_epi16(lo, _mm256_srli_epi16(lo, 8)), 8);
+			hi = _mm256_srli_epi16(_mm256_add_epi16(hi, _mm256_srli_epi16(hi, 8)), 8);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_packus_epi16(lo, hi));
+		}
+		for (; i < count; ++i)
+		{
+			dst[i] = blendPixel(color, dst[i], alpha);
+		}
+	}
+
+	struct SpanKernels
+	{
+		void (*fillSpan)(uint32* dst, size_t count, uint32 color) noexcept;
+		void (*blendSpan)(uint32* dst, size_t count, uint32 color, uint32 alpha) noexcept;
+	};
+
+	// CPU가 지원하는 가장 빠른 kernel을 한 번만 고른다.
+	static const SpanKernels& getSpanKernels() noexcept
+	{
+		static const SpanKernels kSpanKernels
+		{
+			(getSimdLevel() >= ESimdLevel::AVX2) ? SpanKernels{ fillSpanAvx2, blendSpanAvx2 } : SpanKernels{ fillSpanSse2, blendSpanSse2 }
+		};
+		return kSpanKernels;
+	}
+
+
+	Framebuffer::Framebuffer()
+	{
+		__noop;
+	}
+
+	Framebuffer::Framebuffer(uint32 width, uint32 height)
+	{
+		resize(width, height);
+	}
+
+	Framebuffer::Framebuffer(uint32* pixels, uint32 width, uint32 height, uint32 stride)
+		: _width{ width }, _height{ height }, _stride{ stride }, _pixels{ pixels }
+	{
+		assert(stride >= width);
+		resetClipRectangle();
+	}
+
+	Framebuffer::Framebuffer(const Framebuffer& b)
+	{
+		*this = b;
+	}
+
+	Framebuffer::Framebuffer(Framebuffer&& b) noexcept
+	{
+		*this = std::move(b);
+	}
+
+	Framebuffer::~Framebuffer()
+	{
+		__noop;
+	}
+
+	Framebuffer& Framebuffer::operator=(const Framebuffer& b)
+	{
+		if (this == &b) return *this;
+
+		_width = b._width;
+		_height = b._height;
+		_stride = b._stride;
+		_clipLeft = b._clipLeft;
+		_clipTop = b._clipTop;
+		_clipRight = b._clipRight;
+		_clipBottom = b._clipBottom;
+
+		// view는 같은 메모리를 가리키고, 소유한 메모리는 복사한다.
+		_storage = b._storage;
+		_pixels = (_storage.empty() == true) ? b._pixels : _storage.data();
+		return *this;
+	}
+
+	Framebuffer& Framebuffer::operator=(Framebuffer&& b) noexcept
+	{
+		if (this == &b) return *this;
+
+		_width = b._width;
+		_height = b._height;
+		_stride = b._stride;
+		_clipLeft = b._clipLeft;
+		_clipTop = b._clipTop;
+		_clipRight = b._clipRight;
+		_clipBottom = b._clipBottom;
+
+		// std::vector의 이동은 메모리 주소를 유지하므로 _pixels도 그대로 유효하다.
+		_storage = std::move(b._storage);
+		_pixels = b._pixels;
+
+		b._width = 0;
+		b._height = 0;
+		b._stride = 0;
+		b._pixels = nullptr;
+		b._storage.clear();
+		b.resetClipRectangle();
+		return *this;
+	}
+
+	void Framebuffer::resize(uint32 width, uint32 height)
+	{
+		_width = width;
+		_height = height;
+		_stride = width;
+		_storage.clear();
+		_storage.resize(static_cast<size_t>(width) * height);
+		_pixels = _storage.data();
+		resetClipRectangle();
+	}
+
+	void Framebuffer::setClipRectangle(int32 left, int32 top, int32 right, int32 bottom) noexcept
+	{
+		_clipLeft = (left < 0) ? 0 : left;
+		_clipTop = (top < 0) ? 0 : top;
+		_clipRight = (right > static_cast<int32>(_width)) ? static_cast<int32>(_width) : right;
+		_clipBottom = (bottom > static_cast<int32>(_height)) ? static_cast<int32>(_height) : bottom;
+	}
+
+	void Framebuffer::resetClipRectangle() noexcept
+	{
+		_clipLeft = 0;
+		_clipTop = 0;
+		_clipRight = static_cast<int32>(_width);
+		_clipBottom = static_cast<int32>(_height);
+	}
+
+	void Framebuffer::getClipRectangle(int32& left, int32& top, int32& right, int32& bottom) const noexcept
+	{
+		left = _clipLeft;
+		top = _clipTop;
+		right = _clipRight;
+		bottom = _clipBottom;
+	}
+
+	void Framebuffer::clear(uint32 color) noexcept
+	{
+		if (_clipLeft >= _clipRight || _clipTop >= _clipBottom) return;
+
+		const SpanKernels& spanKernels{ getSpanKernels() };
+		if (_stride == _width && _clipLeft == 0 && _clipRight == static_cast<int32>(_width))
+		{
+			// 연속된 행들은 한 번에 채운다.
+			spanKernels.fillSpan(getRow(_clipTop), static_cast<size_t>(_clipBottom - _clipTop) * _width, color);
+			return;
+		}
+
+		for (int32 row = _clipTop; row < _clipBottom; ++row)
+		{
+			spanKernels.fillSpan(getRow(row) + _clipLeft, static_cast<size_t>(_clipRight - _clipLeft), color);
+		}
+	}
+
+	void Framebuffer::fillRectangle(int32 x, int32 y, int32 width, int32 height, uint32 color, uint8 alpha) noexcept
+	{
+		int32 left{ (x < _clipLeft) ? _clipLeft : x };
+		int32 top{ (y < _clipTop) ? _clipTop : y };
+		int32 right{ x + width };
+		int32 bottom{ y + height };
+		if (right > _clipRight) right = _clipRight;
+		if (bottom > _clipBottom) bottom = _clipBottom;
+		if (left >= right || top >= bottom) return;
+
+		const SpanKernels& spanKernels{ getSpanKernels() };
+		const size_t count{ static_cast<size_t>(right) - left };
+		for (int32 row = top; row < bottom; ++row)
+		{
+			uint32* const span{ getRow(row) + left };
+			if (alpha == 255)
+			{
+				spanKernels.fillSpan(span, count, color);
+			}
+			else
+			{
+				spanKernels.blendSpan(span, count, color, alpha);
+			}
+		}
+	}
+
+	void Framebuffer::drawImage(const Framebuffer& image, int32 x, int32 y) noexcept
+	{
+		int32 srcX{}, srcY{}, width{}, height{};
+		if (clipImage(image, x, y, srcX, srcY, width, height) == false) return;
+
+		for (int32 row = 0; row < height; ++row)
+		{
+			const uint32* const src{ image.getRow(srcY + row) + srcX };
+			uint32* const dst{ getRow(y + row) + x };
+			for (int32 column = 0; column < width; ++column)
+			{
+				dst[column] = src[column];
+			}
+		}
+	}
+
+	void Framebuffer::drawImageColorKey(const Framebuffer& image, int32 x, int32 y, uint32 colorKey) noexcept
+	{
+		int32 srcX{}, srcY{}, width{}, height{};
+		if (clipImage(image, x, y, srcX, srcY, width, height) == false) return;
+
+		const uint32 key{ colorKey & 0x00FFFFFF };
+		for (int32 row = 0; row < height; ++row)
+		{
+			const uint32* const src{ image.getRow(srcY + row) + srcX };
+			uint32* const dst{ getRow(y + row) + x };
+			for (int32 column = 0; column < width; ++column)
+			{
+				if ((src[column] & 0x00FFFFFF) != key)
+				{
+					dst[column] = src[column];
+				}
+			}
+		}
+	}
+
+	void Framebuffer::drawImageAlpha(const Framebuffer& image, int32 x, int32 y, uint8 alpha) noexcept
+	{
+		int32 srcX{}, srcY{}, width{}, height{};
+		if (clipImage(image, x, y, srcX, srcY, width, height) == false) return;
+
+		for (int32 row = 0; row < height; ++row)
+		{
+			const uint32* const src{ image.getRow(srcY + row) + srcX };
+			uint32* const dst{ getRow(y + row) + x };
+			for (int32 column = 0; column < width; ++column)
+			{
+				dst[column] = blendPixel(src[column], dst[column], alpha);
+			}
+		}
+	}
+
+	void Framebuffer::drawImagePremultipliedAlpha(const Framebuffer& image, int32 x, int32 y) noexcept
+	{
+		int32 srcX{}, srcY{}, width{}, height{};
+		if (clipImage(image, x, y, srcX, srcY, width, height) == false) return;
+
+		for (int32 row = 0; row < height; ++row)
+		{
+			const uint32* const src{ image.getRow(srcY + row) + srcX };
+			uint32* const dst{ getRow(y + row) + x };
+			for (int32 column = 0; column < width; ++column)
+			{
+				dst[column] = blendPixelPremultiplied(src[column], dst[column]);
+			}
+		}
+	}
+
+	void Framebuffer::drawLine(int32 xA, int32 yA, int32 xB, int32 yB, uint32 color) noexcept
+	{
+		// Bresenham
+		// 클리핑은 픽셀 단위로 하므로, 어떤 clip rectangle로 나누어 그려도 같은 픽셀이 찍힌다.
+		// 같은 행에 찍히는 픽셀들은 모아서(run) 한 번에 쓰고, clip 검사도 run마다 한 번만 한다.
+		const int32 minX{ (xA < xB) ? xA : xB };
+		const int32 maxX{ (xA < xB) ? xB : xA };
+		const int32 minY{ (yA < yB) ? yA : yB };
+		const int32 maxY{ (yA < yB) ? yB : yA };
+		if (maxX < _clipLeft || minX >= _clipRight || maxY < _clipTop || minY >= _clipBottom) return;
+
+		const int32 dx{ maxX - minX };
+		const int32 dy{ minY - maxY };
+		const int32 stepX{ (xA < xB) ? 1 : -1 };
+		const int32 stepY{ (yA < yB) ? 1 : -1 };
+		const int32 count{ (dx > -dy) ? dx : -dy };
+		if (count == 0) return;
+
+		// x, y 모두 한 방향으로만 움직이므로, clip rectangle을 지나친 뒤에는 더 찍을 픽셀이 없다.
+		const int32 exitX{ (stepX > 0) ? _clipRight : _clipLeft - 1 };
+		const int32 exitY{ (stepY > 0) ? _clipBottom : _clipTop - 1 };
+
+		int32 error{ dx + dy };
+		int32 x{ xA };
+		int32 y{ yA };
+		int32 runStartX{ xA };
+		int32 runEndX{ xA };
+		bool bRunOpen{ false };
+		for (int32 i = 0; i < count; ++i)
+		{
+			if (x == exitX || y == exitY) break;
+
+			runEndX = x;
+			bRunOpen = true;
+
+			const int32 error2{ error * 2 };
+			if (error2 >= dy)
+			{
+				error += dy;
+				x += stepX;
+			}
+			if (error2 <= dx)
+			{
+				error += dx;
+				fillRun(y, runStartX, runEndX, color);
+				bRunOpen = false;
+				y += stepY;
+				runStartX = x;
+			}
+		}
+		if (bRunOpen == true)
+		{
+			fillRun(y, runStartX, runEndX, color);
+		}
+	}
+
+	void Framebuffer::drawLineAntialiased(float xA, float yA, float xB, float yB, uint32 color) noexcept
+	{
+		// Xiaolin Wu
+		// 주 방향(major axis)의 픽셀마다 선의 위치에 걸친 두 픽셀을 거리에 반비례하는 coverage로 블렌딩한다.
+		// 각 픽셀의 값은 누적 없이 그 픽셀의 좌표만으로 계산하므로, 어떤 clip rectangle로 나누어 그려도 결과가 같다.
+		// 픽셀 중심이 정수 좌표가 되도록 옮긴다.
+		float x0{ xA - 0.5f };
+		float y0{ yA - 0.5f };
+		float x1{ xB - 0.5f };
+		float y1{ yB - 0.5f };
+		const bool bSteep{ fabsf(y1 - y0) > fabsf(x1 - x0) };
+		if (bSteep == true)
+		{
+			std::swap(x0, y0);
+			std::swap(x1, y1);
+		}
+		if (x0 > x1)
+		{
+			std::swap(x0, x1);
+			std::swap(y0, y1);
+		}
+
+		// 주 방향 좌표 u, 부 방향 좌표 v
+		const int32 clipMinU{ (bSteep == true) ? _clipTop : _clipLeft };
+		const int32 clipMaxU{ (bSteep == true) ? _clipBottom : _clipRight };
+		const int32 clipMinV{ (bSteep == true) ? _clipLeft : _clipTop };
+		const int32 clipMaxV{ (bSteep == true) ? _clipRight : _clipBottom };
+		const auto plot
+		{
+			[&](int32 u, int32 v, float coverage)
+			{
+				if (u < clipMinU || u >= clipMaxU || v < clipMinV || v >= clipMaxV) return;
+
+				const uint32 alpha{ static_cast<uint32>(coverage * 255.0f + 0.5f) };
+				if (alpha == 0) return;
+
+				uint32& pixel{ (bSteep == true) ? getRow(u)[v] : getRow(v)[u] };
+				pixel = blendPixel(color, pixel, (alpha > 255) ? 255 : alpha);
+			}
+		};
+
+		const float dx{ x1 - x0 };
+		const float gradient{ (dx == 0.0f) ? 1.0f : (y1 - y0) / dx };
+
+		// 두 끝점은 끝점이 걸친 길이(gap)만큼만 칠한다.
+		const float uEnd0{ floorf(x0 + 0.5f) };
+		const float vEnd0{ y0 + gradient * (uEnd0 - x0) };
+		const float gap0{ 1.0f - (x0 + 0.5f - floorf(x0 + 0.5f)) };
+		const int32 u0{ static_cast<int32>(uEnd0) };
+		const float uEnd1{ floorf(x1 + 0.5f) };
+		const float vEnd1{ y1 + gradient * (uEnd1 - x1) };
+		const float gap1{ x1 + 0.5f - floorf(x1 + 0.5f) };
+		const int32 u1{ static_cast<int32>(uEnd1) };
+		{
+			const float v0Floor{ floorf(vEnd0) };
+			const float v0Fraction{ vEnd0 - v0Floor };
+			plot(u0, static_cast<int32>(v0Floor), (1.0f - v0Fraction) * gap0);
+			plot(u0, static_cast<int32>(v0Floor) + 1, v0Fraction * gap0);
+		}
+		if (u1 != u0)
+		{
+			const float v1Floor{ floorf(vEnd1) };
+			const float v1Fraction{ vEnd1 - v1Floor };
+			plot(u1, static_cast<int32>(v1Floor), (1.0f - v1Fraction) * gap1);
+			plot(u1, static_cast<int32>(v1Floor) + 1, v1Fraction * gap1);
+		}
+
+		// 사이의 픽셀들. clip rectangle 밖의 주 방향 구간은 건너뛴다.
+		const int32 uBegin{ (u0 + 1 > clipMinU) ? u0 + 1 : clipMinU };
+		const int32 uEnd{ (u1 < clipMaxU) ? u1 : clipMaxU };
+		for (int32 u = uBegin; u < uEnd; ++u)
+		{
+			const float v{ vEnd0 + gradient * static_cast<float>(u - u0) };
+			const float vFloor{ floorf(v) };
+			const float vFraction{ v - vFloor };
+			plot(u, static_cast<int32>(vFloor), 1.0f - vFraction);
+			plot(u, static_cast<int32>(vFloor) + 1, vFraction);
+		}
+	}
+
+	void Framebuffer::blendCoverageSpan(int32 x, int32 y, const uint8* coverage, int32 count, uint32 color) noexcept
+	{
+		if (y < _clipTop || y >= _clipBottom) return;
+
+		const int32 left{ (x < _clipLeft) ? _clipLeft : x };
+		const int32 right{ (x + count > _clipRight) ? _clipRight : x + count };
+		uint32* const row{ getRow(y) };
+		for (int32 column = left; column < right; ++column)
+		{
+			const uint32 alpha{ coverage[column - x] };
+			if (alpha == 255)
+			{
+				row[column] = color;
+			}
+			else if (alpha != 0)
+			{
+				row[column] = blendPixel(color, row[column], alpha);
+			}
+		}
+	}
+
+	uint32 Framebuffer::getWidth() const noexcept
+	{
+		return _width;
+	}
+
+	uint32 Framebuffer::getHeight() const noexcept
+	{
+		return _height;
+	}
+
+	uint32 Framebuffer::getStride() const noexcept
+	{
+		return _stride;
+	}
+
+	uint32 Framebuffer::getPixel(uint32 x, uint32 y) const noexcept
+	{
+		assert(x < _width && y < _height);
+		return getRow(static_cast<int32>(y))[x];
+	}
+
+	const uint32* Framebuffer::getPixels() const noexcept
+	{
+		return _pixels;
+	}
+
+	uint32* Framebuffer::getPixels() noexcept
+	{
+		return _pixels;
+	}
+
+	uint32* Framebuffer::getRow(int32 y) const noexcept
+	{
+		return _pixels + static_cast<size_t>(y) * _stride;
+	}
+
+	void Framebuffer::fillRun(int32 y, int32 xA, int32 xB, uint32 color) noexcept
+	{
+		if (y < _clipTop || y >= _clipBottom) return;
+
+		int32 left{ (xA < xB) ? xA : xB };
+		int32 right{ ((xA < xB) ? xB : xA) + 1 };
+		if (left < _clipLeft) left = _clipLeft;
+		if (right > _clipRight) right = _clipRight;
+		if (left >= right) return;
+
+		uint32* const row{ getRow(y) };
+		if (right - left < 8)
+		{
+			for (int32 x = left; x < right; ++x)
+			{
+				row[x] = color;
+			}
+			return;
+		}
+		getSpanKernels().fillSpan(row + left, static_cast<size_t>(right - left), color);
+	}
+
+	bool Framebuffer::clipImage(const Framebuffer& image, int32& x, int32& y, int32& srcX, int32& srcY, int32& width, int32& height) const noexcept
+	{
+		srcX = 0;
+		srcY = 0;
+		width = static_cast<int32>(image._width);
+		height = static_cast<int32>(image._height);
+		if (x < _clipLeft)
+		{
+			srcX = _clipLeft - x;
+			width -= srcX;
+			x = _clipLeft;
+		}
+		if (y < _clipTop)
+		{
+			srcY = _clipTop - y;
+			height -= srcY;
+			y = _clipTop;
+		}
+		if (x + width > _clipRight) width = _clipRight - x;
+		if (y + height > _clipBottom) height = _clipBottom - y;
+		return (width > 0 && height > 0);
+	}
+}
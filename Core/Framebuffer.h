@@ -0,0 +1,111 @@
+﻿#pragma once
+
+
+#ifndef FS_FRAMEBUFFER_H
+#define FS_FRAMEBUFFER_H
+// === HEADER BEGINS ===
+
+
+#include <Core/_CommonTypes.h>
+
+
+namespace fs
+{
+	// 0xAARRGGBB (메모리 상으로는 B, G, R, A 순서. GDI의 32비트 DIB와 같은 배치)
+	static constexpr uint32 packBgra(uint8 r, uint8 g, uint8 b, uint8 a = 255) noexcept
+	{
+		return (static_cast<uint32>(a) << 24) | (static_cast<uint32>(r) << 16) | (static_cast<uint32>(g) << 8) | static_cast<uint32>(b);
+	}
+
+
+	// CPU에서 직접 그리는 32비트 BGRA 픽셀 버퍼.
+	// Windows에 의존하지 않으므로 Linux 빌드에서도 그대로 테스트/프로파일할 수 있다.
+	// 메모리를 직접 소유하거나, 다른 버퍼를 가리키는 view일 수 있다.
+	class Framebuffer final
+	{
+	public:
+		Framebuffer();
+		Framebuffer(uint32 width, uint32 height);
+		// pixels를 소유하지 않는 view. stride는 한 행의 픽셀 수이다.
+		Framebuffer(uint32* pixels, uint32 width, uint32 height, uint32 stride);
+		Framebuffer(const Framebuffer& b);
+		Framebuffer(Framebuffer&& b) noexcept;
+		~Framebuffer();
+
+	public:
+		Framebuffer& operator=(const Framebuffer& b);
+		Framebuffer& operator=(Framebuffer&& b) noexcept;
+
+	public:
+		// 크기를 바꾸고 모든 픽셀을 0으로 초기화한다. view였다면 메모리를 소유하게 된다.
+		void resize(uint32 width, uint32 height);
+
+		// 이후의 모든 그리기(clear() 포함)는 [left, right) x [top, bottom) 안쪽에만 적용된다.
+		void setClipRectangle(int32 left, int32 top, int32 right, int32 bottom) noexcept;
+		void resetClipRectangle() noexcept;
+		void getClipRectangle(int32& left, int32& top, int32& right, int32& bottom) const noexcept;
+
+	public:
+		void clear(uint32 color) noexcept;
+
+		// alpha < 255 이면 src-over 블렌딩 (GDI AlphaBlend()의 SourceConstantAlpha와 같다)
+		void fillRectangle(int32 x, int32 y, int32 width, int32 height, uint32 color, uint8 alpha = 255) noexcept;
+
+		// BitBlt(SRCCOPY)
+		void drawImage(const Framebuffer& image, int32 x, int32 y) noexcept;
+
+		// TransparentBlt(). colorKey와 RGB가 같은 픽셀은 그리지 않는다.
+		void drawImageColorKey(const Framebuffer& image, int32 x, int32 y, uint32 colorKey) noexcept;
+
+		// AlphaBlend(), AlphaFormat == 0
+		void drawImageAlpha(const Framebuffer& image, int32 x, int32 y, uint8 alpha) noexcept;
+
+		// AlphaBlend(), AlphaFormat == AC_SRC_ALPHA (image는 premultiplied alpha)
+		void drawImagePremultipliedAlpha(const Framebuffer& image, int32 x, int32 y) noexcept;
+
+		// MoveToEx() + LineTo()처럼 끝점 B는 그리지 않는다.
+		void drawLine(int32 xA, int32 yA, int32 xB, int32 yB, uint32 color) noexcept;
+
+		// Xiaolin Wu의 anti-aliasing 선. 좌표는 픽셀 단위 실수이며 픽셀 (x, y)의 중심은 (x + 0.5, y + 0.5)이다.
+		// 선이 걸친 픽셀마다 coverage를 alpha로 하여 color를 블렌딩한다. (color의 alpha는 무시)
+		void drawLineAntialiased(float xA, float yA, float xB, float yB, uint32 color) noexcept;
+
+		// (x, y)부터 오른쪽으로 count개의 픽셀에 coverage[i]를 alpha로 하여 color를 블렌딩한다. (color의 alpha는 무시)
+		void blendCoverageSpan(int32 x, int32 y, const uint8* coverage, int32 count, uint32 color) noexcept;
+
+	public:
+		uint32 getWidth() const noexcept;
+		uint32 getHeight() const noexcept;
+		uint32 getStride() const noexcept;
+		uint32 getPixel(uint32 x, uint32 y) const noexcept;
+		const uint32* getPixels() const noexcept;
+		uint32* getPixels() noexcept;
+
+	private:
+		uint32* getRow(int32 y) const noexcept;
+
+		// [min(xA, xB), max(xA, xB)] 구간을 clip해서 채운다.
+		void fillRun(int32 y, int32 xA, int32 xB, uint32 color) noexcept;
+
+		// image를 (x, y)에 그릴 때 실제로 겹치는 영역을 구한다. 겹치지 않으면 false.
+		bool clipImage(const Framebuffer& image, int32& x, int32& y, int32& srcX, int32& srcY, int32& width, int32& height) const noexcept;
+
+	private:
+		uint32					_width{};
+		uint32					_height{};
+		uint32					_stride{};
+		uint32*					_pixels{};
+
+		int32					_clipLeft{};
+		int32					_clipTop{};
+		int32					_clipRight{};
+		int32					_clipBottom{};
+
+		// view가 아닐 때 실제 메모리
+		std::vector<uint32>		_storage{};
+	};
+}
+
+
+// === HEADER ENDS ===
+#endif // !FS_FRAMEBUFFER_H
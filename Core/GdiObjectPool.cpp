@@ -0,0 +1,116 @@
+﻿#include "GdiObjectPool.h"
+
+#include <cassert>
+
+
+namespace fs
+{
+	GdiObjectPool::GdiObjectPool(uint32 capacity) : _capacity{ capacity }
+	{
+		assert(capacity > 0);
+	}
+
+	GdiObjectPool::~GdiObjectPool()
+	{
+		clear();
+	}
+
+	HBRUSH GdiObjectPool::getBrush(COLORREF color)
+	{
+		const uint64 key{ makeKey(EObjectType::Brush, color, 0) };
+		HGDIOBJ object{ find(key) };
+		if (object == nullptr)
+		{
+			object = CreateSolidBrush(color);
+			insert(key, object);
+		}
+		return static_cast<HBRUSH>(object);
+	}
+
+	HPEN GdiObjectPool::getPen(COLORREF color, int32 width)
+	{
+		const uint64 key{ makeKey(EObjectType::Pen, color, width) };
+		HGDIOBJ object{ find(key) };
+		if (object == nullptr)
+		{
+			object = CreatePen(PS_SOLID, width, color);
+			insert(key, object);
+		}
+		return static_cast<HPEN>(object);
+	}
+
+	void GdiObjectPool::clear() noexcept
+	{
+		evict(0);
+	}
+
+	void GdiObjectPool::setCapacity(uint32 capacity)
+	{
+		assert(capacity > 0);
+		_capacity = capacity;
+		evict(_capacity);
+	}
+
+	uint32 GdiObjectPool::getCapacity() const noexcept
+	{
+		return _capacity;
+	}
+
+	uint32 GdiObjectPool::getSize() const noexcept
+	{
+		return static_cast<uint32>(_map.size());
+	}
+
+	uint64 GdiObjectPool::getHitCount() const noexcept
+	{
+		return _hitCount;
+	}
+
+	uint64 GdiObjectPool::getMissCount() const noexcept
+	{
+		return _missCount;
+	}
+
+	void GdiObjectPool::resetCounters() noexcept
+	{
+		_hitCount = 0;
+		_missCount = 0;
+	}
+
+	uint64 GdiObjectPool::makeKey(EObjectType eObjectType, COLORREF color, int32 width) noexcept
+	{
+		return (static_cast<uint64>(eObjectType) << 56) | (static_cast<uint64>(static_cast<uint32>(width)) << 24) | (color & 0xFFFFFF);
+	}
+
+	HGDIOBJ GdiObjectPool::find(uint64 key) noexcept
+	{
+		auto iter{ _map.find(key) };
+		if (iter == _map.end())
+		{
+			++_missCount;
+			return nullptr;
+		}
+
+		++_hitCount;
+		_lruList.splice(_lruList.begin(), _lruList, iter->second);
+		return iter->second->object;
+	}
+
+	void GdiObjectPool::insert(uint64 key, HGDIOBJ object)
+	{
+		evict(_capacity - 1);
+
+		_lruList.push_front(Entry{ key, object });
+		_map.emplace(key, _lruList.begin());
+	}
+
+	void GdiObjectPool::evict(uint32 targetSize) noexcept
+	{
+		while (_lruList.size() > targetSize)
+		{
+			DeleteObject(_lruList.back().object);
+			_map.erase(_lruList.back().key);
+			_lruList.pop_back();
+		}
+	}
+}
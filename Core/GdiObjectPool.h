@@ -0,0 +1,80 @@
+﻿#pragma once
+
+
+#ifndef FS_GDI_OBJECT_POOL_H
+#define FS_GDI_OBJECT_POOL_H
+// === HEADER BEGINS ===
+
+
+#include <Core/_CommonTypes.h>
+
+#include <list>
+#include <unordered_map>
+
+
+namespace fs
+{
+	// 색(과 두께)이 같은 brush와 pen을 프레임 사이에서 재사용한다.
+	// 가득 차면 가장 오래 사용하지 않은 것(LRU)부터 DeleteObject() 한다.
+	// @주의: 돌려받은 객체를 DC에 선택한 채로 두면 안 된다. (선택된 객체는 삭제할 수 없음)
+	class GdiObjectPool final
+	{
+	public:
+		static constexpr uint32 kDefaultCapacity{ 64 };
+
+	public:
+		explicit GdiObjectPool(uint32 capacity = kDefaultCapacity);
+		~GdiObjectPool();
+
+	public:
+		HBRUSH getBrush(COLORREF color);
+		HPEN getPen(COLORREF color, int32 width = 1);
+
+		// 모든 객체를 삭제한다. 카운터는 유지된다.
+		void clear() noexcept;
+		void setCapacity(uint32 capacity);
+
+	public:
+		uint32 getCapacity() const noexcept;
+		uint32 getSize() const noexcept;
+		uint64 getHitCount() const noexcept;
+		uint64 getMissCount() const noexcept;
+		void resetCounters() noexcept;
+
+	private:
+		enum class EObjectType : uint64
+		{
+			Brush,
+			Pen,
+		};
+
+		struct Entry
+		{
+			uint64		key{};
+			HGDIOBJ		object{};
+		};
+
+		// [63..56] EObjectType, [55..24] width, [23..0] COLORREF
+		static uint64 makeKey(EObjectType eObjectType, COLORREF color, int32 width) noexcept;
+
+		// 있으면 LRU의 맨 앞으로 옮기고 돌려준다. 없으면 nullptr.
+		HGDIOBJ find(uint64 key) noexcept;
+		void insert(uint64 key, HGDIOBJ object);
+		void evict(uint32 targetSize) noexcept;
+
+	private:
+		uint32											_capacity{};
+
+		// 앞쪽일수록 최근에 사용한 객체
+		std::list<Entry>								_lruList{};
+		std::unordered_map<uint64, std::list<Entry>::iterator>	_map{};
+
+	private:
+		uint64											_hitCount{};
+		uint64											_missCount{};
+	};
+}
+
+
+// === HEADER ENDS ===
+#endif // !FS_GDI_OBJECT_POOL_H
@@ -0,0 +1,314 @@
+﻿#include "GlyphAtlas.h"
+#include <Core/Framebuffer.h>
+
+#include <cstring>
+#include <fstream>
+
+
+namespace fs
+{
+	// baked atlas 파일의 머리. 뒤로 (code point, GlyphInfo) * glyphCount, coverage * (atlasWidth * atlasHeight)가 이어진다.
+	struct GlyphAtlasFileHeader
+	{
+		char	magic[4]{ 'F', 'S', 'G', 'A' };
+		uint32	version{ 1 };
+		int32	lineHeight{};
+		int32	ascent{};
+		uint32	atlasWidth{};
+		uint32	atlasHeight{};
+		uint32	glyphCount{};
+	};
+
+	struct GlyphAtlasFileGlyph
+	{
+		uint32		codePoint{};
+		GlyphInfo	info{};
+	};
+
+	// 깨지거나 조작된 파일이 큰 할당을 일으키지 않도록, 불러올 때 머리의 값에 두는 상한
+	// wchar_t 글자는 65536개를 넘을 수 없고, 512 * 16384 = 8MB이면 어떤 글꼴의 atlas도 충분히 담는다.
+	static constexpr uint32 kMaxFileGlyphCount{ 65536 };
+	static constexpr uint32 kMaxFileAtlasHeight{ 16384 };
+
+
+	GlyphAtlas::GlyphAtlas()
+	{
+		clear();
+	}
+
+	GlyphAtlas::~GlyphAtlas()
+	{
+		__noop;
+	}
+
+	void GlyphAtlas::setFontMetrics(int32 lineHeight, int32 ascent) noexcept
+	{
+		_lineHeight = lineHeight;
+		_ascent = ascent;
+	}
+
+	bool GlyphAtlas::addGlyph(wchar_t codePoint, uint32 width, uint32 height, int32 offsetX, int32 offsetY, int32 advance, const uint8* coverage, uint32 pitch)
+	{
+		if (findGlyph(codePoint) != nullptr) return false;
+		if (width > kAtlasWidth) return false;
+
+		if (_shelfX + width > kAtlasWidth)
+		{
+			_shelfX = 0;
+			_shelfY += _shelfHeight;
+			_shelfHeight = 0;
+		}
+		if (_shelfY + height > _atlasHeight)
+		{
+			uint32 atlasHeight{ (_atlasHeight == 0) ? 64 : _atlasHeight };
+			while (_shelfY + height > atlasHeight) atlasHeight *= 2;
+			_vPixels.resize(static_cast<size_t>(kAtlasWidth) * atlasHeight, 0);
+			_atlasHeight = atlasHeight;
+		}
+
+		GlyphInfo glyph{};
+		glyph.atlasX = static_cast<uint16>(_shelfX);
+		glyph.atlasY = static_cast<uint16>(_shelfY);
+		glyph.width = static_cast<uint16>(width);
+		glyph.height = static_cast<uint16>(height);
+		glyph.offsetX = static_cast<int16>(offsetX);
+		glyph.offsetY = static_cast<int16>(offsetY);
+		glyph.advance = static_cast<int16>(advance);
+		for (uint32 row = 0; row < height; ++row)
+		{
+			memcpy(&_vPixels[static_cast<size_t>(_shelfY + row) * kAtlasWidth + _shelfX], coverage + static_cast<size_t>(row) * pitch, width);
+		}
+		_shelfX += width;
+		_shelfHeight = (height > _shelfHeight) ? height : _shelfHeight;
+
+		const uint32 index{ static_cast<uint32>(_vGlyphs.size()) };
+		_vGlyphs.emplace_back(glyph);
+		_vCodePoints.emplace_back(static_cast<uint32>(codePoint));
+		if (static_cast<uint32>(codePoint) < kAsciiCount)
+		{
+			_asciiIndices[static_cast<uint32>(codePoint)] = index;
+		}
+		else
+		{
+			_glyphIndices[static_cast<uint32>(codePoint)] = index;
+		}
+		return true;
+	}
+
+	void GlyphAtlas::clear() noexcept
+	{
+		_lineHeight = 0;
+		_ascent = 0;
+		++_generation;
+		_vGlyphs.clear();
+		for (auto& asciiIndex : _asciiIndices)
+		{
+			asciiIndex = kUint32Max;
+		}
+		_glyphIndices.clear();
+		_vCodePoints.clear();
+		_vPixels.clear();
+		_atlasHeight = 0;
+		_shelfX = 0;
+		_shelfY = 0;
+		_shelfHeight = 0;
+	}
+
+	void GlyphAtlas::drawText(Framebuffer& target, int32 x, int32 y, std::wstring_view text, uint32 color) const noexcept
+	{
+		for (const wchar_t codePoint : text)
+		{
+			const GlyphInfo* const glyph{ findGlyph(codePoint) };
+			if (glyph == nullptr) continue;
+
+			drawGlyph(target, x, y, *glyph, color);
+			x += glyph->advance;
+		}
+	}
+
+	void GlyphAtlas::drawGlyph(Framebuffer& target, int32 x, int32 y, const GlyphInfo& glyph, uint32 color) const noexcept
+	{
+		const int32 left{ x + glyph.offsetX };
+		const int32 top{ y + glyph.offsetY };
+		const uint8* coverage{ &_vPixels[static_cast<size_t>(glyph.atlasY) * kAtlasWidth + glyph.atlasX] };
+		for (int32 row = 0; row < static_cast<int32>(glyph.height); ++row)
+		{
+			target.blendCoverageSpan(left, top + row, coverage, glyph.width, color);
+			coverage += kAtlasWidth;
+		}
+	}
+
+	int32 GlyphAtlas::measureText(std::wstring_view text) const noexcept
+	{
+		int32 width{};
+		for (const wchar_t codePoint : text)
+		{
+			if (const GlyphInfo* const glyph{ findGlyph(codePoint) })
+			{
+				width += glyph->advance;
+			}
+		}
+		return width;
+	}
+
+	void GlyphAtlas::computeTextBounds(std::wstring_view text, int32& left, int32& top, int32& right, int32& bottom) const noexcept
+	{
+		left = 0;
+		top = 0;
+		right = 0;
+		bottom = _lineHeight;
+
+		int32 x{};
+		for (const wchar_t codePoint : text)
+		{
+			const GlyphInfo* const glyph{ findGlyph(codePoint) };
+			if (glyph == nullptr) continue;
+
+			if (glyph->width > 0 && glyph->height > 0)
+			{
+				left = (x + glyph->offsetX < left) ? x + glyph->offsetX : left;
+				top = (glyph->offsetY < top) ? glyph->offsetY : top;
+				right = (x + glyph->offsetX + glyph->width > right) ? x + glyph->offsetX + glyph->width : right;
+				bottom = (glyph->offsetY + glyph->height > bottom) ? glyph->offsetY + glyph->height : bottom;
+			}
+			x += glyph->advance;
+		}
+		right = (x > right) ? x : right;
+	}
+
+	const GlyphInfo* GlyphAtlas::findGlyph(wchar_t codePoint) const noexcept
+	{
+		if (static_cast<uint32>(codePoint) < kAsciiCount)
+		{
+			const uint32 index{ _asciiIndices[static_cast<uint32>(codePoint)] };
+			return (index == kUint32Max) ? nullptr : &_vGlyphs[index];
+		}
+
+		const auto found{ _glyphIndices.find(static_cast<uint32>(codePoint)) };
+		return (found == _glyphIndices.end()) ? nullptr : &_vGlyphs[found->second];
+	}
+
+	int32 GlyphAtlas::getLineHeight() const noexcept
+	{
+		return _lineHeight;
+	}
+
+	int32 GlyphAtlas::getAscent() const noexcept
+	{
+		return _ascent;
+	}
+
+	uint32 GlyphAtlas::getGlyphCount() const noexcept
+	{
+		return static_cast<uint32>(_vGlyphs.size());
+	}
+
+	uint32 GlyphAtlas::getAtlasWidth() const noexcept
+	{
+		return kAtlasWidth;
+	}
+
+	uint32 GlyphAtlas::getAtlasHeight() const noexcept
+	{
+		return _atlasHeight;
+	}
+
+	const uint8* GlyphAtlas::getAtlasPixels() const noexcept
+	{
+		return _vPixels.data();
+	}
+
+	uint32 GlyphAtlas::getGeneration() const noexcept
+	{
+		return _generation;
+	}
+
+	bool GlyphAtlas::saveToFile(const std::filesystem::path& filePath) const
+	{
+		std::ofstream file{ filePath, std::ios::binary };
+		if (file.is_open() == false) return false;
+
+		GlyphAtlasFileHeader header{};
+		header.lineHeight = _lineHeight;
+		header.ascent = _ascent;
+		header.atlasWidth = kAtlasWidth;
+		header.atlasHeight = _atlasHeight;
+		header.glyphCount = static_cast<uint32>(_vGlyphs.size());
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		for (size_t i = 0; i < _vGlyphs.size(); ++i)
+		{
+			GlyphAtlasFileGlyph fileGlyph{};
+			fileGlyph.codePoint = _vCodePoints[i];
+			fileGlyph.info = _vGlyphs[i];
+			file.write(reinterpret_cast<const char*>(&fileGlyph), sizeof(fileGlyph));
+		}
+		file.write(reinterpret_cast<const char*>(_vPixels.data()), static_cast<std::streamsize>(_vPixels.size()));
+		return file.good();
+	}
+
+	bool GlyphAtlas::loadFromFile(const std::filesystem::path& filePath)
+	{
+		std::ifstream file{ filePath, std::ios::binary };
+		if (file.is_open() == false) return false;
+
+		GlyphAtlasFileHeader header{};
+		const GlyphAtlasFileHeader kExpected{};
+		file.read(reinterpret_cast<char*>(&header), sizeof(header));
+		if (file.good() == false || memcmp(header.magic, kExpected.magic, sizeof(header.magic)) != 0 || header.version != kExpected.version
+			|| header.atlasWidth != kAtlasWidth)
+		{
+			return false;
+		}
+		if (header.glyphCount > kMaxFileGlyphCount || header.atlasHeight > kMaxFileAtlasHeight)
+		{
+			return false;
+		}
+
+		// 할당하기 전에 머리가 말하는 크기와 실제 파일 크기가 같은지 확인한다.
+		const uint64 expectedFileSize{ sizeof(GlyphAtlasFileHeader) + static_cast<uint64>(header.glyphCount) * sizeof(GlyphAtlasFileGlyph)
+			+ static_cast<uint64>(header.atlasWidth) * header.atlasHeight };
+		file.seekg(0, std::ios::end);
+		const std::streamoff fileSize{ file.tellg() };
+		file.seekg(sizeof(GlyphAtlasFileHeader), std::ios::beg);
+		if (fileSize < 0 || static_cast<uint64>(fileSize) != expectedFileSize || file.good() == false)
+		{
+			return false;
+		}
+
+		std::vector<GlyphAtlasFileGlyph> vFileGlyphs(header.glyphCount);
+		file.read(reinterpret_cast<char*>(vFileGlyphs.data()), static_cast<std::streamsize>(sizeof(GlyphAtlasFileGlyph) * vFileGlyphs.size()));
+		std::vector<uint8> vPixels(static_cast<size_t>(header.atlasWidth) * header.atlasHeight);
+		file.read(reinterpret_cast<char*>(vPixels.data()), static_cast<std::streamsize>(vPixels.size()));
+		if (file.good() == false) return false;
+
+		clear();
+		_lineHeight = header.lineHeight;
+		_ascent = header.ascent;
+		_vPixels = std::move(vPixels);
+		_atlasHeight = header.atlasHeight;
+		// 불러온 atlas에 글자를 더 넣으면 새 shelf부터 쌓는다.
+		_shelfY = header.atlasHeight;
+		for (const auto& fileGlyph : vFileGlyphs)
+		{
+			const GlyphInfo& info{ fileGlyph.info };
+			if (static_cast<uint32>(info.atlasX) + info.width > header.atlasWidth || static_cast<uint32>(info.atlasY) + info.height > header.atlasHeight)
+			{
+				clear();
+				return false;
+			}
+
+			const uint32 index{ static_cast<uint32>(_vGlyphs.size()) };
+			_vGlyphs.emplace_back(info);
+			_vCodePoints.emplace_back(fileGlyph.codePoint);
+			if (fileGlyph.codePoint < kAsciiCount)
+			{
+				_asciiIndices[fileGlyph.codePoint] = index;
+			}
+			else
+			{
+				_glyphIndices[fileGlyph.codePoint] = index;
+			}
+		}
+		return true;
+	}
+}
@@ -0,0 +1,118 @@
+﻿#pragma once
+
+
+#ifndef FS_GLYPH_ATLAS_H
+#define FS_GLYPH_ATLAS_H
+// === HEADER BEGINS ===
+
+
+#include <Core/_CommonTypes.h>
+
+#include <filesystem>
+#include <string_view>
+#include <unordered_map>
+
+
+namespace fs
+{
+	class Framebuffer;
+
+
+	// atlas 안의 글자 하나
+	struct GlyphInfo
+	{
+		// atlas 안의 위치와 크기
+		uint16	atlasX{};
+		uint16	atlasY{};
+		uint16	width{};
+		uint16	height{};
+
+		// 펜 위치(글자 줄의 왼쪽 위)에서 bitmap의 왼쪽 위까지
+		int16	offsetX{};
+		int16	offsetY{};
+
+		// 다음 글자의 펜 위치까지
+		int16	advance{};
+	};
+
+
+	// 한 폰트의 글자들을 미리 rasterize해 둔 8비트 coverage atlas.
+	// 글자를 그릴 때는 atlas의 coverage를 alpha로 하여 색을 입혀 복사하기만 한다. (shaping, rasterize 없음)
+	// 글자는 shelf 방식으로 왼쪽에서 오른쪽, 위에서 아래로 쌓고, 가득 차면 atlas의 높이를 두 배로 늘린다.
+	// 파일로 저장해 두었다가 불러올 수 있어서, Windows가 없는 환경(Linux 벤치마크 등)에서도 같은 글자를 그릴 수 있다.
+	class GlyphAtlas final
+	{
+	public:
+		static constexpr uint32 kAtlasWidth{ 512 };
+
+	public:
+		GlyphAtlas();
+		~GlyphAtlas();
+
+	public:
+		// lineHeight: 글자 줄의 높이, ascent: 글자 줄의 위에서 baseline까지
+		void setFontMetrics(int32 lineHeight, int32 ascent) noexcept;
+
+		// coverage는 0~255, pitch는 한 행의 바이트 수이다. 이미 있는 글자면 false
+		// 공백처럼 bitmap이 없는 글자는 width, height가 0이다.
+		bool addGlyph(wchar_t codePoint, uint32 width, uint32 height, int32 offsetX, int32 offsetY, int32 advance, const uint8* coverage, uint32 pitch);
+
+		void clear() noexcept;
+
+	public:
+		// (x, y)는 글자 줄의 왼쪽 위이다. atlas에 없는 글자는 건너뛴다.
+		void drawText(Framebuffer& target, int32 x, int32 y, std::wstring_view text, uint32 color) const noexcept;
+		void drawGlyph(Framebuffer& target, int32 x, int32 y, const GlyphInfo& glyph, uint32 color) const noexcept;
+
+		// 펜이 움직인 거리 (advance의 합)
+		int32 measureText(std::wstring_view text) const noexcept;
+
+		// 글자 줄의 왼쪽 위를 (0, 0)으로 할 때, 글자 bitmap들과 글자 줄 상자를 모두 감싸는 영역
+		void computeTextBounds(std::wstring_view text, int32& left, int32& top, int32& right, int32& bottom) const noexcept;
+
+	public:
+		// 없으면 nullptr
+		const GlyphInfo* findGlyph(wchar_t codePoint) const noexcept;
+		int32 getLineHeight() const noexcept;
+		int32 getAscent() const noexcept;
+		uint32 getGlyphCount() const noexcept;
+		uint32 getAtlasWidth() const noexcept;
+		uint32 getAtlasHeight() const noexcept;
+		const uint8* getAtlasPixels() const noexcept;
+		// clear(), loadFromFile()처럼 이미 있는 글자가 옮겨지거나 지워질 때마다 증가한다. (글자를 더하는 것은 해당하지 않는다.)
+		uint32 getGeneration() const noexcept;
+
+	public:
+		// baked atlas 파일 (글꼴 정보, 글자 목록, coverage). 실패하면 false
+		bool saveToFile(const std::filesystem::path& filePath) const;
+		bool loadFromFile(const std::filesystem::path& filePath);
+
+	private:
+		static constexpr uint32 kAsciiCount{ 128 };
+
+	private:
+		int32									_lineHeight{};
+		int32									_ascent{};
+		uint32									_generation{};
+
+	private:
+		std::vector<GlyphInfo>					_vGlyphs{};
+		// 글자 -> _vGlyphs의 index. ASCII는 배열로 바로 찾는다.
+		uint32									_asciiIndices[kAsciiCount]{};
+		std::unordered_map<uint32, uint32>		_glyphIndices{};
+		// 파일에 저장할 때 쓰는 _vGlyphs와 같은 순서의 글자들
+		std::vector<uint32>						_vCodePoints{};
+
+	private:
+		std::vector<uint8>						_vPixels{};
+		uint32									_atlasHeight{};
+		// 현재 shelf
+		uint32									_shelfX{};
+		uint32									_shelfY{};
+		uint32									_shelfHeight{};
+	};
+}
+
+
+// === HEADER ENDS ===
+#endif // !FS_GLYPH_ATLAS_H
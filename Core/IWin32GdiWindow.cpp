@@ -11,7 +11,262 @@
 
 namespace fs
 {
-	IWin32GdiWindow::IWin32GdiWindow(float width, float height) : kWidth{ width }, kHeight{ height }
+	// 32비트 BGRA -> GDI의 COLORREF
+	static COLORREF toColorref(uint32 bgra) noexcept
+	{
+		return RGB((bgra >> 16) & 0xFF, (bgra >> 8) & 0xFF, bgra & 0xFF);
+	}
+
+	static UINT toDrawTextFormat(EHorzAlign eHorzAlign, EVertAlign eVertAlign) noexcept
+	{
+		const UINT horzAlign{ static_cast<UINT>((eHorzAlign == EHorzAlign::Left) ? DT_LEFT : (eHorzAlign == EHorzAlign::Center) ? DT_CENTER : DT_RIGHT) };
+		const UINT vertAlign{ static_cast<UINT>((eVertAlign == EVertAlign::Top) ? DT_TOP : (eVertAlign == EVertAlign::Center) ? DT_VCENTER : DT_BOTTOM) };
+		return horzAlign | vertAlign | DT_NOCLIP | DT_SINGLELINE;
+	}
+
+	// Text 명령의 DT_ 정렬 플래그를 적용한 글자 줄의 왼쪽 위
+	static void computeTextOrigin(const GlyphAtlas& glyphAtlas, const DrawCommand& command, std::wstring_view text, int32& x, int32& y) noexcept
+	{
+		const int32 textWidth{ glyphAtlas.measureText(text) };
+		const int32 lineHeight{ glyphAtlas.getLineHeight() };
+		x = ((command.param & DT_CENTER) != 0) ? command.x0 + (command.x1 - command.x0 - textWidth) / 2
+			: ((command.param & DT_RIGHT) != 0) ? command.x1 - textWidth : command.x0;
+		y = ((command.param & DT_VCENTER) != 0) ? command.y0 + (command.y1 - command.y0 - lineHeight) / 2
+			: ((command.param & DT_BOTTOM) != 0) ? command.y1 - lineHeight : command.y0;
+	}
+
+
+	// ERenderBackend::Gdi
+	// 상태(brush, pen, 폰트, 글자색, 이미지)가 바뀔 때만 SelectObject()/SetTextColor()를 호출한다.
+	class IWin32GdiWindow::GdiCommandExecutor final : public IDrawCommandExecutor
+	{
+	public:
+		explicit GdiCommandExecutor(const IWin32GdiWindow& window) : _window{ window }
+		{
+			__noop;
+		}
+
+	public:
+		virtual void beginStateRun(const DrawCommand& command) override
+		{
+			const COLORREF color{ toColorref(command.color) };
+			switch (command.eType)
+			{
+			case EDrawCommandType::Rectangle:
+				_brush = _window._gdiObjectPool.getBrush(color);
+				break;
+			case EDrawCommandType::Text:
+			case EDrawCommandType::TextLayout:
+				// 글자는 glyph atlas에서 back buffer(DIB section)로 CPU가 복사한다. 먼저 GDI가 그리던 것을 끝낸다.
+				GdiFlush();
+				break;
+			case EDrawCommandType::Line:
+			{
+				const HGDIOBJ prevPen{ SelectObject(_window._backDc, _window._gdiObjectPool.getPen(color)) };
+				if (_prevPen == nullptr)
+				{
+					_prevPen = prevPen;
+				}
+				break;
+			}
+			case EDrawCommandType::Polyline:
+				break;
+			default:
+				assert(command.resource < static_cast<uint32>(_window._vImages.size()));
+				SelectObject(_window._tempDc, _window._vImages[command.resource].bitmap);
+				break;
+			}
+		}
+
+		virtual void execute(const DrawCommand& command, const wchar_t* text) override
+		{
+			const HDC backDc{ _window._backDc };
+			const HDC tempDc{ _window._tempDc };
+			const int width{ command.x1 - command.x0 };
+			const int height{ command.y1 - command.y0 };
+			switch (command.eType)
+			{
+			case EDrawCommandType::Rectangle:
+				if (command.alpha == 255)
+				{
+					RECT rect{};
+					rect.left = command.x0;
+					rect.right = command.x1;
+					rect.top = command.y0;
+					rect.bottom = command.y1;
+					FillRect(backDc, &rect, _brush);
+				}
+				else
+				{
+					// back buffer(DIB section)에 CPU로 블렌딩한다. 먼저 GDI가 그리던 것을 끝낸다.
+					GdiFlush();
+					drawOnBackBuffer(
+						[&](Framebuffer& backBuffer)
+						{
+							backBuffer.fillRectangle(command.x0, command.y0, width, height, command.color, command.alpha);
+						});
+				}
+				break;
+			case EDrawCommandType::Image:
+				BitBlt(backDc, command.x0, command.y0, width, height, tempDc, 0, 0, SRCCOPY);
+				break;
+			case EDrawCommandType::ImageColorKey:
+				TransparentBlt(backDc, command.x0, command.y0, width, height, tempDc, 0, 0, width, height, 0);
+				break;
+			case EDrawCommandType::ImageAlpha:
+			case EDrawCommandType::ImagePremultipliedAlpha:
+			{
+				BLENDFUNCTION blend{};
+				blend.BlendOp = AC_SRC_OVER;
+				blend.BlendFlags = 0;
+				blend.AlphaFormat = (command.eType == EDrawCommandType::ImageAlpha) ? 0 : AC_SRC_ALPHA;
+				blend.SourceConstantAlpha = command.alpha;
+				AlphaBlend(backDc, command.x0, command.y0, width, height, tempDc, 0, 0, width, height, blend);
+				break;
+			}
+			case EDrawCommandType::Text:
+				_window.prepareGlyphAtlas(command.resource, std::wstring_view(text, command.textLength));
+				drawOnBackBuffer(
+					[&](Framebuffer& backBuffer)
+					{
+						_window.drawTextCommand(backBuffer, command, text);
+					});
+				break;
+			case EDrawCommandType::TextLayout:
+				drawOnBackBuffer(
+					[&](Framebuffer& backBuffer)
+					{
+						_window.drawTextLayoutCommand(backBuffer, command);
+					});
+				break;
+			case EDrawCommandType::Line:
+			{
+				// GDI는 anti-aliasing 선을 그리지 못하므로 가장 가까운 픽셀로 그린다.
+				const int32 shift{ ((command.param & DrawCommandList::kLineAntialiased) != 0) ? DrawCommandList::kLineSubpixelShift : 0 };
+				const int32 half{ (shift == 0) ? 0 : (1 << (shift - 1)) };
+				POINT point{};
+				MoveToEx(backDc, (command.x0 + half) >> shift, (command.y0 + half) >> shift, &point);
+				LineTo(backDc, (command.x1 + half) >> shift, (command.y1 + half) >> shift);
+				break;
+			}
+			default:
+				break;
+			}
+		}
+
+		virtual void executePolyline(const DrawCommand& command, std::span<const Float2> points) override
+		{
+			// pen 대신 back buffer(DIB section)에 CPU로 그린다. 먼저 GDI가 그리던 것을 끝낸다.
+			GdiFlush();
+
+			const FramebufferCommandExecutor executor{ _window._backBuffer };
+			drawOnBackBuffer(
+				[&](Framebuffer& backBuffer)
+				{
+					executor.executeOn(backBuffer, command, points);
+				});
+		}
+
+		virtual void endReplay() override
+		{
+			if (_prevPen != nullptr)
+			{
+				SelectObject(_window._backDc, _prevPen);
+			}
+		}
+
+	public:
+		// 비어 있지 않으면 CPU로 그리는 명령은 이 영역들 안에만 그린다.
+		void setClipRects(std::span<const PixelRect> clipRects) noexcept
+		{
+			_clipRects = clipRects;
+		}
+
+	private:
+		// back buffer에 CPU로 그린다. GDI의 clip region은 CPU로 그리는 것에 적용되지 않으므로 _clipRects마다 나누어 그린다.
+		template <typename DrawFunction>
+		void drawOnBackBuffer(DrawFunction drawFunction) const
+		{
+			Framebuffer& backBuffer{ _window._backBuffer };
+			if (_clipRects.empty() == true)
+			{
+				drawFunction(backBuffer);
+				return;
+			}
+
+			for (const auto& clipRect : _clipRects)
+			{
+				backBuffer.setClipRectangle(clipRect.left, clipRect.top, clipRect.right, clipRect.bottom);
+				drawFunction(backBuffer);
+			}
+			backBuffer.resetClipRectangle();
+		}
+
+	private:
+		const IWin32GdiWindow&	_window;
+		HBRUSH					_brush{};
+		HGDIOBJ					_prevPen{};
+		std::span<const PixelRect>	_clipRects{};
+	};
+
+
+	// ERenderBackend::Software
+	// 모든 명령을 _backBuffer에 그린다. 텍스트는 glyph atlas에서 복사한다.
+	class IWin32GdiWindow::SoftwareCommandExecutor final : public FramebufferCommandExecutor
+	{
+	public:
+		explicit SoftwareCommandExecutor(const IWin32GdiWindow& window) : FramebufferCommandExecutor(window._backBuffer), _window{ window }
+		{
+			__noop;
+		}
+
+	public:
+		virtual void prepareText(const DrawCommand& command, const wchar_t* text, int32& left, int32& top, int32& right, int32& bottom) override
+		{
+			// dirty region 추적과 같은 영역
+			const PixelRect bounds{ _window.getCommandBounds(command, text) };
+			left = bounds.left;
+			top = bounds.top;
+			right = bounds.right;
+			bottom = bounds.bottom;
+		}
+
+	protected:
+		virtual const Framebuffer* getImage(uint32 imageIndex) const override
+		{
+			if (imageIndex >= static_cast<uint32>(_window._vImages.size()))
+			{
+				return nullptr;
+			}
+			return &_window._vImages[imageIndex].surface;
+		}
+
+		virtual const TextLayout* getTextLayout(uint32 layoutIndex) const override
+		{
+			if (layoutIndex >= static_cast<uint32>(_window._vTextLayouts.size()))
+			{
+				return nullptr;
+			}
+			return &_window._vTextLayouts[layoutIndex].layout;
+		}
+
+		virtual const GlyphAtlas* getGlyphAtlas(uint32 fontIndex) const override
+		{
+			return &_window.findGlyphAtlas(fontIndex);
+		}
+
+		virtual void drawText(Framebuffer& target, const DrawCommand& command, const wchar_t* text) const override
+		{
+			_window.drawTextCommand(target, command, text);
+		}
+
+	private:
+		const IWin32GdiWindow&	_window;
+	};
+
+
+	IWin32GdiWindow::IWin32GdiWindow(float width, float height, ERenderBackend eRenderBackend)
+		: kWidth{ width }, kHeight{ height }, kRenderBackend{ eRenderBackend }
 	{
 		__noop;
 	}
@@ -76,12 +331,20 @@ namespace fs
 	void IWin32GdiWindow::addFont(const std::wstring& fontName, int32 size, bool isKorean)
 	{
 		_vFonts.emplace_back(CreateFont(size, 0, 0, 0, 0, FALSE, FALSE, FALSE, (isKorean == true) ? HANGEUL_CHARSET : 0, 0, 0, 0, 0, fontName.c_str()));
+		_vGlyphAtlases.emplace_back();
 	}
 
 	void IWin32GdiWindow::useFont(uint32 fontIndex) const noexcept
 	{
 		assert(fontIndex < static_cast<uint32>(_vFonts.size()));
 		SelectObject(_backDc, _vFonts[fontIndex]);
+		_currentFontIndex = fontIndex;
+	}
+
+	const GlyphAtlas& IWin32GdiWindow::getGlyphAtlas(uint32 fontIndex) const noexcept
+	{
+		assert(fontIndex < static_cast<uint32>(_vFonts.size()));
+		return prepareGlyphAtlas(fontIndex, {});
 	}
 
 	uint32 IWin32GdiWindow::createImageFromFile(const std::wstring& fileName)
@@ -93,22 +356,63 @@ namespace fs
 		auto pixels = stbi_load(fileNameA, &x, &y, &channelCount, 4);
 		assert(pixels != nullptr);
 
-		HBITMAP bitmap{ CreateBitmap(x, y, 1, channelCount * 8, pixels) };
-		_vImages.emplace_back(bitmap, Size2(static_cast<float>(x), static_cast<float>(y)));
-
+		// stb_image는 RGBA 순서로 읽으므로 GDI와 Framebuffer가 쓰는 BGRA로 바꾼다.
+		Framebuffer surface{ static_cast<uint32>(x), static_cast<uint32>(y) };
+		uint32* const dst{ surface.getPixels() };
+		for (size_t i = 0; i < static_cast<size_t>(x) * y; ++i)
+		{
+			dst[i] = packBgra(pixels[i * 4 + 0], pixels[i * 4 + 1], pixels[i * 4 + 2], pixels[i * 4 + 3]);
+		}
 		stbi_image_free(pixels);
 
+		const Size2 size{ static_cast<float>(x), static_cast<float>(y) };
+		if (kRenderBackend == ERenderBackend::Software)
+		{
+			_vImages.emplace_back();
+			_vImages.back().surface = std::move(surface);
+			_vImages.back().size = size;
+		}
+		else
+		{
+			HBITMAP bitmap{ CreateBitmap(x, y, 1, 32, surface.getPixels()) };
+			_vImages.emplace_back(bitmap, size);
+		}
+
 		return static_cast<uint32>(_vImages.size() - 1);
 	}
 
 	uint32 IWin32GdiWindow::createBlankImage(const Size2& size)
 	{
-		HBITMAP bitmap{ CreateCompatibleBitmap(_backDc, static_cast<int>(size.x), static_cast<int>(size.y)) };
-		_vImages.emplace_back(bitmap, size);
+		// ERenderBackend::Gdi는 bitmap으로, ERenderBackend::Software는 surface로 같은 메모리에 그린다.
+		_vImages.emplace_back();
+		Image& image{ _vImages.back() };
+		const bool bCreated{ image.storage.createDibSection(_backDc, static_cast<uint32>(size.x), static_cast<uint32>(size.y)) };
+		assert(bCreated == true);
+		(void)bCreated;
+		image.bitmap = image.storage.getBitmap();
+		image.surface = image.storage.getFramebuffer();
+		image.size = size;
 
 		return static_cast<uint32>(_vImages.size() - 1);
 	}
 
+	uint32 IWin32GdiWindow::createTextLayout(uint32 fontIndex, std::wstring_view content, const Position2& position, const Size2& area,
+		EHorzAlign eHorzAlign, EVertAlign eVertAlign)
+	{
+		assert(fontIndex < static_cast<uint32>(_vFonts.size()));
+
+		// 배치는 처음 그릴 때 한다. (그 전에 폰트의 atlas가 준비되어 있지 않을 수 있다.)
+		const int32 x{ static_cast<int32>(position.x) };
+		const int32 y{ static_cast<int32>(position.y) };
+		CachedTextLayout cachedTextLayout{};
+		cachedTextLayout.textCommand = DrawCommandList::makeText(fontIndex, x, y, x + static_cast<int32>(area.x), y + static_cast<int32>(area.y), 0,
+			toDrawTextFormat(eHorzAlign, eVertAlign), static_cast<uint32>(content.size()));
+		cachedTextLayout.content = content;
+		_vTextLayouts.emplace_back(std::move(cachedTextLayout));
+
+		return static_cast<uint32>(_vTextLayouts.size() - 1);
+	}
+
 	bool IWin32GdiWindow::update()
 	{
 		MSG msg{};
@@ -131,7 +435,8 @@ namespace fs
 				_fps = _frameCount;
 				_frameCount = 0;
 
-				_fpsWstring = std::to_wstring(_fps);
+				_fpsText.clear();
+				_fpsText.appendInteger(_fps);
 			}
 
 			// Second Tick
@@ -151,20 +456,72 @@ namespace fs
 
 	void IWin32GdiWindow::beginRendering(const Color& clearColor) const noexcept
 	{
+		_clearColor = clearColor.toBgra();
+		if (_bDirtyRegionTracking == true)
+		{
+			// dirty region만 endRendering()에서 지운다.
+			return;
+		}
+
+		if (kRenderBackend == ERenderBackend::Software)
+		{
+			// 지난 프레임에 GDI가 그리던 것을 끝낸 뒤에 CPU로 그린다.
+			GdiFlush();
+			_backBuffer.clear(clearColor.toBgra());
+			return;
+		}
+
 		// 윈도우의 상하좌우를 얻어온다.
 		RECT windowRect{};
 		GetClientRect(_hWnd, &windowRect);
 
 		// _backDc를 clearColor로 클리어
-		HBRUSH brush{ CreateSolidBrush(RGB(clearColor.r * 255, clearColor.g * 255, clearColor.b * 255)) };
+		const HBRUSH brush{ _gdiObjectPool.getBrush(RGB(clearColor.r * 255, clearColor.g * 255, clearColor.b * 255)) };
 		FillRect(_backDc, &windowRect, brush);
-		DeleteObject(brush);
 	}
 
 	void IWin32GdiWindow::endRendering() const noexcept
 	{
+		if (_bDirtyRegionTracking == true)
+		{
+			renderDirtyRegions();
+
+			// 윈도우를 다시 그리도록 명령
+			UpdateWindow(_hWnd);
+
+			// frame 수 증가
+			++_frameCount;
+			return;
+		}
+
+		// 모아 둔 명령들을 상태별로 정렬해 그린다.
+		if (_bDeferredRendering == true)
+		{
+			_drawCommandList.setSortByState(true);
+			if (kRenderBackend == ERenderBackend::Software)
+			{
+				SoftwareCommandExecutor executor{ *this };
+				if (_tileRasterizer != nullptr)
+				{
+					_tileRasterizer->rasterize(_drawCommandList, _backBuffer, executor);
+				}
+				else
+				{
+					_drawCommandList.replay(executor);
+				}
+			}
+			else
+			{
+				GdiCommandExecutor executor{ *this };
+				_drawCommandList.replay(executor);
+			}
+			_drawCommandList.clear();
+		}
+
 		// _backDc를 _frontDc로 복사
 		BitBlt(_frontDc, 0, 0, static_cast<int>(kWidth), static_cast<int>(kHeight), _backDc, 0, 0, SRCCOPY);
+		_presentedPixelCount = static_cast<uint64>(kWidth) * static_cast<uint64>(kHeight);
+		_presentedRectCount = 1;
 
 		// 윈도우를 다시 그리도록 명령
 		UpdateWindow(_hWnd);
@@ -175,52 +532,29 @@ namespace fs
 
 	void IWin32GdiWindow::drawRectangleToScreen(const Position2& position, const Size2& size, const Color& color, uint8 alpha) const noexcept
 	{
-		const LONG width{ static_cast<LONG>(size.x) };
-		const LONG height{ static_cast<LONG>(size.y) };
-		const HBRUSH brush{ CreateSolidBrush(RGB(color.r * 255, color.g * 255, color.b * 255)) };
-
-		if (alpha == 255)
-		{
-			RECT rect{};
-			rect.left = static_cast<LONG>(position.x);
-			rect.right = static_cast<LONG>(rect.left + width);
-			rect.top = static_cast<LONG>(position.y);
-			rect.bottom = static_cast<LONG>(rect.top + height);
-			FillRect(_backDc, &rect, brush);
-		}
-		else
-		{
-			const HBITMAP bitmap{ CreateCompatibleBitmap(_backDc, width, height) };
-			SelectObject(_tempDc, bitmap);
-
-			RECT rect{};
-			rect.left = 0;
-			rect.right = width;
-			rect.top = 0;
-			rect.bottom = height;
-			FillRect(_tempDc, &rect, brush);
-
-			BLENDFUNCTION blend{};
-			blend.BlendOp = AC_SRC_OVER;
-			blend.BlendFlags = 0;
-			blend.AlphaFormat = 0;
-			blend.SourceConstantAlpha = alpha;
-			AlphaBlend(_backDc, static_cast<int>(position.x), static_cast<int>(position.y),
-				static_cast<int>(size.x), static_cast<int>(size.y),
-				_tempDc, 0, 0, rect.right, rect.bottom, blend);
-
-			DeleteObject(bitmap);
-		}
-		DeleteObject(brush);
+		submitCommand(DrawCommandList::makeRectangle(static_cast<int32>(position.x), static_cast<int32>(position.y),
+			static_cast<int32>(size.x), static_cast<int32>(size.y), color.toBgra(), alpha), nullptr);
 	}
 
 	void IWin32GdiWindow::drawRectangleToImage(uint32 imageIndex, const Position2& position, const Size2& size, const Color& color, uint8 alpha)
 	{
 		assert(imageIndex < static_cast<uint32>(_vImages.size()));
 
+		++_vImages[imageIndex].generation;
+
+		// createBlankImage()로 만든 image는 DIB section이므로 GDI 객체 없이 픽셀에 바로 블렌딩한다.
+		if (kRenderBackend == ERenderBackend::Software || (alpha != 255 && _vImages[imageIndex].storage.getBitmap() != nullptr))
+		{
+			// GDI가 이 image에 그리던 것을 먼저 끝낸다.
+			GdiFlush();
+			_vImages[imageIndex].surface.fillRectangle(static_cast<int32>(position.x), static_cast<int32>(position.y),
+				static_cast<int32>(size.x), static_cast<int32>(size.y), color.toBgra(), alpha);
+			return;
+		}
+
 		const LONG width{ static_cast<LONG>(size.x) };
 		const LONG height{ static_cast<LONG>(size.y) };
-		const HBRUSH brush{ CreateSolidBrush(RGB(color.r * 255, color.g * 255, color.b * 255)) };
+		const HBRUSH brush{ _gdiObjectPool.getBrush(RGB(color.r * 255, color.g * 255, color.b * 255)) };
 
 		SelectObject(_tempDc, _vImages[imageIndex].bitmap);
 
@@ -235,16 +569,29 @@ namespace fs
 		}
 		else
 		{
-			const HDC emptyDc{ CreateCompatibleDC(_backDc) };
-			const HBITMAP bitmap{ CreateCompatibleBitmap(_backDc, width, height) };
-			SelectObject(emptyDc, bitmap);
+			// 파일에서 읽은 image (DIB section이 아닌 bitmap)
+			// 지금까지 요청된 가장 큰 크기의 _blendBitmap을 재사용한다.
+			if (_blendBitmapWidth < width || _blendBitmapHeight < height)
+			{
+				_blendBitmapWidth = max(_blendBitmapWidth, width);
+				_blendBitmapHeight = max(_blendBitmapHeight, height);
+				const HBITMAP bitmap{ CreateCompatibleBitmap(_backDc, _blendBitmapWidth, _blendBitmapHeight) };
+				SelectObject(_blendDc, bitmap);
+
+				// 선택이 풀린 이전 비트맵만 삭제할 수 있다.
+				if (_blendBitmap != nullptr)
+				{
+					DeleteObject(_blendBitmap);
+				}
+				_blendBitmap = bitmap;
+			}
 
 			RECT rect{};
 			rect.left = 0;
 			rect.right = width;
 			rect.top = 0;
 			rect.bottom = height;
-			FillRect(emptyDc, &rect, brush);
+			FillRect(_blendDc, &rect, brush);
 
 			BLENDFUNCTION blend{};
 			blend.BlendOp = AC_SRC_OVER;
@@ -253,110 +600,121 @@ namespace fs
 			blend.SourceConstantAlpha = alpha;
 			AlphaBlend(_tempDc, static_cast<int>(position.x), static_cast<int>(position.y),
 				static_cast<int>(size.x), static_cast<int>(size.y),
-				emptyDc, 0, 0, rect.right, rect.bottom, blend);
-
-			DeleteObject(bitmap);
-			DeleteDC(emptyDc);
+				_blendDc, 0, 0, rect.right, rect.bottom, blend);
 		}
-		DeleteObject(brush);
 	}
 
 	void IWin32GdiWindow::drawImageToScreen(uint32 imageIndex, const Position2& position) const noexcept
 	{
-		assert(imageIndex < static_cast<uint32>(_vImages.size()));
-		const auto& image{ _vImages[imageIndex] };
-		SelectObject(_tempDc, image.bitmap);
-
-		BitBlt(_backDc, static_cast<int>(position.x), static_cast<int>(position.y),
-			static_cast<int>(image.size.x), static_cast<int>(image.size.y),
-			_tempDc, 0, 0, SRCCOPY);
+		submitImageCommand(EDrawCommandType::Image, imageIndex, position, 255);
 	}
 	
 	void IWin32GdiWindow::drawImageAlphaToScreen(uint32 imageIndex, const Position2& position) const noexcept
 	{
-		assert(imageIndex < static_cast<uint32>(_vImages.size()));
-		const auto& image{ _vImages[imageIndex] };
-		SelectObject(_tempDc, image.bitmap);
-
-		TransparentBlt(_backDc, static_cast<int>(position.x), static_cast<int>(position.y),
-			static_cast<int>(image.size.x), static_cast<int>(image.size.y),
-			_tempDc, 0, 0, static_cast<int>(image.size.x), static_cast<int>(image.size.y), 0);
+		submitImageCommand(EDrawCommandType::ImageColorKey, imageIndex, position, 255);
 	}
 
 	void IWin32GdiWindow::drawImageAlphaToScreen(uint32 imageIndex, const Position2& position, uint8 alpha) const noexcept
 	{
-		assert(imageIndex < static_cast<uint32>(_vImages.size()));
-		const auto& image{ _vImages[imageIndex] };
-		SelectObject(_tempDc, image.bitmap);
-
-		BLENDFUNCTION blend{};
-		blend.BlendOp = AC_SRC_OVER;
-		blend.BlendFlags = 0;
-		blend.AlphaFormat = 0;
-		blend.SourceConstantAlpha = alpha;
-		AlphaBlend(_backDc, static_cast<int>(position.x), static_cast<int>(position.y),
-			static_cast<int>(image.size.x), static_cast<int>(image.size.y),
-			_tempDc, 0, 0, static_cast<int>(image.size.x), static_cast<int>(image.size.y), blend);
+		submitImageCommand(EDrawCommandType::ImageAlpha, imageIndex, position, alpha);
 	}
 
 	void IWin32GdiWindow::drawImagePrecomputedAlphaToScreen(uint32 imageIndex, const Position2& position) const noexcept
 	{
-		assert(imageIndex < static_cast<uint32>(_vImages.size()));
-		const auto& image{ _vImages[imageIndex] };
-		SelectObject(_tempDc, image.bitmap);
-
-		BLENDFUNCTION blend{};
-		blend.BlendOp = AC_SRC_OVER;
-		blend.BlendFlags = 0;
-		blend.AlphaFormat = AC_SRC_ALPHA;
-		blend.SourceConstantAlpha = 255;
-		AlphaBlend(_backDc, static_cast<int>(position.x), static_cast<int>(position.y),
-			static_cast<int>(image.size.x), static_cast<int>(image.size.y),
-			_tempDc, 0, 0, static_cast<int>(image.size.x), static_cast<int>(image.size.y), blend);
+		submitImageCommand(EDrawCommandType::ImagePremultipliedAlpha, imageIndex, position, 255);
 	}
 
-	void IWin32GdiWindow::drawTextToScreen(const Position2& position, const std::wstring& content, const Color& color) const noexcept
+	void IWin32GdiWindow::drawTextToScreen(const Position2& position, std::wstring_view content, const Color& color) const noexcept
 	{
-		RECT rect{};
-		rect.left = static_cast<LONG>(position.x);
-		rect.top = static_cast<LONG>(position.y);
-		SetTextColor(_backDc, RGB(color.r * 255, color.g * 255, color.b * 255));
-		DrawTextW(_backDc, content.c_str(), static_cast<int>(content.size()), &rect, DT_LEFT | DT_TOP | DT_NOCLIP | DT_SINGLELINE);
+		const int32 x{ static_cast<int32>(position.x) };
+		const int32 y{ static_cast<int32>(position.y) };
+		submitCommand(DrawCommandList::makeText(_currentFontIndex, x, y, x, y, color.toBgra(),
+			DT_LEFT | DT_TOP | DT_NOCLIP | DT_SINGLELINE, static_cast<uint32>(content.size())), content.data());
 	}
 
-	void IWin32GdiWindow::drawTextToScreen(const Position2& position, const Size2& area, const std::wstring& content, const Color& color,
+	void IWin32GdiWindow::drawTextToScreen(const Position2& position, const Size2& area, std::wstring_view content, const Color& color,
 		EHorzAlign eHorzAlign, EVertAlign eVertAlign) const noexcept
 	{
-		UINT HorzAlign{ static_cast<UINT>((eHorzAlign == EHorzAlign::Left) ? DT_LEFT : (eHorzAlign == EHorzAlign::Center) ? DT_CENTER : DT_RIGHT) };
-		UINT VertAlign{ static_cast<UINT>((eVertAlign == EVertAlign::Top) ? DT_TOP : (eVertAlign == EVertAlign::Center) ? DT_VCENTER : DT_BOTTOM) };
+		const int32 x{ static_cast<int32>(position.x) };
+		const int32 y{ static_cast<int32>(position.y) };
+		submitCommand(DrawCommandList::makeText(_currentFontIndex, x, y, x + static_cast<int32>(area.x), y + static_cast<int32>(area.y), color.toBgra(),
+			toDrawTextFormat(eHorzAlign, eVertAlign), static_cast<uint32>(content.size())), content.data());
+	}
+
+	void IWin32GdiWindow::drawTextLayout(uint32 layoutIndex, const Color& color) const noexcept
+	{
+		assert(layoutIndex < static_cast<uint32>(_vTextLayouts.size()));
+		CachedTextLayout& cachedTextLayout{ _vTextLayouts[layoutIndex] };
+		const uint32 fontIndex{ cachedTextLayout.textCommand.resource };
+		if (cachedTextLayout.layout.isValid(findGlyphAtlas(fontIndex)) == false)
+		{
+			// 처음 그리거나 atlas가 바뀌었으면 다시 배치한다.
+			const GlyphAtlas& glyphAtlas{ prepareGlyphAtlas(fontIndex, cachedTextLayout.content) };
+			int32 x{};
+			int32 y{};
+			computeTextOrigin(glyphAtlas, cachedTextLayout.textCommand, cachedTextLayout.content, x, y);
+			cachedTextLayout.layout.build(glyphAtlas, cachedTextLayout.content, x, y);
+		}
 
-		RECT rect{};
-		rect.left = static_cast<LONG>(position.x);
-		rect.top = static_cast<LONG>(position.y);
-		rect.right = rect.left + static_cast<LONG>(area.x);
-		rect.bottom = rect.top + static_cast<LONG>(area.y);
-		SetTextColor(_backDc, RGB(color.r * 255, color.g * 255, color.b * 255));
-		DrawTextW(_backDc, content.c_str(), static_cast<int>(content.size()), &rect, HorzAlign | VertAlign | DT_NOCLIP | DT_SINGLELINE);
+		int32 left{};
+		int32 top{};
+		int32 right{};
+		int32 bottom{};
+		cachedTextLayout.layout.getBounds(left, top, right, bottom);
+		submitCommand(DrawCommandList::makeTextLayout(layoutIndex, fontIndex, left, top, right, bottom, color.toBgra()), nullptr);
 	}
 
 	void IWin32GdiWindow::drawLineToScreen(const Position2& positionA, const Position2& positionB, const Color& color) const noexcept
 	{
-		const HPEN pen{ CreatePen(PS_SOLID, 1, RGB(color.r * 255, color.g * 255, color.b * 255)) };
-		const HPEN prevPen{ (HPEN)SelectObject(_backDc, pen) };
+		submitCommand(makeLineCommand(positionA, positionB, color.toBgra()), nullptr);
+	}
 
-		POINT point{};
-		MoveToEx(_backDc, (int32)positionA.x, (int32)positionA.y, &point);
-		LineTo(_backDc, (int32)positionB.x, (int32)positionB.y);
+	void IWin32GdiWindow::drawLineToScreenNormalized(const Position2& positionA, const Position2& positionB, const Color& color) const noexcept
+	{
+		drawLineToScreen(normalizedToPixel(positionA), normalizedToPixel(positionB), color);
+	}
 
-		SelectObject(_backDc, prevPen);
-		DeleteObject(pen);
+	void IWin32GdiWindow::drawLinesToScreen(std::span<const Position2> endpoints, std::span<const Color> colors) const noexcept
+	{
+		submitLines(endpoints, colors, false);
 	}
 
-	void IWin32GdiWindow::drawLineToScreenNormalized(const Position2& positionA, const Position2& positionB, const Color& color) const noexcept
+	void IWin32GdiWindow::drawLinesToScreenNormalized(std::span<const Position2> endpoints, std::span<const Color> colors) const noexcept
+	{
+		submitLines(endpoints, colors, true);
+	}
+
+	void IWin32GdiWindow::setLineAntialiasing(bool bLineAntialiasing) noexcept
+	{
+		_bLineAntialiasing = bLineAntialiasing;
+	}
+
+	void IWin32GdiWindow::drawPolylineToScreen(std::span<const Position2> points, float width, ELineJoin eJoin, ELineCap eCap, const Color& color,
+		uint8 alpha) const noexcept
+	{
+		if (_bDeferredRendering == true || _bDirtyRegionTracking == true)
+		{
+			_drawCommandList.add(DrawCommandList::makePolyline(points, width, eJoin, eCap, color.toBgra(), alpha), points);
+			return;
+		}
+
+		// 바로 그릴 때는 명령의 영역과 정점 hash가 필요 없으므로 명령을 만들지 않는다.
+		if (kRenderBackend == ERenderBackend::Gdi)
+		{
+			// back buffer(DIB section)에 CPU로 그리기 전에 GDI가 그리던 것을 끝낸다.
+			GdiFlush();
+		}
+		_polylineRasterizer.drawPolyline(_backBuffer, points, width, eJoin, eCap, color.toBgra(), alpha);
+	}
+
+	uint64 IWin32GdiWindow::getPresentedPixelCount() const noexcept
+	{
+		return _presentedPixelCount;
+	}
+
+	uint32 IWin32GdiWindow::getPresentedRectCount() const noexcept
 	{
-		Position2 positionAPixel{ +(positionA.x + 1.0f) * 0.5f * kWidth, -(positionA.y - 1.0f) * 0.5f * kHeight };
-		Position2 positionBPixel{ +(positionB.x + 1.0f) * 0.5f * kWidth, -(positionB.y - 1.0f) * 0.5f * kHeight };
-		drawLineToScreen(positionAPixel, positionBPixel, color);
+		return _presentedRectCount;
 	}
 
 	uint32 IWin32GdiWindow::getFps() const noexcept
@@ -364,9 +722,9 @@ namespace fs
 		return _fps;
 	}
 
-	const std::wstring& IWin32GdiWindow::getFpsWstring() const noexcept
+	std::wstring_view IWin32GdiWindow::getFpsText() const noexcept
 	{
-		return _fpsWstring;
+		return _fpsText.view();
 	}
 
 	float IWin32GdiWindow::getWidth() const noexcept
@@ -379,6 +737,70 @@ namespace fs
 		return kHeight;
 	}
 
+	void IWin32GdiWindow::setDeferredRendering(bool bDeferredRendering) noexcept
+	{
+		_bDeferredRendering = bDeferredRendering;
+	}
+
+	void IWin32GdiWindow::setDrawLayer(uint16 layer) noexcept
+	{
+		_drawCommandList.setLayer(layer);
+	}
+
+	const DrawCommandList& IWin32GdiWindow::getDrawCommandList() const noexcept
+	{
+		return _drawCommandList;
+	}
+
+	void IWin32GdiWindow::setDirtyRegionTracking(bool bDirtyRegionTracking) noexcept
+	{
+		_bDirtyRegionTracking = bDirtyRegionTracking;
+
+		// 추적하지 않던 동안의 내용과 비교하지 않도록 다음 프레임은 전체를 그린다.
+		_dirtyRegionTracker.invalidate();
+	}
+
+	void IWin32GdiWindow::setRasterThreadCount(uint32 threadCount)
+	{
+		if (threadCount == 1)
+		{
+			_tileRasterizer.reset();
+			return;
+		}
+		_tileRasterizer = std::make_unique<TileRasterizer>(threadCount);
+	}
+
+	const GdiObjectPool& IWin32GdiWindow::getGdiObjectPool() const noexcept
+	{
+		return _gdiObjectPool;
+	}
+
+	ERenderBackend IWin32GdiWindow::getRenderBackend() const noexcept
+	{
+		return kRenderBackend;
+	}
+
+	const Framebuffer& IWin32GdiWindow::getFramebuffer() const noexcept
+	{
+		return _backBuffer;
+	}
+
+	Framebuffer& IWin32GdiWindow::getFramebuffer() noexcept
+	{
+		GdiFlush();
+		return _backBuffer;
+	}
+
+	Framebuffer& IWin32GdiWindow::getImageFramebuffer(uint32 imageIndex) noexcept
+	{
+		assert(imageIndex < static_cast<uint32>(_vImages.size()));
+		GdiFlush();
+
+		// 호출한 쪽이 내용을 바꾼다고 본다.
+		++_vImages[imageIndex].generation;
+		return _vImages[imageIndex].surface;
+	}
+
 	bool IWin32GdiWindow::tickInput() const noexcept
 	{
 		if (_bInputTick == true)
@@ -409,6 +831,342 @@ namespace fs
 		return false;
 	}
 
+	void IWin32GdiWindow::submitCommand(const DrawCommand& command, const wchar_t* text) const noexcept
+	{
+		if (_bDeferredRendering == true || _bDirtyRegionTracking == true)
+		{
+			_drawCommandList.add(command, text);
+			return;
+		}
+
+		if (kRenderBackend == ERenderBackend::Software)
+		{
+			SoftwareCommandExecutor executor{ *this };
+			executor.execute(command, text);
+		}
+		else
+		{
+			GdiCommandExecutor executor{ *this };
+			executor.beginStateRun(command);
+			executor.execute(command, text);
+			executor.endReplay();
+		}
+	}
+
+	void IWin32GdiWindow::submitLines(std::span<const Position2> endpoints, std::span<const Color> colors, bool bNormalized) const noexcept
+	{
+		assert(endpoints.size() == colors.size() * 2);
+		const size_t lineCount{ colors.size() };
+
+		if (_bDeferredRendering == true || _bDirtyRegionTracking == true)
+		{
+			// 기록만 한다. (TileRasterizer와 DirtyRegionTracker가 선마다 영역을 나눈다.)
+			for (size_t i = 0; i < lineCount; ++i)
+			{
+				const Position2 positionA{ (bNormalized == true) ? normalizedToPixel(endpoints[i * 2]) : endpoints[i * 2] };
+				const Position2 positionB{ (bNormalized == true) ? normalizedToPixel(endpoints[i * 2 + 1]) : endpoints[i * 2 + 1] };
+				_drawCommandList.add(makeLineCommand(positionA, positionB, colors[i].toBgra()), nullptr);
+			}
+			return;
+		}
+
+		if (kRenderBackend == ERenderBackend::Software)
+		{
+			// 명령과 executor를 거치지 않고 _backBuffer에 바로 그린다.
+			for (size_t i = 0; i < lineCount; ++i)
+			{
+				const Position2 positionA{ (bNormalized == true) ? normalizedToPixel(endpoints[i * 2]) : endpoints[i * 2] };
+				const Position2 positionB{ (bNormalized == true) ? normalizedToPixel(endpoints[i * 2 + 1]) : endpoints[i * 2 + 1] };
+				if (_bLineAntialiasing == true)
+				{
+					_backBuffer.drawLineAntialiased(positionA.x, positionA.y, positionB.x, positionB.y, colors[i].toBgra());
+				}
+				else
+				{
+					_backBuffer.drawLine((int32)positionA.x, (int32)positionA.y, (int32)positionB.x, (int32)positionB.y, colors[i].toBgra());
+				}
+			}
+		}
+		else
+		{
+			// pen은 색이 바뀔 때만 선택한다.
+			GdiCommandExecutor executor{ *this };
+			uint32 prevColor{};
+			for (size_t i = 0; i < lineCount; ++i)
+			{
+				const Position2 positionA{ (bNormalized == true) ? normalizedToPixel(endpoints[i * 2]) : endpoints[i * 2] };
+				const Position2 positionB{ (bNormalized == true) ? normalizedToPixel(endpoints[i * 2 + 1]) : endpoints[i * 2 + 1] };
+				const DrawCommand command{ makeLineCommand(positionA, positionB, colors[i].toBgra()) };
+				if (i == 0 || command.color != prevColor)
+				{
+					executor.beginStateRun(command);
+					prevColor = command.color;
+				}
+				executor.execute(command, nullptr);
+			}
+			executor.endReplay();
+		}
+	}
+
+	DrawCommand IWin32GdiWindow::makeLineCommand(const Position2& positionA, const Position2& positionB, uint32 color) const noexcept
+	{
+		if (_bLineAntialiasing == true)
+		{
+			return DrawCommandList::makeLineAntialiased(positionA.x, positionA.y, positionB.x, positionB.y, color);
+		}
+		return DrawCommandList::makeLine((int32)positionA.x, (int32)positionA.y, (int32)positionB.x, (int32)positionB.y, color);
+	}
+
+	Position2 IWin32GdiWindow::normalizedToPixel(const Position2& position) const noexcept
+	{
+		return Position2{ +(position.x + 1.0f) * 0.5f * kWidth, -(position.y - 1.0f) * 0.5f * kHeight };
+	}
+
+	void IWin32GdiWindow::submitImageCommand(EDrawCommandType eType, uint32 imageIndex, const Position2& position, uint8 alpha) const noexcept
+	{
+		assert(imageIndex < static_cast<uint32>(_vImages.size()));
+		const auto& image{ _vImages[imageIndex] };
+		submitCommand(DrawCommandList::makeImage(eType, imageIndex, static_cast<int32>(position.x), static_cast<int32>(position.y),
+			static_cast<int32>(image.size.x), static_cast<int32>(image.size.y), alpha), nullptr);
+	}
+
+	GlyphAtlas& IWin32GdiWindow::findGlyphAtlas(uint32 fontIndex) const noexcept
+	{
+		return (fontIndex < static_cast<uint32>(_vGlyphAtlases.size())) ? _vGlyphAtlases[fontIndex] : _defaultGlyphAtlas;
+	}
+
+	const GlyphAtlas& IWin32GdiWindow::prepareGlyphAtlas(uint32 fontIndex, std::wstring_view text) const noexcept
+	{
+		const bool bHasFont{ fontIndex < static_cast<uint32>(_vFonts.size()) };
+		GlyphAtlas& glyphAtlas{ findGlyphAtlas(fontIndex) };
+		const bool bFirstUse{ glyphAtlas.getLineHeight() == 0 };
+		if (bFirstUse == false)
+		{
+			bool bComplete{ true };
+			for (const wchar_t codePoint : text)
+			{
+				if (glyphAtlas.findGlyph(codePoint) == nullptr)
+				{
+					bComplete = false;
+					break;
+				}
+			}
+			if (bComplete == true) return glyphAtlas;
+		}
+
+		// 글자는 _tempDc에서 rasterize한다. 폰트를 지정하지 않은 텍스트는 _backDc의 현재 폰트를 쓴다.
+		const HFONT font{ (bHasFont == true) ? _vFonts[fontIndex] : static_cast<HFONT>(GetCurrentObject(_backDc, OBJ_FONT)) };
+		const HGDIOBJ prevFont{ SelectObject(_tempDc, font) };
+		if (bFirstUse == true)
+		{
+			TEXTMETRICW textMetric{};
+			GetTextMetricsW(_tempDc, &textMetric);
+			glyphAtlas.setFontMetrics(max(static_cast<int32>(textMetric.tmHeight), 1), static_cast<int32>(textMetric.tmAscent));
+
+			// 출력 가능한 ASCII는 처음에 한 번에 넣는다.
+			for (wchar_t codePoint = 0x20; codePoint < 0x7F; ++codePoint)
+			{
+				rasterizeGlyph(glyphAtlas, codePoint);
+			}
+		}
+		for (const wchar_t codePoint : text)
+		{
+			if (glyphAtlas.findGlyph(codePoint) == nullptr)
+			{
+				rasterizeGlyph(glyphAtlas, codePoint);
+			}
+		}
+		SelectObject(_tempDc, prevFont);
+		return glyphAtlas;
+	}
+
+	void IWin32GdiWindow::rasterizeGlyph(GlyphAtlas& glyphAtlas, wchar_t codePoint) const noexcept
+	{
+		static constexpr MAT2 kIdentity{ { 0, 1 }, { 0, 0 }, { 0, 0 }, { 0, 1 } };
+		// GGO_GRAY8_BITMAP의 coverage는 0~64이다.
+		static constexpr uint32 kGray8Levels{ 64 };
+
+		GLYPHMETRICS glyphMetrics{};
+		const DWORD bufferSize{ GetGlyphOutlineW(_tempDc, codePoint, GGO_GRAY8_BITMAP, &glyphMetrics, 0, nullptr, &kIdentity) };
+		if (bufferSize == GDI_ERROR)
+		{
+			// 폰트에 없는 글자. 다시 시도하지 않도록 빈 글자로 넣는다.
+			glyphAtlas.addGlyph(codePoint, 0, 0, 0, 0, 0, nullptr, 0);
+			return;
+		}
+
+		const int32 offsetX{ static_cast<int32>(glyphMetrics.gmptGlyphOrigin.x) };
+		const int32 offsetY{ glyphAtlas.getAscent() - static_cast<int32>(glyphMetrics.gmptGlyphOrigin.y) };
+		const int32 advance{ static_cast<int32>(glyphMetrics.gmCellIncX) };
+		if (bufferSize == 0)
+		{
+			// 공백처럼 bitmap이 없는 글자
+			glyphAtlas.addGlyph(codePoint, 0, 0, offsetX, offsetY, advance, nullptr, 0);
+			return;
+		}
+
+		_vGlyphBitmap.resize(bufferSize);
+		GetGlyphOutlineW(_tempDc, codePoint, GGO_GRAY8_BITMAP, &glyphMetrics, bufferSize, _vGlyphBitmap.data(), &kIdentity);
+
+		// 각 행은 4바이트 단위로 맞춰져 있다.
+		const uint32 width{ static_cast<uint32>(glyphMetrics.gmBlackBoxX) };
+		const uint32 height{ static_cast<uint32>(glyphMetrics.gmBlackBoxY) };
+		const uint32 pitch{ (width + 3) & ~3u };
+		for (auto& coverage : _vGlyphBitmap)
+		{
+			coverage = static_cast<uint8>((min(static_cast<uint32>(coverage), kGray8Levels) * 255 + kGray8Levels / 2) / kGray8Levels);
+		}
+		glyphAtlas.addGlyph(codePoint, width, height, offsetX, offsetY, advance, _vGlyphBitmap.data(), pitch);
+	}
+
+	void IWin32GdiWindow::drawTextCommand(Framebuffer& target, const DrawCommand& command, const wchar_t* text) const noexcept
+	{
+		// atlas를 바꾸지 않으므로 타일마다 여러 스레드에서 불려도 된다.
+		const std::wstring_view content{ text, command.textLength };
+		const GlyphAtlas& glyphAtlas{ findGlyphAtlas(command.resource) };
+
+		int32 x{};
+		int32 y{};
+		computeTextOrigin(glyphAtlas, command, content, x, y);
+		glyphAtlas.drawText(target, x, y, content, command.color);
+	}
+
+	void IWin32GdiWindow::drawTextLayoutCommand(Framebuffer& target, const DrawCommand& command) const noexcept
+	{
+		assert(command.resource < static_cast<uint32>(_vTextLayouts.size()));
+		_vTextLayouts[command.resource].layout.draw(target, findGlyphAtlas(command.param), command.color);
+	}
+
+	void IWin32GdiWindow::renderDirtyRegions() const noexcept
+	{
+		// 그리는 순서대로 영역과 hash를 등록해서 지난 프레임과 달라진 곳을 찾는다.
+		// 상태별 정렬은 지연 렌더링일 때만 한다. 즉시 렌더링은 dirty region 추적을 켜도 그린 순서 그대로 그려야 한다.
+		_drawCommandList.setSortByState(_bDeferredRendering);
+		_drawCommandList.sort();
+		_dirtyRegionTracker.beginFrame(static_cast<uint32>(kWidth), static_cast<uint32>(kHeight), _clearColor);
+		const uint32 commandCount{ _drawCommandList.getCommandCount() };
+		for (uint32 order = 0; order < commandCount; ++order)
+		{
+			const DrawCommand& command{ _drawCommandList.getCommand(_drawCommandList.getSortedIndex(order)) };
+			const wchar_t* const text{ _drawCommandList.getText(command) };
+			uint64 hash{ DrawCommandList::computeHash(command, text) };
+			if (command.eType == EDrawCommandType::TextLayout)
+			{
+				// 영역이 같아도 폰트의 atlas가 바뀌었으면 다시 그린다.
+				hash = DirtyRegionTracker::combineHash(hash, findGlyphAtlas(command.param).getGeneration());
+			}
+			else if (command.eType != EDrawCommandType::Rectangle && command.eType != EDrawCommandType::Line && command.eType != EDrawCommandType::Text
+				&& command.eType != EDrawCommandType::Polyline && command.resource < static_cast<uint32>(_vImages.size()))
+			{
+				// 명령이 같아도 이미지 내용이 바뀌었으면 다시 그린다.
+				hash = DirtyRegionTracker::combineHash(hash, _vImages[command.resource].generation);
+			}
+			_dirtyRegionTracker.addDraw(getCommandBounds(command, text), hash);
+		}
+		_dirtyRegionTracker.endFrame();
+
+		const std::vector<PixelRect>& vDirtyRects{ _dirtyRegionTracker.getDirtyRects() };
+		_presentedPixelCount = _dirtyRegionTracker.getDirtyPixelCount();
+		_presentedRectCount = static_cast<uint32>(vDirtyRects.size());
+		if (vDirtyRects.empty() == true)
+		{
+			_drawCommandList.clear();
+			return;
+		}
+
+		// GDI로 그리는 것은 모두 dirty region 안으로 clip한다.
+		const HRGN region{ CreateRectRgn(0, 0, 0, 0) };
+		for (const auto& dirtyRect : vDirtyRects)
+		{
+			const HRGN rectRegion{ CreateRectRgn(dirtyRect.left, dirtyRect.top, dirtyRect.right, dirtyRect.bottom) };
+			CombineRgn(region, region, rectRegion, RGN_OR);
+			DeleteObject(rectRegion);
+		}
+		// SelectClipRgn()은 region을 복사한다.
+		SelectClipRgn(_backDc, region);
+		DeleteObject(region);
+
+		if (kRenderBackend == ERenderBackend::Software)
+		{
+			// 지난 프레임의 텍스트를 GDI가 다 그린 뒤에 CPU로 그린다.
+			GdiFlush();
+
+			SoftwareCommandExecutor executor{ *this };
+			for (const auto& dirtyRect : vDirtyRects)
+			{
+				_backBuffer.setClipRectangle(dirtyRect.left, dirtyRect.top, dirtyRect.right, dirtyRect.bottom);
+				_backBuffer.clear(_clearColor);
+				for (uint32 order = 0; order < commandCount; ++order)
+				{
+					const DrawCommand& command{ _drawCommandList.getCommand(_drawCommandList.getSortedIndex(order)) };
+					if (command.eType == EDrawCommandType::Text)
+					{
+						// 글자는 위에서 getCommandBounds()가 atlas에 준비해 두었다. 다른 명령과 같은 순서로 그리고, clip rectangle 밖은 잘린다.
+						executor.executeOn(_backBuffer, command, {}, _drawCommandList.getText(command));
+						continue;
+					}
+
+					int32 left{};
+					int32 top{};
+					int32 right{};
+					int32 bottom{};
+					DrawCommandList::computeBounds(command, left, top, right, bottom);
+					if (right <= dirtyRect.left || dirtyRect.right <= left || bottom <= dirtyRect.top || dirtyRect.bottom <= top) continue;
+
+					executor.executeOn(_backBuffer, command, _drawCommandList.getPoints(command));
+				}
+			}
+			_backBuffer.resetClipRectangle();
+		}
+		else
+		{
+			const HBRUSH brush{ _gdiObjectPool.getBrush(toColorref(_clearColor)) };
+			for (const auto& dirtyRect : vDirtyRects)
+			{
+				const RECT rect{ dirtyRect.left, dirtyRect.top, dirtyRect.right, dirtyRect.bottom };
+				FillRect(_backDc, &rect, brush);
+			}
+
+			GdiCommandExecutor executor{ *this };
+			executor.setClipRects(vDirtyRects);
+			_drawCommandList.replay(executor);
+		}
+		SelectClipRgn(_backDc, nullptr);
+		_drawCommandList.clear();
+
+		// dirty region만 _frontDc로 복사
+		for (const auto& dirtyRect : vDirtyRects)
+		{
+			BitBlt(_frontDc, dirtyRect.left, dirtyRect.top, dirtyRect.right - dirtyRect.left, dirtyRect.bottom - dirtyRect.top,
+				_backDc, dirtyRect.left, dirtyRect.top, SRCCOPY);
+		}
+	}
+
+	PixelRect IWin32GdiWindow::getCommandBounds(const DrawCommand& command, const wchar_t* text) const noexcept
+	{
+		PixelRect bounds{};
+		DrawCommandList::computeBounds(command, bounds.left, bounds.top, bounds.right, bounds.bottom);
+		if (command.eType != EDrawCommandType::Text)
+		{
+			return bounds;
+		}
+
+		// 글자는 atlas에서 복사하므로 atlas의 글자 크기로 정확히 잴 수 있다. (DT_NOCLIP이므로 영역을 넘칠 수 있다.)
+		const std::wstring_view content{ text, command.textLength };
+		const GlyphAtlas& glyphAtlas{ prepareGlyphAtlas(command.resource, content) };
+		int32 x{};
+		int32 y{};
+		computeTextOrigin(glyphAtlas, command, content, x, y);
+
+		PixelRect textBounds{};
+		glyphAtlas.computeTextBounds(content, textBounds.left, textBounds.top, textBounds.right, textBounds.bottom);
+		bounds.left = min(bounds.left, x + textBounds.left);
+		bounds.top = min(bounds.top, y + textBounds.top);
+		bounds.right = max(bounds.right, x + textBounds.right);
+		bounds.bottom = max(bounds.bottom, y + textBounds.bottom);
+		return bounds;
+	}
+
 	void IWin32GdiWindow::initialize()
 	{
 		// 현재 윈도우의 기본 Device Context를 얻어온다.
@@ -427,9 +1185,16 @@ namespace fs
 		SetBkMode(_backDc, TRANSPARENT);
 		SetBkMode(_tempDc, TRANSPARENT);
 
-		// _backDc에서 사용할 비트맵을 생성하고, 설정한다.
-		_backDcBitmap = CreateCompatibleBitmap(_frontDc, static_cast<int>(kWidth), static_cast<int>(kHeight));
-		SelectObject(_backDc, _backDcBitmap);
+		// 파일에서 읽은 image에 alpha < 255로 사각형을 그릴 때 쓰는 DC. 비트맵은 처음 필요할 때 만든다.
+		_blendDc = CreateCompatibleDC(_backDc);
+
+		// _backDc에서 사용할 top-down 32비트 DIB section을 생성하고, 설정한다.
+		// GDI와 CPU(_backBuffer)가 같은 메모리에 그리므로 출력할 때 복사가 한 번(BitBlt)뿐이다.
+		const bool bCreated{ _backBufferStorage.createDibSection(_frontDc, static_cast<uint32>(kWidth), static_cast<uint32>(kHeight)) };
+		assert(bCreated == true);
+		(void)bCreated;
+		SelectObject(_backDc, _backBufferStorage.getBitmap());
+		_backBuffer = _backBufferStorage.getFramebuffer();
 
 		// fps 타이머를 설정한다.
 		_secondTimer.set(1000, Timer::EUnit::_2_Millisecond);
@@ -442,20 +1207,42 @@ namespace fs
 
 	void IWin32GdiWindow::uninitialize()
 	{
-		for (auto& image : _vImages)
-		{
-			DeleteObject(image.bitmap);
-		}
 		for (auto& font : _vFonts)
 		{
 			DeleteObject(font);
 		}
-		DeleteObject(_backDcBitmap);
+		_vGlyphAtlases.clear();
+		_vTextLayouts.clear();
+		_defaultGlyphAtlas.clear();
+		_gdiObjectPool.clear();
 
 		// CreateCompatibleDC() <> DeleteDC()
+		DeleteDC(_blendDc);
 		DeleteDC(_tempDc);
 		DeleteDC(_backDc);
 
+		// CreateCompatibleBitmap() <> DeleteObject()
+		if (_blendBitmap != nullptr)
+		{
+			DeleteObject(_blendBitmap);
+			_blendBitmap = nullptr;
+		}
+		_blendBitmapWidth = 0;
+		_blendBitmapHeight = 0;
+
+		// DC에 선택된 비트맵은 삭제되지 않으므로 DC를 먼저 삭제한다.
+		for (auto& image : _vImages)
+		{
+			// DIB section은 storage가 해제한다.
+			if (image.storage.getBitmap() == nullptr)
+			{
+				DeleteObject(image.bitmap);
+			}
+		}
+		_vImages.clear();
+		_backBuffer = Framebuffer();
+		_backBufferStorage.destroy();
+
 		// GetDC() <> ReleaseDC()
 		ReleaseDC(_hWnd, _frontDc);
 	}
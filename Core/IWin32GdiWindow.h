@@ -8,10 +8,22 @@
 
 #include <Core/_CommonTypes.h>
 #include <Core/Float2.h>
+#include <Core/Framebuffer.h>
+#include <Core/PixelStorage.h>
+#include <Core/DrawCommandList.h>
+#include <Core/PolylineRasterizer.h>
+#include <Core/DirtyRegionTracker.h>
+#include <Core/FixedWstring.h>
+#include <Core/GdiObjectPool.h>
+#include <Core/GlyphAtlas.h>
+#include <Core/TextLayout.h>
+#include <Core/TileRasterizer.h>
 
 #include <Utilities/Timer.h>
 
+#include <span>
 #include <string>
+#include <string_view>
 
 
 namespace fs
@@ -84,6 +96,12 @@ namespace fs
 			b -= o.b;
 			return *this;
 		}
+
+		// Framebuffer용 32비트 BGRA. GDI의 RGB()와 같은 방식으로 변환한다.
+		constexpr uint32 toBgra() const
+		{
+			return packBgra(static_cast<uint8>(r * 255), static_cast<uint8>(g * 255), static_cast<uint8>(b * 255));
+		}
 	};
 
 
@@ -97,8 +115,22 @@ namespace fs
 		{
 			__noop;
 		}
-		HBITMAP	bitmap{};
-		Size2	size{};
+		PixelStorage	storage{};	// createBlankImage(): DIB section. bitmap과 surface가 이 메모리를 가리킨다.
+		HBITMAP			bitmap{};	// ERenderBackend::Gdi
+		Framebuffer		surface{};	// ERenderBackend::Software
+		Size2			size{};
+		uint32			generation{};	// 내용이 바뀔 때마다 증가한다. (dirty region 추적용)
+	};
+
+
+	enum class ERenderBackend
+	{
+		// 모든 그리기를 GDI로 처리한다.
+		Gdi,
+
+		// 모든 그리기를 CPU의 Framebuffer에서 처리하고, GDI는 화면에 출력할 때만 사용한다.
+		// (텍스트는 GDI로 만든 glyph atlas에서 복사한다.)
+		Software,
 	};
 
 
@@ -120,7 +152,7 @@ namespace fs
 	class IWin32GdiWindow
 	{
 	public:
-		IWin32GdiWindow(float width, float height);
+		IWin32GdiWindow(float width, float height, ERenderBackend eRenderBackend = ERenderBackend::Software);
 		virtual ~IWin32GdiWindow();
 
 	public:
@@ -138,12 +170,24 @@ namespace fs
 		void addFont(const std::wstring& fontName, int32 size, bool isKorean);
 		void useFont(uint32 fontIndex) const noexcept;
 
+		// 폰트의 glyph atlas. 두 backend 모두 텍스트는 GDI로 그리지 않고 이 atlas에서 back buffer로 복사한다.
+		// 출력 가능한 ASCII는 처음 쓸 때 한 번에, 나머지 글자는 처음 그릴 때 rasterize해 넣는다.
+		// saveToFile()로 저장해 두면 Windows 없이 GlyphAtlas::loadFromFile()로 같은 글자를 그릴 수 있다.
+		const GlyphAtlas& getGlyphAtlas(uint32 fontIndex) const noexcept;
+
 		// image의 index를 리턴함.
 		uint32 createImageFromFile(const std::wstring& fileName);
 
 		// image의 index를 리턴함.
+		// 두 backend 모두 top-down 32비트 DIB section으로 만들므로, getImageFramebuffer()로 픽셀에 직접 그릴 수 있다.
 		uint32 createBlankImage(const Size2& size);
 
+		// text layout의 index를 리턴함.
+		// 바뀌지 않는 문자열을 위해 글자들의 위치와 영역을 미리 계산해 둔다. 정렬은 drawTextToScreen()과 같다.
+		// 처음 그릴 때와 폰트의 glyph atlas가 바뀌었을 때만 다시 배치한다.
+		uint32 createTextLayout(uint32 fontIndex, std::wstring_view content, const Position2& position, const Size2& area,
+			EHorzAlign eHorzAlign, EVertAlign eVertAlign);
+
 	public:
 		virtual bool update();
 
@@ -162,17 +206,66 @@ namespace fs
 		void drawImageAlphaToScreen(uint32 imageIndex, const Position2& position) const noexcept;
 		void drawImageAlphaToScreen(uint32 imageIndex, const Position2& position, uint8 alpha) const noexcept;
 		void drawImagePrecomputedAlphaToScreen(uint32 imageIndex, const Position2& position) const noexcept;
-		void drawTextToScreen(const Position2& position, const std::wstring& content, const Color& color) const noexcept;
-		void drawTextToScreen(const Position2& position, const Size2& area, const std::wstring& content, const Color& color,
+		// content는 null 종료되지 않아도 된다. 문자열 상수, std::wstring, FixedWstring::view() 모두 복사 없이 넘길 수 있다.
+		void drawTextToScreen(const Position2& position, std::wstring_view content, const Color& color) const noexcept;
+		void drawTextToScreen(const Position2& position, const Size2& area, std::wstring_view content, const Color& color,
 			EHorzAlign eHorzAlign, EVertAlign eVertAlign) const noexcept;
+		// 미리 배치해 둔 글자들을 복사만 한다. (측정, 정렬 계산 없음)
+		void drawTextLayout(uint32 layoutIndex, const Color& color) const noexcept;
 		void drawLineToScreen(const Position2& positionA, const Position2& positionB, const Color& color) const noexcept;
 		void drawLineToScreenNormalized(const Position2& positionA, const Position2& positionB, const Color& color) const noexcept;
 
+		// 선 여러 개를 한 번에 그린다. endpoints는 선마다 (A, B) 두 개씩, colors는 선마다 하나씩이다.
+		// ERenderBackend::Software의 즉시 렌더링에서는 명령을 만들지 않고 back buffer에 바로 그린다.
+		void drawLinesToScreen(std::span<const Position2> endpoints, std::span<const Color> colors) const noexcept;
+		void drawLinesToScreenNormalized(std::span<const Position2> endpoints, std::span<const Color> colors) const noexcept;
+
+		// true이면 이후의 선을 anti-aliasing(Xiaolin Wu)으로 그린다. ERenderBackend::Gdi에서는 무시된다.
+		void setLineAntialiasing(bool bLineAntialiasing) noexcept;
+
+		// 두께가 있는 polyline을 anti-aliasing하여 그린다. points는 연속된 정점 배열 (픽셀 좌표)
+		// 정점이 아무리 많아도 명령 하나로 그려진다. 두 backend 모두 pen 없이 back buffer에 CPU로 그린다.
+		void drawPolylineToScreen(std::span<const Position2> points, float width, ELineJoin eJoin, ELineCap eCap, const Color& color,
+			uint8 alpha = 255) const noexcept;
+
+	public:
+		// true이면 draw...ToScreen()은 명령만 기록하고, endRendering()에서 상태별로 정렬해 한 번에 그린다.
+		// @주의: 이미지는 endRendering() 시점의 내용으로 그려진다.
+		void setDeferredRendering(bool bDeferredRendering) noexcept;
+
+		// 지연 렌더링에서 layer가 작은 것이 먼저 그려진다. 같은 layer 안에서는 그리는 순서가 바뀔 수 있다.
+		void setDrawLayer(uint16 layer) noexcept;
+
+		const DrawCommandList& getDrawCommandList() const noexcept;
+
+		// true이면 지난 프레임과 달라진 영역(dirty region)만 지우고, 다시 그리고, 화면에 출력한다. (변화가 적은 화면용)
+		// draw...ToScreen()은 setDeferredRendering()과 관계없이 기록되고 endRendering()에서 그려진다.
+		// 지연 렌더링이 아니면 상태별로 정렬하지 않고 호출한 순서 그대로 그린다.
+		// @주의: getFramebuffer()로 직접 그린 내용은 추적하지 않는다.
+		void setDirtyRegionTracking(bool bDirtyRegionTracking) noexcept;
+
+		// ERenderBackend::Software의 지연 렌더링을 몇 개의 스레드로 타일 단위로 나누어 그릴지 정한다.
+		// 1이면 (기본값) 호출한 스레드에서 그대로 그리고, 0이면 하드웨어 스레드 수만큼 사용한다.
+		void setRasterThreadCount(uint32 threadCount);
+
 	public:
 		uint32 getFps() const noexcept;
-		const std::wstring& getFpsWstring() const noexcept;
+		// 마지막으로 잰 FPS의 숫자 문자열. 1초마다 고정 크기 버퍼에 다시 쓰므로 할당이 없다.
+		std::wstring_view getFpsText() const noexcept;
+		// 마지막 endRendering()에서 화면에 출력한 픽셀 수와 직사각형 수 (dirty region 추적을 끄면 전체 화면 하나)
+		uint64 getPresentedPixelCount() const noexcept;
+		uint32 getPresentedRectCount() const noexcept;
 		float getWidth() const noexcept;
 		float getHeight() const noexcept;
+		// ERenderBackend::Gdi에서 사용하는 brush/pen pool. (hit/miss 카운터 확인용)
+		const GdiObjectPool& getGdiObjectPool() const noexcept;
+		ERenderBackend getRenderBackend() const noexcept;
+		// back buffer. 두 backend 모두 화면에 출력되는 DIB section 메모리를 그대로 가리키므로, 여기에 그린 내용은 복사 없이 출력된다.
+		const Framebuffer& getFramebuffer() const noexcept;
+		// GDI가 아직 처리하지 않은 그리기를 먼저 끝낸다. (GdiFlush())
+		Framebuffer& getFramebuffer() noexcept;
+		// createBlankImage()로 만든 image의 픽셀 (GdiFlush()를 먼저 호출한다.)
+		Framebuffer& getImageFramebuffer(uint32 imageIndex) noexcept;
 		bool tickInput() const noexcept;
 		bool isKeyPressed(int keyCode) const noexcept;
 		bool isKeyDown(int keyCode) const noexcept;
@@ -185,27 +278,98 @@ namespace fs
 		// 사용한 리소스를 해제한다.
 		void uninitialize();
 
+	private:
+		class GdiCommandExecutor;
+		class SoftwareCommandExecutor;
+
+		// 지연 렌더링이면 기록하고, 아니면 바로 실행한다.
+		void submitCommand(const DrawCommand& command, const wchar_t* text) const noexcept;
+		void submitImageCommand(EDrawCommandType eType, uint32 imageIndex, const Position2& position, uint8 alpha) const noexcept;
+		void submitLines(std::span<const Position2> endpoints, std::span<const Color> colors, bool bNormalized) const noexcept;
+		DrawCommand makeLineCommand(const Position2& positionA, const Position2& positionB, uint32 color) const noexcept;
+		// [-1, 1] x [-1, 1] (y는 위쪽이 +) -> 픽셀 좌표
+		Position2 normalizedToPixel(const Position2& position) const noexcept;
+
+	private:
+		// fontIndex가 폰트가 아니면 _backDc의 현재 폰트로 만든 atlas
+		GlyphAtlas& findGlyphAtlas(uint32 fontIndex) const noexcept;
+		// text의 글자들이 모두 들어 있는 atlas. fontIndex가 폰트가 아니면 _backDc의 현재 폰트로 만든 atlas
+		const GlyphAtlas& prepareGlyphAtlas(uint32 fontIndex, std::wstring_view text) const noexcept;
+		// _tempDc에 선택된 폰트로 글자 하나를 rasterize해 넣는다.
+		void rasterizeGlyph(GlyphAtlas& glyphAtlas, wchar_t codePoint) const noexcept;
+		// prepareGlyphAtlas()로 글자를 먼저 준비해야 한다. atlas를 바꾸지 않는다.
+		void drawTextCommand(Framebuffer& target, const DrawCommand& command, const wchar_t* text) const noexcept;
+		void drawTextLayoutCommand(Framebuffer& target, const DrawCommand& command) const noexcept;
+
+	private:
+		struct CachedTextLayout
+		{
+			// 폰트, 영역, 정렬 (Text 명령 형식)
+			DrawCommand		textCommand{};
+			std::wstring	content{};
+			TextLayout		layout{};
+		};
+
+	private:
+		// 달라진 영역만 지우고 다시 그린 뒤 출력한다.
+		void renderDirtyRegions() const noexcept;
+
+		// 명령이 그리는 영역. Text는 glyph atlas로 글자 크기를 잰다.
+		PixelRect getCommandBounds(const DrawCommand& command, const wchar_t* text) const noexcept;
+
 	protected:
 		static constexpr uint32	kFpsBufferSize{ 20 };
 		const float				kWidth{ 800 };
 		const float				kHeight{ 600 };
+		const ERenderBackend	kRenderBackend{ ERenderBackend::Software };
 
 	private:
 		HWND					_hWnd{};
 		HDC						_frontDc{};
 		HDC						_backDc{};
-		HBITMAP					_backDcBitmap{};
 		HDC						_tempDc{};
+		// drawRectangleToImage()가 재사용하는 비트맵. 지금까지 요청된 가장 큰 크기이다.
+		HDC						_blendDc{};
+		HBITMAP					_blendBitmap{};
+		LONG					_blendBitmapWidth{};
+		LONG					_blendBitmapHeight{};
+		mutable GdiObjectPool	_gdiObjectPool{};
+
+	private:
+		// _backDc에 선택된 DIB section. _backBuffer는 이 메모리의 view이다.
+		PixelStorage			_backBufferStorage{};
+		mutable Framebuffer		_backBuffer{};
+		// 기록하지 않고 바로 그리는 polyline의 누적 버퍼. 프레임마다 재사용한다.
+		mutable PolylineRasterizer	_polylineRasterizer{};
+
+	private:
+		bool					_bDeferredRendering{ false };
+		bool					_bLineAntialiasing{ false };
+		mutable DrawCommandList	_drawCommandList{};
+		std::unique_ptr<TileRasterizer>	_tileRasterizer{};
+
+	private:
+		bool					_bDirtyRegionTracking{ false };
+		mutable DirtyRegionTracker	_dirtyRegionTracker{};
+		mutable uint32			_clearColor{};
+		mutable uint64			_presentedPixelCount{};
+		mutable uint32			_presentedRectCount{};
 
 	private:
 		std::vector<HFONT>		_vFonts{};
+		mutable uint32			_currentFontIndex{ kUint32Max };
+		// _vFonts와 같은 순서
+		mutable std::vector<GlyphAtlas>	_vGlyphAtlases{};
+		mutable GlyphAtlas		_defaultGlyphAtlas{};
+		mutable std::vector<uint8>	_vGlyphBitmap{};
+		mutable std::vector<CachedTextLayout>	_vTextLayouts{};
 		std::vector<Image>		_vImages{};
 
 	private:
 		Timer					_secondTimer{};
 		mutable uint32			_frameCount{};
 		uint32					_fps{};
-		std::wstring			_fpsWstring{};
+		FixedWstring<kFpsBufferSize>	_fpsText{};
 		mutable bool			_bSecondTick{ false };
 
 	private:
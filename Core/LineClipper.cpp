@@ -0,0 +1,127 @@
+﻿#include "LineClipper.h"
+
+#include <xmmintrin.h>
+
+
+namespace fs
+{
+	uint8 LineClipper::computeOutcode(const Float4& v) noexcept
+	{
+		const float x{ v.getX() };
+		const float y{ v.getY() };
+		const float z{ v.getZ() };
+		const float w{ v.getW() };
+
+		uint8 outcode{};
+		if (x < -w) outcode |= kLeft;
+		if (y < -w) outcode |= kBottom;
+		if (x > +w) outcode |= kRight;
+		if (y > +w) outcode |= kTop;
+		if (z > +w) outcode |= kFar;
+		if (z < 0) outcode |= kNear;
+		return outcode;
+	}
+
+	void LineClipper::computeOutcodes(const Float4* vertices, uint8* outcodes, size_t count) noexcept
+	{
+		static_assert(sizeof(Float4) == sizeof(__m128), "Float4 must be tightly packed.");
+
+		const float* const data{ reinterpret_cast<const float*>(vertices) };
+		const __m128 zero{ _mm_setzero_ps() };
+		for (size_t i = 0; i < count; ++i)
+		{
+			// all six tests at once: (x, y, z, w) against (-w, -w, -, -), (+w, +w, +w, -) and (-, -, 0, -)
+			const __m128 v{ _mm_loadu_ps(data + i * 4) };
+			const __m128 w{ _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)) };
+			const int32 less{ _mm_movemask_ps(_mm_cmplt_ps(v, _mm_sub_ps(zero, w))) & 0x3 };
+			const int32 greater{ _mm_movemask_ps(_mm_cmpgt_ps(v, w)) & 0x7 };
+			const int32 nearPlane{ (_mm_movemask_ps(_mm_cmplt_ps(v, zero)) >> 2) & 0x1 };
+			outcodes[i] = static_cast<uint8>(less | (greater << 2) | (nearPlane << 5));
+		}
+	}
+
+	bool LineClipper::clipLine(Float4& a, Float4& b, uint8 outcodeA, uint8 outcodeB) noexcept
+	{
+		// both outside of the same plane
+		if ((outcodeA & outcodeB) != 0) return false;
+
+		// both inside
+		if ((outcodeA | outcodeB) == 0) return true;
+
+		// signed distances to each plane (inside if >= 0)
+		const float ax{ a.getX() }, ay{ a.getY() }, az{ a.getZ() }, aw{ a.getW() };
+		const float bx{ b.getX() }, by{ b.getY() }, bz{ b.getZ() }, bw{ b.getW() };
+		const float distanceA[6]{ aw + ax, aw + ay, aw - ax, aw - ay, aw - az, az };
+		const float distanceB[6]{ bw + bx, bw + by, bw - bx, bw - by, bw - bz, bz };
+
+		float t0{ 0.0f };
+		float t1{ 1.0f };
+		const uint8 outcodeUnion{ static_cast<uint8>(outcodeA | outcodeB) };
+		for (uint32 plane = 0; plane < 6; ++plane)
+		{
+			if ((outcodeUnion & (1 << plane)) == 0) continue;
+
+			const float dA{ distanceA[plane] };
+			const float dB{ distanceB[plane] };
+			const float t{ dA / (dA - dB) };
+			if (dA < 0)
+			{
+				// entering
+				if (t > t0) t0 = t;
+			}
+			else
+			{
+				// leaving
+				if (t < t1) t1 = t;
+			}
+			if (t0 > t1) return false;
+		}
+
+		const Float4 direction{ b - a };
+		if (t1 < 1.0f)
+		{
+			b = a + direction * t1;
+		}
+		if (t0 > 0.0f)
+		{
+			a = a + direction * t0;
+		}
+		return true;
+	}
+
+	template <typename Index>
+	static uint32 clipIndexedLines(const Float4* vertices, const uint8* outcodes, const Index* indices, uint32 lineCount, ClippedLine* out) noexcept
+	{
+		uint32 visibleCount{};
+		for (uint32 lineIndex = 0; lineIndex < lineCount; ++lineIndex)
+		{
+			const uint32 indexA{ indices[lineIndex * 2 + 0] };
+			const uint32 indexB{ indices[lineIndex * 2 + 1] };
+
+			// trivial reject without touching the vertices
+			if ((outcodes[indexA] & outcodes[indexB]) != 0) continue;
+
+			Float4 a{ vertices[indexA] };
+			Float4 b{ vertices[indexB] };
+			if (LineClipper::clipLine(a, b, outcodes[indexA], outcodes[indexB]) == false) continue;
+
+			// perspective divide (w > 0 inside the frustum)
+			ClippedLine& clippedLine{ out[visibleCount] };
+			clippedLine.a = Float2(a.getX() / a.getW(), a.getY() / a.getW());
+			clippedLine.b = Float2(b.getX() / b.getW(), b.getY() / b.getW());
+			clippedLine.lineIndex = lineIndex;
+			++visibleCount;
+		}
+		return visibleCount;
+	}
+
+	uint32 LineClipper::clipLines(const Float4* vertices, const uint8* outcodes, const uint16* indices, uint32 lineCount, ClippedLine* out) noexcept
+	{
+		return clipIndexedLines(vertices, outcodes, indices, lineCount, out);
+	}
+
+	uint32 LineClipper::clipLines(const Float4* vertices, const uint8* outcodes, const uint32* indices, uint32 lineCount, ClippedLine* out) noexcept
+	{
+		return clipIndexedLines(vertices, outcodes, indices, lineCount, out);
+	}
+}
@@ -0,0 +1,60 @@
+﻿#pragma once
+
+
+#ifndef FS_LINE_CLIPPER_H
+#define FS_LINE_CLIPPER_H
+// === HEADER BEGINS ===
+
+
+#include <Core/Float2.h>
+#include <Core/Float4.h>
+
+
+namespace fs
+{
+	// A visible part of a line, after the perspective divide (normalized device coordinates)
+	struct ClippedLine
+	{
+		Float2	a{};
+		Float2	b{};
+		uint32	lineIndex{};
+	};
+
+	// Clips lines in homogeneous clip space against the six planes of the view frustum,
+	// before the perspective divide. (Float4x4::projectionMatrixPerspective())
+	// -w <= x <= w
+	// -w <= y <= w
+	//  0 <= z <= w
+	class LineClipper final
+	{
+	public:
+		// Cohen-Sutherland outcode. 0 means the vertex is inside the frustum.
+		enum EOutcode : uint8
+		{
+			kLeft	= 1 << 0,	// x < -w
+			kBottom	= 1 << 1,	// y < -w
+			kRight	= 1 << 2,	// x > +w
+			kTop	= 1 << 3,	// y > +w
+			kFar	= 1 << 4,	// z > +w
+			kNear	= 1 << 5,	// z < 0
+		};
+
+	public:
+		static uint8			computeOutcode(const Float4& v) noexcept;
+		static void				computeOutcodes(const Float4* vertices, uint8* outcodes, size_t count) noexcept;
+
+		// Liang-Barsky. Moves a and b onto the frustum if needed.
+		// Returns false if no part of the line is inside the frustum.
+		static bool				clipLine(Float4& a, Float4& b, uint8 outcodeA, uint8 outcodeB) noexcept;
+
+		// Clips the lines (vertices[indices[2i]], vertices[indices[2i + 1]]) for i in [0, lineCount) and writes only the visible ones.
+		// outcodes must come from computeOutcodes(vertices). out must have room for lineCount lines.
+		// Returns the number of lines written.
+		static uint32			clipLines(const Float4* vertices, const uint8* outcodes, const uint16* indices, uint32 lineCount, ClippedLine* out) noexcept;
+		static uint32			clipLines(const Float4* vertices, const uint8* outcodes, const uint32* indices, uint32 lineCount, ClippedLine* out) noexcept;
+	};
+}
+
+
+// === HEADER ENDS ===
+#endif // !FS_LINE_CLIPPER_H
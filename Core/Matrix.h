@@ -0,0 +1,469 @@
+﻿#pragma once
+
+
+#ifndef FS_MATRIX_H
+#define FS_MATRIX_H
+// === HEADER BEGINS ===
+
+
+#include <Core/_CommonTypes.h>
+#include <immintrin.h>
+#include <type_traits>
+#include <utility>
+
+
+namespace fs
+{
+	// function(0), function(1), ..., function(N - 1) without a loop
+	template <uint32 N, typename Function>
+	constexpr void unroll(Function&& function)
+	{
+		[&]<uint32... I>(std::integer_sequence<uint32, I...>)
+		{
+			(function(I), ...);
+		}(std::make_integer_sequence<uint32, N>{});
+	}
+
+
+	// SSE kernels for the float specializations of Matrix. Row-major, unaligned, used only at runtime.
+	// out must not overlap a or b.
+	inline void mulMatrix2x2Sse(const float* a, const float* b, float* out) noexcept
+	{
+		// the whole matrix in one register: (m00, m01, m10, m11)
+		const __m128 l{ _mm_loadu_ps(a) };
+		const __m128 r{ _mm_loadu_ps(b) };
+		const __m128 lXXZZ{ _mm_shuffle_ps(l, l, _MM_SHUFFLE(2, 2, 0, 0)) };
+		const __m128 lYYWW{ _mm_shuffle_ps(l, l, _MM_SHUFFLE(3, 3, 1, 1)) };
+		const __m128 rXYXY{ _mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 0, 1, 0)) };
+		const __m128 rZWZW{ _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 2, 3, 2)) };
+		_mm_storeu_ps(out, _mm_add_ps(_mm_mul_ps(lXXZZ, rXYXY), _mm_mul_ps(lYYWW, rZWZW)));
+	}
+
+	// one row of l times the rows of r: l.x * r0 + l.y * r1 + l.z * r2 (+ l.w * r3)
+	inline __m128 mulRowSse(const __m128& l, const __m128& r0, const __m128& r1, const __m128& r2) noexcept
+	{
+		return _mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(0, 0, 0, 0)), r0),
+			_mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(1, 1, 1, 1)), r1)),
+			_mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(2, 2, 2, 2)), r2));
+	}
+
+	inline __m128 mulRowSse(const __m128& l, const __m128& r0, const __m128& r1, const __m128& r2, const __m128& r3) noexcept
+	{
+		return _mm_add_ps(mulRowSse(l, r0, r1, r2), _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(3, 3, 3, 3)), r3));
+	}
+
+	inline void mulMatrix3x3Sse(const float* a, const float* b, float* out) noexcept
+	{
+		// Rows are 3 floats apart, so the loads and stores of rows 0 and 1 spill into the next row; the 4th lane is ignored.
+		// Row 2 is read from [5, 9) and written in two parts so nothing outside the 9 floats is touched.
+		const __m128 r0{ _mm_loadu_ps(b + 0) };
+		const __m128 r1{ _mm_loadu_ps(b + 3) };
+		const __m128 r2{ _mm_shuffle_ps(_mm_loadu_ps(b + 5), _mm_loadu_ps(b + 5), _MM_SHUFFLE(3, 3, 2, 1)) };
+		const __m128 l2{ _mm_shuffle_ps(_mm_loadu_ps(a + 5), _mm_loadu_ps(a + 5), _MM_SHUFFLE(3, 3, 2, 1)) };
+
+		const __m128 row0{ mulRowSse(_mm_loadu_ps(a + 0), r0, r1, r2) };
+		const __m128 row1{ mulRowSse(_mm_loadu_ps(a + 3), r0, r1, r2) };
+		const __m128 row2{ mulRowSse(l2, r0, r1, r2) };
+		_mm_storeu_ps(out + 0, row0);
+		_mm_storeu_ps(out + 3, row1);
+		_mm_storel_pi(reinterpret_cast<__m64*>(out + 6), row2);
+		_mm_store_ss(out + 8, _mm_shuffle_ps(row2, row2, _MM_SHUFFLE(2, 2, 2, 2)));
+	}
+
+	inline void mulMatrix4x4Sse(const float* a, const float* b, float* out) noexcept
+	{
+		const __m128 r0{ _mm_loadu_ps(b + 0) };
+		const __m128 r1{ _mm_loadu_ps(b + 4) };
+		const __m128 r2{ _mm_loadu_ps(b + 8) };
+		const __m128 r3{ _mm_loadu_ps(b + 12) };
+		for (uint32 row = 0; row < 4; ++row)
+		{
+			_mm_storeu_ps(out + row * 4, mulRowSse(_mm_loadu_ps(a + row * 4), r0, r1, r2, r3));
+		}
+	}
+
+	// affine 3x4 matrices: the implicit 4th row is (0, 0, 0, 1)
+	inline void mulAffine3x4Sse(const float* a, const float* b, float* out) noexcept
+	{
+		const __m128 r0{ _mm_loadu_ps(b + 0) };
+		const __m128 r1{ _mm_loadu_ps(b + 4) };
+		const __m128 r2{ _mm_loadu_ps(b + 8) };
+		const __m128 r3{ _mm_set_ps(1, 0, 0, 0) };
+		for (uint32 row = 0; row < 3; ++row)
+		{
+			_mm_storeu_ps(out + row * 4, mulRowSse(_mm_loadu_ps(a + row * 4), r0, r1, r2, r3));
+		}
+	}
+
+
+	// N-dimensional column vector (constexpr). For 4 floats in a register use Float4.
+	template <typename T, uint32 N>
+	struct Vector
+	{
+		static_assert(N > 0, "Vector must have at least one element.");
+
+		constexpr Vector() noexcept
+		{
+			__noop;
+		}
+		template <typename... Ts> requires (sizeof...(Ts) == N && (std::is_convertible_v<Ts, T> && ...))
+		constexpr Vector(Ts... elements) noexcept : v{ static_cast<T>(elements)... }
+		{
+			__noop;
+		}
+
+		T v[N]{};
+
+		constexpr T& operator[](uint32 index) noexcept
+		{
+			return v[index];
+		}
+
+		constexpr const T& operator[](uint32 index) const noexcept
+		{
+			return v[index];
+		}
+
+		constexpr Vector operator+(const Vector& b) const noexcept
+		{
+			Vector result;
+			unroll<N>([&](uint32 i) { result.v[i] = v[i] + b.v[i]; });
+			return result;
+		}
+
+		constexpr Vector operator-(const Vector& b) const noexcept
+		{
+			Vector result;
+			unroll<N>([&](uint32 i) { result.v[i] = v[i] - b.v[i]; });
+			return result;
+		}
+
+		constexpr Vector operator*(T s) const noexcept
+		{
+			Vector result;
+			unroll<N>([&](uint32 i) { result.v[i] = v[i] * s; });
+			return result;
+		}
+
+		constexpr Vector operator/(T s) const noexcept
+		{
+			Vector result;
+			unroll<N>([&](uint32 i) { result.v[i] = v[i] / s; });
+			return result;
+		}
+
+		static constexpr T dot(const Vector& a, const Vector& b) noexcept
+		{
+			T result{};
+			unroll<N>([&](uint32 i) { result += a.v[i] * b.v[i]; });
+			return result;
+		}
+	};
+
+
+	// R x C row-major matrix (constexpr).
+	// Products with mismatched dimensions and square-only functions on non-square matrices do not compile.
+	// Loops over the dimensions are unrolled at compile time. At runtime, float 2x2, 3x3 and 4x4 products and
+	// mulAffine() of float 3x4 matrices use SSE. For a 4x4 matrix kept in registers across many operations use Float4x4.
+	template <typename T, uint32 R, uint32 C>
+	struct Matrix
+	{
+		static_assert(R > 0 && C > 0, "Matrix must have at least one row and one column.");
+
+		static constexpr uint32 kRowCount{ R };
+		static constexpr uint32 kColumnCount{ C };
+
+		// identity (ones on the main diagonal)
+		constexpr Matrix() noexcept
+		{
+			setIdentity();
+		}
+		// elements in row-major order
+		template <typename... Ts> requires (sizeof...(Ts) == R * C && (std::is_convertible_v<Ts, T> && ...))
+		constexpr Matrix(Ts... elements) noexcept : m{ static_cast<T>(elements)... }
+		{
+			__noop;
+		}
+
+		T m[R][C]{};
+
+		constexpr Matrix operator+(const Matrix& b) const noexcept
+		{
+			Matrix result;
+			unroll<R>([&](uint32 row) { unroll<C>([&](uint32 column) { result.m[row][column] = m[row][column] + b.m[row][column]; }); });
+			return result;
+		}
+
+		constexpr Matrix operator-(const Matrix& b) const noexcept
+		{
+			Matrix result;
+			unroll<R>([&](uint32 row) { unroll<C>([&](uint32 column) { result.m[row][column] = m[row][column] - b.m[row][column]; }); });
+			return result;
+		}
+
+		constexpr Matrix operator*(T s) const noexcept
+		{
+			Matrix result;
+			unroll<R>([&](uint32 row) { unroll<C>([&](uint32 column) { result.m[row][column] = m[row][column] * s; }); });
+			return result;
+		}
+
+		constexpr Matrix operator/(T s) const noexcept
+		{
+			Matrix result;
+			unroll<R>([&](uint32 row) { unroll<C>([&](uint32 column) { result.m[row][column] = m[row][column] / s; }); });
+			return result;
+		}
+
+		// (R x C) * (C x K)
+		template <uint32 K>
+		constexpr Matrix<T, R, K> operator*(const Matrix<T, C, K>& r) const noexcept
+		{
+			Matrix<T, R, K> result;
+			if constexpr (std::is_same_v<T, float> == true && R == C && C == K && R >= 2 && R <= 4)
+			{
+				if (std::is_constant_evaluated() == false)
+				{
+					if constexpr (R == 2)
+					{
+						mulMatrix2x2Sse(&m[0][0], &r.m[0][0], &result.m[0][0]);
+					}
+					else if constexpr (R == 3)
+					{
+						mulMatrix3x3Sse(&m[0][0], &r.m[0][0], &result.m[0][0]);
+					}
+					else
+					{
+						mulMatrix4x4Sse(&m[0][0], &r.m[0][0], &result.m[0][0]);
+					}
+					return result;
+				}
+			}
+
+			unroll<R>([&](uint32 row)
+				{
+					unroll<K>([&](uint32 column)
+						{
+							T sum{};
+							unroll<C>([&](uint32 i) { sum += m[row][i] * r.m[i][column]; });
+							result.m[row][column] = sum;
+						});
+				});
+			return result;
+		}
+
+		constexpr Vector<T, R> operator*(const Vector<T, C>& v) const noexcept
+		{
+			Vector<T, R> result;
+			unroll<R>([&](uint32 row)
+				{
+					T sum{};
+					unroll<C>([&](uint32 i) { sum += m[row][i] * v.v[i]; });
+					result.v[row] = sum;
+				});
+			return result;
+		}
+
+		constexpr void setZero() noexcept
+		{
+			unroll<R>([&](uint32 row) { unroll<C>([&](uint32 column) { m[row][column] = 0; }); });
+		}
+
+		constexpr void setIdentity() noexcept
+		{
+			unroll<R>([&](uint32 row) { unroll<C>([&](uint32 column) { m[row][column] = (row == column) ? T(1) : T(0); }); });
+		}
+
+		constexpr Matrix<T, C, R> transpose() const noexcept
+		{
+			Matrix<T, C, R> result;
+			unroll<R>([&](uint32 row) { unroll<C>([&](uint32 column) { result.m[column][row] = m[row][column]; }); });
+			return result;
+		}
+
+	// square matrices only
+	public:
+		constexpr Matrix<T, R - 1, C - 1> minor(uint32 rowIndex, uint32 columnIndex) const noexcept requires (R == C && R > 1)
+		{
+			Matrix<T, R - 1, C - 1> result;
+			for (uint32 row = 0; row < R - 1; ++row)
+			{
+				const uint32 sourceRow{ (row < rowIndex) ? row : row + 1 };
+				for (uint32 column = 0; column < C - 1; ++column)
+				{
+					const uint32 sourceColumn{ (column < columnIndex) ? column : column + 1 };
+					result.m[row][column] = m[sourceRow][sourceColumn];
+				}
+			}
+			return result;
+		}
+
+		// closed form up to 4x4 (no minor() copies), Laplace expansion above that
+		constexpr T determinant() const noexcept requires (R == C)
+		{
+			if constexpr (R == 1)
+			{
+				return m[0][0];
+			}
+			else if constexpr (R == 2)
+			{
+				return m[0][0] * m[1][1] - m[0][1] * m[1][0];
+			}
+			else if constexpr (R == 3)
+			{
+				return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+					- m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+					+ m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+			}
+			else if constexpr (R == 4)
+			{
+				T s[6]{};
+				T c[6]{};
+				computeSubdeterminants4x4(s, c);
+				return s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] + s[5] * c[0];
+			}
+			else
+			{
+				T result{};
+				for (uint32 column = 0; column < C; ++column)
+				{
+					const T term{ m[0][column] * minor(0, column).determinant() };
+					result += (column % 2 == 0) ? term : -term;
+				}
+				return result;
+			}
+		}
+
+		constexpr Matrix cofactor() const noexcept requires (R == C)
+		{
+			Matrix result;
+			if constexpr (R == 1)
+			{
+				result.m[0][0] = 1;
+			}
+			else
+			{
+				for (uint32 row = 0; row < R; ++row)
+				{
+					for (uint32 column = 0; column < C; ++column)
+					{
+						const T determinant{ minor(row, column).determinant() };
+						result.m[row][column] = ((row + column) % 2 == 0) ? determinant : -determinant;
+					}
+				}
+			}
+			return result;
+		}
+
+		constexpr Matrix adjugate() const noexcept requires (R == C)
+		{
+			return cofactor().transpose();
+		}
+
+		constexpr Matrix inverse() const noexcept requires (R == C)
+		{
+			if constexpr (R == 4)
+			{
+				// the same 2x2 sub-determinants as determinant()
+				T s[6]{};
+				T c[6]{};
+				computeSubdeterminants4x4(s, c);
+				const T inverseDeterminant{ T(1) / (s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] + s[5] * c[0]) };
+				return Matrix
+				(
+					(+m[1][1] * c[5] - m[1][2] * c[4] + m[1][3] * c[3]) * inverseDeterminant,
+					(-m[0][1] * c[5] + m[0][2] * c[4] - m[0][3] * c[3]) * inverseDeterminant,
+					(+m[3][1] * s[5] - m[3][2] * s[4] + m[3][3] * s[3]) * inverseDeterminant,
+					(-m[2][1] * s[5] + m[2][2] * s[4] - m[2][3] * s[3]) * inverseDeterminant,
+
+					(-m[1][0] * c[5] + m[1][2] * c[2] - m[1][3] * c[1]) * inverseDeterminant,
+					(+m[0][0] * c[5] - m[0][2] * c[2] + m[0][3] * c[1]) * inverseDeterminant,
+					(-m[3][0] * s[5] + m[3][2] * s[2] - m[3][3] * s[1]) * inverseDeterminant,
+					(+m[2][0] * s[5] - m[2][2] * s[2] + m[2][3] * s[1]) * inverseDeterminant,
+
+					(+m[1][0] * c[4] - m[1][1] * c[2] + m[1][3] * c[0]) * inverseDeterminant,
+					(-m[0][0] * c[4] + m[0][1] * c[2] - m[0][3] * c[0]) * inverseDeterminant,
+					(+m[3][0] * s[4] - m[3][1] * s[2] + m[3][3] * s[0]) * inverseDeterminant,
+					(-m[2][0] * s[4] + m[2][1] * s[2] - m[2][3] * s[0]) * inverseDeterminant,
+
+					(-m[1][0] * c[3] + m[1][1] * c[1] - m[1][2] * c[0]) * inverseDeterminant,
+					(+m[0][0] * c[3] - m[0][1] * c[1] + m[0][2] * c[0]) * inverseDeterminant,
+					(-m[3][0] * s[3] + m[3][1] * s[1] - m[3][2] * s[0]) * inverseDeterminant,
+					(+m[2][0] * s[3] - m[2][1] * s[1] + m[2][2] * s[0]) * inverseDeterminant
+				);
+			}
+			else
+			{
+				return adjugate() / determinant();
+			}
+		}
+
+	private:
+		// 2x2 determinants of rows 0-1 (s) and rows 2-3 (c)
+		constexpr void computeSubdeterminants4x4(T (&s)[6], T (&c)[6]) const noexcept requires (R == 4 && C == 4)
+		{
+			s[0] = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+			s[1] = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+			s[2] = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+			s[3] = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+			s[4] = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+			s[5] = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+
+			c[0] = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+			c[1] = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+			c[2] = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+			c[3] = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+			c[4] = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+			c[5] = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+		}
+	};
+
+
+	// a * b for affine transforms stored as 3x4 (the implicit 4th row is 0, 0, 0, 1)
+	template <typename T>
+	constexpr Matrix<T, 3, 4> mulAffine(const Matrix<T, 3, 4>& a, const Matrix<T, 3, 4>& b) noexcept
+	{
+		Matrix<T, 3, 4> result;
+		if constexpr (std::is_same_v<T, float> == true)
+		{
+			if (std::is_constant_evaluated() == false)
+			{
+				mulAffine3x4Sse(&a.m[0][0], &b.m[0][0], &result.m[0][0]);
+				return result;
+			}
+		}
+
+		unroll<3>([&](uint32 row)
+			{
+				unroll<4>([&](uint32 column)
+					{
+						T sum{ (column == 3) ? a.m[row][3] : T(0) };
+						unroll<3>([&](uint32 i) { sum += a.m[row][i] * b.m[i][column]; });
+						result.m[row][column] = sum;
+					});
+			});
+		return result;
+	}
+
+
+	// aliases
+	using Float2x2		= Matrix<float, 2, 2>;
+	using Float3x3		= Matrix<float, 3, 3>;
+	using Float3x4		= Matrix<float, 3, 4>;
+
+	// for precision-sensitive tools (always the generic path)
+	using Double2		= Vector<double, 2>;
+	using Double3		= Vector<double, 3>;
+	using Double4		= Vector<double, 4>;
+	using Double2x2		= Matrix<double, 2, 2>;
+	using Double3x3		= Matrix<double, 3, 3>;
+	using Double3x4		= Matrix<double, 3, 4>;
+	using Double4x4		= Matrix<double, 4, 4>;
+
+	static_assert(std::is_trivially_copyable_v<Float3x3> == true, "Matrix must be trivially copyable.");
+}
+
+
+// === HEADER ENDS ===
+#endif // !FS_MATRIX_H
@@ -0,0 +1,144 @@
+﻿#include "PixelStorage.h"
+
+#include <cassert>
+
+
+namespace fs
+{
+	// 64바이트 == 16픽셀
+	static constexpr uint32 kStrideAlignment{ 16 };
+
+
+	PixelStorage::PixelStorage()
+	{
+		__noop;
+	}
+
+	PixelStorage::PixelStorage(PixelStorage&& b) noexcept
+	{
+		*this = std::move(b);
+	}
+
+	PixelStorage::~PixelStorage()
+	{
+		destroy();
+	}
+
+	PixelStorage& PixelStorage::operator=(PixelStorage&& b) noexcept
+	{
+		if (this == &b) return *this;
+
+		destroy();
+
+		_pixels = b._pixels;
+		_width = b._width;
+		_height = b._height;
+		_stride = b._stride;
+
+		// std::vector의 이동은 메모리 주소를 유지하므로 _pixels도 그대로 유효하다.
+		_storage = std::move(b._storage);
+#if defined(_WIN32)
+		_bitmap = b._bitmap;
+		b._bitmap = nullptr;
+#endif
+
+		b._pixels = nullptr;
+		b._width = 0;
+		b._height = 0;
+		b._stride = 0;
+		return *this;
+	}
+
+	void PixelStorage::create(uint32 width, uint32 height)
+	{
+		destroy();
+
+		_width = width;
+		_height = height;
+		_stride = (width + kStrideAlignment - 1) / kStrideAlignment * kStrideAlignment;
+		_storage.resize(static_cast<size_t>(_stride) * height);
+		_pixels = _storage.data();
+	}
+
+#if defined(_WIN32)
+	bool PixelStorage::createDibSection(HDC hdc, uint32 width, uint32 height)
+	{
+		destroy();
+
+		// 32비트 DIB의 행은 항상 4바이트 정렬이므로 stride == width
+		BITMAPINFO bitmapInfo{};
+		bitmapInfo.bmiHeader.biSize = sizeof(bitmapInfo.bmiHeader);
+		bitmapInfo.bmiHeader.biWidth = static_cast<LONG>(width);
+		bitmapInfo.bmiHeader.biHeight = -static_cast<LONG>(height); // top-down
+		bitmapInfo.bmiHeader.biPlanes = 1;
+		bitmapInfo.bmiHeader.biBitCount = 32;
+		bitmapInfo.bmiHeader.biCompression = BI_RGB;
+
+		void* bits{};
+		_bitmap = CreateDIBSection(hdc, &bitmapInfo, DIB_RGB_COLORS, &bits, nullptr, 0);
+		if (_bitmap == nullptr)
+		{
+			return false;
+		}
+
+		_pixels = static_cast<uint32*>(bits);
+		_width = width;
+		_height = height;
+		_stride = width;
+		return true;
+	}
+#endif
+
+	void PixelStorage::destroy() noexcept
+	{
+#if defined(_WIN32)
+		if (_bitmap != nullptr)
+		{
+			DeleteObject(_bitmap);
+			_bitmap = nullptr;
+		}
+#endif
+		_storage.clear();
+		_storage.shrink_to_fit();
+		_pixels = nullptr;
+		_width = 0;
+		_height = 0;
+		_stride = 0;
+	}
+
+	Framebuffer PixelStorage::getFramebuffer() const noexcept
+	{
+		if (_pixels == nullptr)
+		{
+			return Framebuffer();
+		}
+		return Framebuffer(_pixels, _width, _height, _stride);
+	}
+
+	uint32* PixelStorage::getPixels() const noexcept
+	{
+		return _pixels;
+	}
+
+	uint32 PixelStorage::getWidth() const noexcept
+	{
+		return _width;
+	}
+
+	uint32 PixelStorage::getHeight() const noexcept
+	{
+		return _height;
+	}
+
+	uint32 PixelStorage::getStride() const noexcept
+	{
+		return _stride;
+	}
+
+#if defined(_WIN32)
+	HBITMAP PixelStorage::getBitmap() const noexcept
+	{
+		return _bitmap;
+	}
+#endif
+}
@@ -0,0 +1,72 @@
+﻿#pragma once
+
+
+#ifndef FS_PIXEL_STORAGE_H
+#define FS_PIXEL_STORAGE_H
+// === HEADER BEGINS ===
+
+
+#include <Core/_CommonTypes.h>
+#include <Core/AlignedAllocator.h>
+#include <Core/Framebuffer.h>
+
+
+namespace fs
+{
+	// Framebuffer가 그릴 32비트 BGRA 픽셀 메모리를 소유한다.
+	// Windows에서는 top-down 32비트 DIB section으로 만들 수 있어서, CPU가 그린 메모리를 GDI가 복사 없이 그대로 출력한다.
+	// 그 외의 환경(Linux 테스트 빌드 등)에서는 같은 배치의 정렬된 메모리만 쓴다.
+	class PixelStorage final
+	{
+	public:
+		PixelStorage();
+		PixelStorage(const PixelStorage& b) = delete;
+		PixelStorage(PixelStorage&& b) noexcept;
+		~PixelStorage();
+
+	public:
+		PixelStorage& operator=(const PixelStorage& b) = delete;
+		PixelStorage& operator=(PixelStorage&& b) noexcept;
+
+	public:
+		// 64바이트 정렬된 메모리. 각 행의 시작도 64바이트 정렬되도록 stride를 16픽셀 단위로 올린다.
+		void create(uint32 width, uint32 height);
+#if defined(_WIN32)
+		// top-down 32비트 DIB section. (stride == width) 실패하면 false
+		bool createDibSection(HDC hdc, uint32 width, uint32 height);
+#endif
+		void destroy() noexcept;
+
+	public:
+		// 메모리를 가리키는 view. PixelStorage가 해제되면 더 이상 쓸 수 없다.
+		Framebuffer getFramebuffer() const noexcept;
+		uint32* getPixels() const noexcept;
+		uint32 getWidth() const noexcept;
+		uint32 getHeight() const noexcept;
+		// 한 행의 픽셀 수
+		uint32 getStride() const noexcept;
+#if defined(_WIN32)
+		// DIB section이 아니면 nullptr
+		// @주의: GDI로 그린 뒤 CPU로 읽거나 쓰기 전에 GdiFlush()를 호출하세요.
+		HBITMAP getBitmap() const noexcept;
+#endif
+
+	private:
+		uint32*										_pixels{};
+		uint32										_width{};
+		uint32										_height{};
+		uint32										_stride{};
+
+	private:
+		// create()로 만든 메모리
+		std::vector<uint32, AlignedAllocator<uint32, 64>>	_storage{};
+#if defined(_WIN32)
+		// createDibSection()으로 만든 비트맵 (메모리는 GDI가 소유한다.)
+		HBITMAP										_bitmap{};
+#endif
+	};
+}
+
+
+// === HEADER ENDS ===
+#endif // !FS_PIXEL_STORAGE_H
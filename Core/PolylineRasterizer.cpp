@@ -0,0 +1,439 @@
+﻿#include "PolylineRasterizer.h"
+#include <Core/Framebuffer.h>
+
+#include <cmath>
+
+
+namespace fs
+{
+	// 이만큼(픽셀) 안쪽으로 벗어나는 정점은 직선 위에 있는 것으로 본다.
+	static constexpr float kCollinearTolerance{ 1.0f / 128.0f };
+
+	// 아주 먼 좌표도 int32로 안전하게 바꾼다.
+	static inline int32 toPixelBound(float value) noexcept
+	{
+		constexpr float kLimit{ static_cast<float>(1 << 30) };
+		return static_cast<int32>((value < -kLimit) ? -kLimit : (value > kLimit) ? kLimit : value);
+	}
+
+	static inline float clampFloat(float value, float minValue, float maxValue) noexcept
+	{
+		return (value < minValue) ? minValue : (value > maxValue) ? maxValue : value;
+	}
+
+
+	PolylineRasterizer::PolylineRasterizer()
+	{
+		__noop;
+	}
+
+	PolylineRasterizer::~PolylineRasterizer()
+	{
+		__noop;
+	}
+
+	void PolylineRasterizer::drawPolyline(Framebuffer& target, std::span<const Float2> points, float width, ELineJoin eJoin, ELineCap eCap,
+		uint32 color, uint8 alpha)
+	{
+		if (points.empty() == true || width <= 0.0f || alpha == 0) return;
+
+		int32 clipLeft{};
+		int32 clipTop{};
+		int32 clipRight{};
+		int32 clipBottom{};
+		target.getClipRectangle(clipLeft, clipTop, clipRight, clipBottom);
+
+		int32 boundsLeft{};
+		int32 boundsTop{};
+		int32 boundsRight{};
+		int32 boundsBottom{};
+		computeBounds(points, width, eJoin, eCap, boundsLeft, boundsTop, boundsRight, boundsBottom);
+
+		// 가로는 clip rectangle이 아니라 target으로만 자른다.
+		const int32 targetWidth{ static_cast<int32>(target.getWidth()) };
+		_left = (boundsLeft < 0) ? 0 : boundsLeft;
+		_top = (boundsTop < clipTop) ? clipTop : boundsTop;
+		const int32 right{ (boundsRight > targetWidth) ? targetWidth : boundsRight };
+		const int32 bottom{ (boundsBottom > clipBottom) ? clipBottom : boundsBottom };
+		if (_left >= right || _top >= bottom || right <= clipLeft || _left >= clipRight) return;
+
+		_width = right - _left;
+		_height = bottom - _top;
+		_rowStride = _width + 2;
+		const size_t cellCount{ static_cast<size_t>(_rowStride) * _height };
+		if (_vAccumulation.size() < cellCount)
+		{
+			_vAccumulation.resize(cellCount, 0.0f);
+		}
+		if (_vCoverageRow.size() < static_cast<size_t>(_width))
+		{
+			_vCoverageRow.resize(_width);
+		}
+
+		const float halfWidth{ width * 0.5f };
+		if (eJoin == ELineJoin::Round || eCap == ELineCap::Round)
+		{
+			// 원의 현과 호 사이가 0.1픽셀 이하가 되도록 나눈다.
+			constexpr float kTwoPi{ 6.283185307f };
+			const float angleStep{ (halfWidth > 0.1f) ? 2.0f * acosf(1.0f - 0.1f / halfWidth) : kTwoPi / 8.0f };
+			uint32 segmentCount{ static_cast<uint32>(ceilf(kTwoPi / angleStep)) };
+			segmentCount = (segmentCount < 8) ? 8 : (segmentCount > 256) ? 256 : segmentCount;
+			_vCircle.resize(segmentCount);
+			for (uint32 i = 0; i < segmentCount; ++i)
+			{
+				const float angle{ kTwoPi * static_cast<float>(i) / static_cast<float>(segmentCount) };
+				_vCircle[i] = Float2(cosf(angle) * halfWidth, sinf(angle) * halfWidth);
+			}
+		}
+
+		const Float2* const vertices{ points.data() };
+		const uint32 pointCount{ static_cast<uint32>(points.size()) };
+		Float2 pointA{ vertices[0] };
+		uint32 index{ 1 };
+		while (index < pointCount && vertices[index] == pointA) ++index;
+
+		if (index == pointCount)
+		{
+			// 점 하나는 cap만 그린다.
+			if (eCap == ELineCap::Round)
+			{
+				addCircle(pointA);
+			}
+			else if (eCap == ELineCap::Square)
+			{
+				const Float2 square[4]
+				{
+					Float2(pointA.x - halfWidth, pointA.y - halfWidth), Float2(pointA.x + halfWidth, pointA.y - halfWidth),
+					Float2(pointA.x + halfWidth, pointA.y + halfWidth), Float2(pointA.x - halfWidth, pointA.y + halfWidth),
+				};
+				addPolygon(square, 4);
+			}
+		}
+		else
+		{
+			Float2 prevDirection{};
+			bool bFirst{ true };
+			while (index < pointCount)
+			{
+				// pointA -> vertices[index] 직선에서 kCollinearTolerance 안쪽으로 앞으로만 나아가는 정점들은 하나의 선분으로 합친다.
+				// 점이 아주 많은 그래프에서 선분 수가 픽셀 수 정도로 줄어든다.
+				Float2 pointB{ vertices[index] };
+				uint32 nextIndex{ index + 1 };
+				{
+					const float dx{ pointB.x - pointA.x };
+					const float dy{ pointB.y - pointA.y };
+					const float invLength{ 1.0f / sqrtf(dx * dx + dy * dy) };
+					const float directionX{ dx * invLength };
+					const float directionY{ dy * invLength };
+					float prevAlong{ dx * directionX + dy * directionY };
+					for (; nextIndex < pointCount; ++nextIndex)
+					{
+						const float relativeX{ vertices[nextIndex].x - pointA.x };
+						const float relativeY{ vertices[nextIndex].y - pointA.y };
+						const float along{ relativeX * directionX + relativeY * directionY };
+						const float across{ relativeX * directionY - relativeY * directionX };
+						if (along < prevAlong || fabsf(across) > kCollinearTolerance) break;
+
+						prevAlong = along;
+						pointB = vertices[nextIndex];
+					}
+				}
+				const bool bLast{ nextIndex == pointCount };
+
+				const float dx{ pointB.x - pointA.x };
+				const float dy{ pointB.y - pointA.y };
+				const float invLength{ 1.0f / sqrtf(dx * dx + dy * dy) };
+				const Float2 direction{ dx * invLength, dy * invLength };
+				const Float2 normal{ -direction.y * halfWidth, direction.x * halfWidth };
+
+				Float2 segmentA{ pointA };
+				Float2 segmentB{ pointB };
+				if (eCap == ELineCap::Square)
+				{
+					if (bFirst == true) segmentA = Float2(pointA.x - direction.x * halfWidth, pointA.y - direction.y * halfWidth);
+					if (bLast == true) segmentB = Float2(pointB.x + direction.x * halfWidth, pointB.y + direction.y * halfWidth);
+				}
+				const Float2 quad[4]
+				{
+					Float2(segmentA.x + normal.x, segmentA.y + normal.y), Float2(segmentB.x + normal.x, segmentB.y + normal.y),
+					Float2(segmentB.x - normal.x, segmentB.y - normal.y), Float2(segmentA.x - normal.x, segmentA.y - normal.y),
+				};
+				addPolygon(quad, 4);
+
+				if (bFirst == false)
+				{
+					addJoin(pointA, prevDirection, direction, eJoin, halfWidth);
+				}
+				else if (eCap == ELineCap::Round)
+				{
+					addCircle(pointA);
+				}
+				if (bLast == true && eCap == ELineCap::Round)
+				{
+					addCircle(pointB);
+				}
+
+				prevDirection = direction;
+				pointA = pointB;
+				index = nextIndex;
+				bFirst = false;
+			}
+		}
+
+		// 누적 값의 prefix sum이 coverage이다. 읽은 칸은 다음 호출을 위해 0으로 되돌린다.
+		const float alphaScale{ static_cast<float>(alpha) };
+		for (int32 row = 0; row < _height; ++row)
+		{
+			float* const cells{ &_vAccumulation[static_cast<size_t>(row) * _rowStride] };
+			float accumulation{};
+			for (int32 column = 0; column < _width; ++column)
+			{
+				accumulation += cells[column];
+				cells[column] = 0.0f;
+				const float coverage{ fabsf(accumulation) };
+				_vCoverageRow[column] = (coverage >= 1.0f) ? alpha : static_cast<uint8>(coverage * alphaScale + 0.5f);
+			}
+			cells[_width] = 0.0f;
+			cells[_width + 1] = 0.0f;
+			target.blendCoverageSpan(_left, _top + row, _vCoverageRow.data(), _width, color);
+		}
+	}
+
+	void PolylineRasterizer::computeBounds(std::span<const Float2> points, float width, ELineJoin eJoin, ELineCap eCap,
+		int32& left, int32& top, int32& right, int32& bottom) noexcept
+	{
+		left = top = right = bottom = 0;
+		if (points.empty() == true) return;
+
+		float minX{ points[0].x };
+		float minY{ points[0].y };
+		float maxX{ points[0].x };
+		float maxY{ points[0].y };
+		for (const auto& point : points)
+		{
+			minX = (point.x < minX) ? point.x : minX;
+			minY = (point.y < minY) ? point.y : minY;
+			maxX = (point.x > maxX) ? point.x : maxX;
+			maxY = (point.y > maxY) ? point.y : maxY;
+		}
+
+		// miter는 꼭짓점에서 (두께 / 2 * kMiterLimit)까지, square cap은 모서리까지 (두께 / 2 * sqrt(2)) 나간다.
+		const float halfWidth{ width * 0.5f };
+		float padding{ (eJoin == ELineJoin::Miter) ? halfWidth * kMiterLimit : halfWidth };
+		if (eCap == ELineCap::Square && padding < halfWidth * 1.4142136f)
+		{
+			padding = halfWidth * 1.4142136f;
+		}
+		left = toPixelBound(floorf(minX - padding)) - 1;
+		top = toPixelBound(floorf(minY - padding)) - 1;
+		right = toPixelBound(ceilf(maxX + padding)) + 1;
+		bottom = toPixelBound(ceilf(maxY + padding)) + 1;
+	}
+
+	void PolylineRasterizer::addPolygon(const Float2* vertices, uint32 count) noexcept
+	{
+		float minX{ vertices[0].x };
+		float minY{ vertices[0].y };
+		float maxX{ vertices[0].x };
+		float maxY{ vertices[0].y };
+		float doubleArea{};
+		for (uint32 i = 0; i < count; ++i)
+		{
+			const Float2& a{ vertices[i] };
+			const Float2& b{ vertices[(i + 1 == count) ? 0 : i + 1] };
+			minX = (a.x < minX) ? a.x : minX;
+			minY = (a.y < minY) ? a.y : minY;
+			maxX = (a.x > maxX) ? a.x : maxX;
+			maxY = (a.y > maxY) ? a.y : maxY;
+			doubleArea += a.x * b.y - b.x * a.y;
+		}
+		if (doubleArea == 0.0f) return;
+
+		// 닫힌 다각형이 영역 전체의 왼쪽에 있으면 영역 안의 winding은 0이다.
+		if (maxX <= static_cast<float>(_left) || minX >= static_cast<float>(_left + _width)
+			|| maxY <= static_cast<float>(_top) || minY >= static_cast<float>(_top + _height)) return;
+
+		for (uint32 i = 0; i < count; ++i)
+		{
+			const uint32 next{ (i + 1 == count) ? 0 : i + 1 };
+			if (doubleArea > 0.0f)
+			{
+				addEdge(vertices[i].x, vertices[i].y, vertices[next].x, vertices[next].y);
+			}
+			else
+			{
+				addEdge(vertices[next].x, vertices[next].y, vertices[i].x, vertices[i].y);
+			}
+		}
+	}
+
+	void PolylineRasterizer::addCircle(const Float2& center) noexcept
+	{
+		const float radius{ fabsf(_vCircle[0].x) };
+		if (center.x + radius <= static_cast<float>(_left) || center.x - radius >= static_cast<float>(_left + _width)
+			|| center.y + radius <= static_cast<float>(_top) || center.y - radius >= static_cast<float>(_top + _height)) return;
+
+		// _vCircle은 반시계 방향(넓이 > 0)으로 만들어져 있다.
+		const uint32 count{ static_cast<uint32>(_vCircle.size()) };
+		for (uint32 i = 0; i < count; ++i)
+		{
+			const Float2& a{ _vCircle[i] };
+			const Float2& b{ _vCircle[(i + 1 == count) ? 0 : i + 1] };
+			addEdge(center.x + a.x, center.y + a.y, center.x + b.x, center.y + b.y);
+		}
+	}
+
+	void PolylineRasterizer::addJoin(const Float2& point, const Float2& directionA, const Float2& directionB, ELineJoin eJoin, float halfWidth) noexcept
+	{
+		if (eJoin == ELineJoin::Round)
+		{
+			addCircle(point);
+			return;
+		}
+
+		// 꺾이는 방향의 반대쪽이 바깥쪽이다.
+		const float cross{ directionA.x * directionB.y - directionA.y * directionB.x };
+		const float outerSign{ (cross > 0.0f) ? -halfWidth : halfWidth };
+		const Float2 outerA{ -directionA.y * outerSign, directionA.x * outerSign };
+		const Float2 outerB{ -directionB.y * outerSign, directionB.x * outerSign };
+		if (fabsf(cross) < 1e-6f && directionA.x * directionB.x + directionA.y * directionB.y > 0.0f) return;
+
+		if (eJoin == ELineJoin::Miter)
+		{
+			// 바깥쪽 두 모서리의 이등분선 위, 꼭짓점에서 halfWidth / cos(사이각 / 2)만큼 떨어진 점
+			const float bisectorX{ outerA.x + outerB.x };
+			const float bisectorY{ outerA.y + outerB.y };
+			const float bisectorLength{ sqrtf(bisectorX * bisectorX + bisectorY * bisectorY) };
+			if (bisectorLength > 0.0f)
+			{
+				const float cosHalfAngle{ (bisectorX * outerA.x + bisectorY * outerA.y) / (bisectorLength * halfWidth) };
+				if (cosHalfAngle * kMiterLimit >= 1.0f)
+				{
+					const float scale{ halfWidth / (cosHalfAngle * bisectorLength) };
+					const Float2 miter[4]
+					{
+						point, Float2(point.x + outerA.x, point.y + outerA.y),
+						Float2(point.x + bisectorX * scale, point.y + bisectorY * scale), Float2(point.x + outerB.x, point.y + outerB.y),
+					};
+					addPolygon(miter, 4);
+					return;
+				}
+			}
+		}
+
+		const Float2 bevel[3]{ point, Float2(point.x + outerA.x, point.y + outerA.y), Float2(point.x + outerB.x, point.y + outerB.y) };
+		addPolygon(bevel, 3);
+	}
+
+	void PolylineRasterizer::addEdge(float x0, float y0, float x1, float y1) noexcept
+	{
+		if (y0 == y1) return;
+
+		float direction{ 1.0f };
+		if (y0 > y1)
+		{
+			float temp{ x0 };
+			x0 = x1;
+			x1 = temp;
+			temp = y0;
+			y0 = y1;
+			y1 = temp;
+			direction = -1.0f;
+		}
+		if (y1 <= static_cast<float>(_top) || y0 >= static_cast<float>(_top + _height)) return;
+
+		// 영역 왼쪽 밖의 부분은 x = 0의 수직선으로, 오른쪽 밖의 부분은 x = _width의 수직선으로 바꾼다.
+		// 영역 안의 픽셀들은 그 변의 오른쪽에 있는지만 보면 되므로 coverage는 그대로다.
+		x0 -= static_cast<float>(_left);
+		x1 -= static_cast<float>(_left);
+		const float width{ static_cast<float>(_width) };
+		const float dxdy{ (x1 - x0) / (y1 - y0) };
+		float breaks[4]{ y0 };
+		uint32 breakCount{ 1 };
+		if (dxdy != 0.0f)
+		{
+			float yAtLeft{ y0 + (0.0f - x0) / dxdy };
+			float yAtRight{ y0 + (width - x0) / dxdy };
+			if (yAtLeft > yAtRight)
+			{
+				const float temp{ yAtLeft };
+				yAtLeft = yAtRight;
+				yAtRight = temp;
+			}
+			if (yAtLeft > y0 && yAtLeft < y1) breaks[breakCount++] = yAtLeft;
+			if (yAtRight > y0 && yAtRight < y1) breaks[breakCount++] = yAtRight;
+		}
+		breaks[breakCount++] = y1;
+
+		for (uint32 i = 0; i + 1 < breakCount; ++i)
+		{
+			const float yA{ breaks[i] };
+			const float yB{ breaks[i + 1] };
+			const float xA{ (i == 0) ? x0 : x0 + (yA - y0) * dxdy };
+			const float xB{ (i + 2 == breakCount) ? x1 : x0 + (yB - y0) * dxdy };
+			accumulateEdge(clampFloat(xA, 0.0f, width), yA, clampFloat(xB, 0.0f, width), yB, direction);
+		}
+	}
+
+	void PolylineRasterizer::accumulateEdge(float x0, float y0, float x1, float y1, float direction) noexcept
+	{
+		// 한 행 안에서 변이 지나는 칸들에 (변의 높이 * 칸의 오른쪽 경계까지 변 오른쪽의 면적 비율)을 나누어 넣는다.
+		// 한 행에 넣는 값의 합은 (변의 높이 * direction)이므로, prefix sum은 변 오른쪽의 칸에서 그 값이 된다.
+		const float width{ static_cast<float>(_width) };
+		const float dxdy{ (x1 - x0) / (y1 - y0) };
+		const int32 firstRow{ (static_cast<int32>(floorf(y0)) < _top) ? _top : static_cast<int32>(floorf(y0)) };
+		const int32 lastRow{ (static_cast<int32>(ceilf(y1)) > _top + _height) ? _top + _height : static_cast<int32>(ceilf(y1)) };
+		for (int32 row = firstRow; row < lastRow; ++row)
+		{
+			const float rowTop{ (static_cast<float>(row) > y0) ? static_cast<float>(row) : y0 };
+			const float rowBottom{ (static_cast<float>(row + 1) < y1) ? static_cast<float>(row + 1) : y1 };
+			const float height{ rowBottom - rowTop };
+			if (height <= 0.0f) continue;
+
+			// 각 행의 x는 누적 없이 그 행의 y로 계산한다.
+			const float xTop{ clampFloat(x0 + (rowTop - y0) * dxdy, 0.0f, width) };
+			const float xBottom{ clampFloat(x0 + (rowBottom - y0) * dxdy, 0.0f, width) };
+			const float value{ height * direction };
+			const float xMin{ (xTop < xBottom) ? xTop : xBottom };
+			const float xMax{ (xTop < xBottom) ? xBottom : xTop };
+			const float xMinFloor{ floorf(xMin) };
+			const float xMaxCeil{ ceilf(xMax) };
+			const int32 xMinIndex{ static_cast<int32>(xMinFloor) };
+			const int32 xMaxIndex{ static_cast<int32>(xMaxCeil) };
+
+			float* const cells{ &_vAccumulation[static_cast<size_t>(row - _top) * _rowStride] };
+			if (xMaxIndex <= xMinIndex + 1)
+			{
+				// 한 칸 안에 있다.
+				const float xMiddle{ (xTop + xBottom) * 0.5f - xMinFloor };
+				cells[xMinIndex] += value - value * xMiddle;
+				cells[xMinIndex + 1] += value * xMiddle;
+			}
+			else
+			{
+				const float invSpan{ 1.0f / (xMax - xMin) };
+				const float xMinFraction{ xMin - xMinFloor };
+				const float areaFirst{ 0.5f * invSpan * (1.0f - xMinFraction) * (1.0f - xMinFraction) };
+				const float xMaxFraction{ xMax - xMaxCeil + 1.0f };
+				const float areaLast{ 0.5f * invSpan * xMaxFraction * xMaxFraction };
+				cells[xMinIndex] += value * areaFirst;
+				if (xMaxIndex == xMinIndex + 2)
+				{
+					cells[xMinIndex + 1] += value * (1.0f - areaFirst - areaLast);
+				}
+				else
+				{
+					const float areaSecond{ invSpan * (1.5f - xMinFraction) };
+					cells[xMinIndex + 1] += value * (areaSecond - areaFirst);
+					for (int32 column = xMinIndex + 2; column < xMaxIndex - 1; ++column)
+					{
+						cells[column] += value * invSpan;
+					}
+					const float areaBeforeLast{ areaSecond + static_cast<float>(xMaxIndex - xMinIndex - 3) * invSpan };
+					cells[xMaxIndex - 1] += value * (1.0f - areaBeforeLast - areaLast);
+				}
+				cells[xMaxIndex] += value * areaLast;
+			}
+		}
+	}
+}
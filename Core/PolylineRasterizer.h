@@ -0,0 +1,92 @@
+﻿#pragma once
+
+
+#ifndef FS_POLYLINE_RASTERIZER_H
+#define FS_POLYLINE_RASTERIZER_H
+// === HEADER BEGINS ===
+
+
+#include <Core/_CommonTypes.h>
+#include <Core/Float2.h>
+
+#include <span>
+
+
+namespace fs
+{
+	class Framebuffer;
+
+
+	enum class ELineJoin : uint8
+	{
+		Miter,
+		Bevel,
+		Round,
+	};
+
+	enum class ELineCap : uint8
+	{
+		Butt,
+		Square,
+		Round,
+	};
+
+
+	// 두께가 있는 polyline을 anti-aliasing하여 Framebuffer에 그린다. GDI pen을 쓰지 않는다.
+	// 선분은 사각형, join과 cap은 삼각형/다각형으로 나누고, 모든 다각형의 변을 한 장의 누적 버퍼에
+	// 넣어 픽셀마다 덮인 면적(coverage)을 정확히 계산한다. (signed area accumulation)
+	// 모든 다각형은 같은 방향으로 감기므로 겹치는 곳은 coverage가 1로 잘리고, 결과는 한 번만 블렌딩된다.
+	// 누적 버퍼는 재사용하므로 하나의 인스턴스를 여러 스레드에서 동시에 쓰면 안 된다. Windows에 의존하지 않는다.
+	class PolylineRasterizer final
+	{
+	public:
+		// miter 길이가 (두께 / 2 * kMiterLimit)를 넘으면 bevel로 그린다. (SVG의 stroke-miterlimit 기본값)
+		static constexpr float kMiterLimit{ 4.0f };
+
+	public:
+		PolylineRasterizer();
+		~PolylineRasterizer();
+
+	public:
+		// points는 픽셀 좌표의 연속된 정점들이다. 같은 점이나 거의 일직선(1/128픽셀 이내)으로 이어지는 점들은 하나의 선분으로 본다.
+		// 그리는 영역은 target의 clip rectangle로 제한된다.
+		void drawPolyline(Framebuffer& target, std::span<const Float2> points, float width, ELineJoin eJoin, ELineCap eCap,
+			uint32 color, uint8 alpha = 255);
+
+		// 선이 칠할 수 있는 [left, right) x [top, bottom) 영역 (join, cap 포함)
+		static void computeBounds(std::span<const Float2> points, float width, ELineJoin eJoin, ELineCap eCap,
+			int32& left, int32& top, int32& right, int32& bottom) noexcept;
+
+	private:
+		// 넓이가 음수이면 거꾸로 넣어서 모든 다각형의 감긴 방향을 맞춘다. 영역에 닿지 않으면 넣지 않는다.
+		void addPolygon(const Float2* vertices, uint32 count) noexcept;
+		void addCircle(const Float2& center) noexcept;
+		// 두 선분 사이의 바깥쪽 틈을 채운다. direction은 단위 벡터
+		void addJoin(const Float2& point, const Float2& directionA, const Float2& directionB, ELineJoin eJoin, float halfWidth) noexcept;
+		void addEdge(float x0, float y0, float x1, float y1) noexcept;
+		// x는 _left 기준 (0 <= x <= _width), y는 target 기준이다. y0 < y1
+		void accumulateEdge(float x0, float y0, float x1, float y1, float direction) noexcept;
+
+	private:
+		// 누적 버퍼가 덮는 영역
+		// 가로는 clip rectangle과 관계없이 선의 영역 전체(target 안쪽)를 누적하고, 각 행의 값은 그 행의 좌표만으로 계산한다.
+		// 그래서 어떤 clip rectangle로 나누어 그려도 (TileRasterizer, dirty region) 결과가 픽셀 단위로 같다.
+		int32					_left{};
+		int32					_top{};
+		int32					_width{};
+		int32					_height{};
+		// 한 행의 칸 수 (_width + 2)
+		int32					_rowStride{};
+
+	private:
+		// 사용하지 않을 때는 항상 0이다.
+		std::vector<float>		_vAccumulation{};
+		std::vector<uint8>		_vCoverageRow{};
+		// 반지름이 두께 / 2인 원 (원점 중심)
+		std::vector<Float2>		_vCircle{};
+	};
+}
+
+
+// === HEADER ENDS ===
+#endif // !FS_POLYLINE_RASTERIZER_H
@@ -0,0 +1,86 @@
+﻿#include "TextLayout.h"
+#include <Core/Framebuffer.h>
+
+
+namespace fs
+{
+	TextLayout::TextLayout()
+	{
+		__noop;
+	}
+
+	TextLayout::~TextLayout()
+	{
+		__noop;
+	}
+
+	void TextLayout::build(const GlyphAtlas& glyphAtlas, std::wstring_view text, int32 x, int32 y)
+	{
+		_vPlacedGlyphs.clear();
+		_vPlacedGlyphs.reserve(text.size());
+
+		int32 left{};
+		int32 top{};
+		int32 right{};
+		int32 bottom{};
+		glyphAtlas.computeTextBounds(text, left, top, right, bottom);
+		_left = x + left;
+		_top = y + top;
+		_right = x + right;
+		_bottom = y + bottom;
+
+		int32 penX{ x };
+		for (const wchar_t codePoint : text)
+		{
+			const GlyphInfo* const glyph{ glyphAtlas.findGlyph(codePoint) };
+			if (glyph == nullptr) continue;
+
+			if (glyph->width > 0 && glyph->height > 0)
+			{
+				PlacedGlyph placedGlyph{};
+				placedGlyph.x = penX;
+				placedGlyph.y = y;
+				placedGlyph.glyph = *glyph;
+				_vPlacedGlyphs.emplace_back(placedGlyph);
+			}
+			penX += glyph->advance;
+		}
+		_atlasGeneration = glyphAtlas.getGeneration();
+	}
+
+	void TextLayout::clear() noexcept
+	{
+		_vPlacedGlyphs.clear();
+		_left = 0;
+		_top = 0;
+		_right = 0;
+		_bottom = 0;
+		_atlasGeneration = 0;
+	}
+
+	void TextLayout::draw(Framebuffer& target, const GlyphAtlas& glyphAtlas, uint32 color) const noexcept
+	{
+		for (const auto& placedGlyph : _vPlacedGlyphs)
+		{
+			glyphAtlas.drawGlyph(target, placedGlyph.x, placedGlyph.y, placedGlyph.glyph, color);
+		}
+	}
+
+	bool TextLayout::isValid(const GlyphAtlas& glyphAtlas) const noexcept
+	{
+		return (_atlasGeneration != 0 && _atlasGeneration == glyphAtlas.getGeneration());
+	}
+
+	void TextLayout::getBounds(int32& left, int32& top, int32& right, int32& bottom) const noexcept
+	{
+		left = _left;
+		top = _top;
+		right = _right;
+		bottom = _bottom;
+	}
+
+	uint32 TextLayout::getGlyphCount() const noexcept
+	{
+		return static_cast<uint32>(_vPlacedGlyphs.size());
+	}
+}
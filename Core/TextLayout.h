@@ -0,0 +1,69 @@
+﻿#pragma once
+
+
+#ifndef FS_TEXT_LAYOUT_H
+#define FS_TEXT_LAYOUT_H
+// === HEADER BEGINS ===
+
+
+#include <Core/_CommonTypes.h>
+#include <Core/GlyphAtlas.h>
+
+#include <string_view>
+
+
+namespace fs
+{
+	class Framebuffer;
+
+
+	// 한 줄의 텍스트를 glyph atlas로 미리 배치해 둔 것. 글자마다 위치와 atlas 안의 영역을 한 번만 계산해 두고,
+	// draw()에서는 atlas를 찾거나 정렬 계산을 하지 않고 복사만 한다. 바뀌지 않는 문자열을 매 프레임 그릴 때 쓴다.
+	// atlas의 generation이 바뀌면 (폰트가 바뀌면) isValid()가 false가 되므로 build()를 다시 호출해야 한다.
+	class TextLayout final
+	{
+	public:
+		TextLayout();
+		~TextLayout();
+
+	public:
+		// (x, y)는 글자 줄의 왼쪽 위이다. atlas에 없는 글자는 건너뛴다.
+		void build(const GlyphAtlas& glyphAtlas, std::wstring_view text, int32 x, int32 y);
+		void clear() noexcept;
+
+		// glyphAtlas는 build()에 쓴 것과 같아야 한다.
+		void draw(Framebuffer& target, const GlyphAtlas& glyphAtlas, uint32 color) const noexcept;
+
+	public:
+		// glyphAtlas로 build()한 뒤 atlas의 글자가 옮겨지거나 지워지지 않았으면 true
+		bool isValid(const GlyphAtlas& glyphAtlas) const noexcept;
+
+		// 글자 bitmap들과 글자 줄 상자를 모두 감싸는 [left, right) x [top, bottom) 영역
+		void getBounds(int32& left, int32& top, int32& right, int32& bottom) const noexcept;
+		uint32 getGlyphCount() const noexcept;
+
+	private:
+		struct PlacedGlyph
+		{
+			// 펜 위치 (글자 줄의 왼쪽 위)
+			int32		x{};
+			int32		y{};
+			// atlas의 글자 정보를 복사해 둔다. (atlas에 글자가 늘어도 기존 글자의 위치는 바뀌지 않는다.)
+			GlyphInfo	glyph{};
+		};
+
+	private:
+		// bitmap이 없는 글자(공백 등)는 넣지 않는다.
+		std::vector<PlacedGlyph>	_vPlacedGlyphs{};
+		int32						_left{};
+		int32						_top{};
+		int32						_right{};
+		int32						_bottom{};
+		// build()했을 때 atlas의 generation. 0이면 build()하지 않은 것
+		uint32						_atlasGeneration{};
+	};
+}
+
+
+// === HEADER ENDS ===
+#endif // !FS_TEXT_LAYOUT_H
@@ -0,0 +1,109 @@
+﻿#include "TileRasterizer.h"
+#include <Core/Framebuffer.h>
+#include <Core/DrawCommandList.h>
+
+
+namespace fs
+{
+	TileRasterizer::TileRasterizer(uint32 threadCount, uint32 tileSize)
+		: _threadPool{ threadCount }
+		, _tileSize{ (tileSize == 0) ? kDefaultTileSize : tileSize }
+	{
+		__noop;
+	}
+
+	TileRasterizer::~TileRasterizer()
+	{
+		__noop;
+	}
+
+	void TileRasterizer::rasterize(DrawCommandList& commandList, Framebuffer& target, FramebufferCommandExecutor& executor)
+	{
+		commandList.sort();
+
+		const int32 width{ static_cast<int32>(target.getWidth()) };
+		const int32 height{ static_cast<int32>(target.getHeight()) };
+		const int32 tileSize{ static_cast<int32>(_tileSize) };
+		const uint32 tileCountX{ (target.getWidth() + _tileSize - 1) / _tileSize };
+		const uint32 tileCountY{ (target.getHeight() + _tileSize - 1) / _tileSize };
+		const uint32 tileCount{ tileCountX * tileCountY };
+
+		if (_vTileOrders.size() < tileCount)
+		{
+			_vTileOrders.resize(tileCount);
+		}
+		for (uint32 tileIndex = 0; tileIndex < tileCount; ++tileIndex)
+		{
+			_vTileOrders[tileIndex].clear();
+		}
+
+		// binning. order 순으로 넣으므로 각 타일 안에서도 실행 순서가 유지된다.
+		const uint32 commandCount{ commandList.getCommandCount() };
+		for (uint32 order = 0; order < commandCount; ++order)
+		{
+			const DrawCommand& command{ commandList.getCommand(commandList.getSortedIndex(order)) };
+			int32 left{};
+			int32 top{};
+			int32 right{};
+			int32 bottom{};
+			if (command.eType == EDrawCommandType::Text)
+			{
+				// 글자 rasterize는 atlas를 바꾸므로 타일을 그리기 전에 여기서 끝낸다.
+				executor.prepareText(command, commandList.getText(command), left, top, right, bottom);
+			}
+			else
+			{
+				DrawCommandList::computeBounds(command, left, top, right, bottom);
+			}
+
+			if (left < 0) left = 0;
+			if (top < 0) top = 0;
+			if (right > width) right = width;
+			if (bottom > height) bottom = height;
+			if (left >= right || top >= bottom) continue;
+
+			const int32 tileLeft{ left / tileSize };
+			const int32 tileTop{ top / tileSize };
+			const int32 tileRight{ (right - 1) / tileSize };
+			const int32 tileBottom{ (bottom - 1) / tileSize };
+			for (int32 tileY = tileTop; tileY <= tileBottom; ++tileY)
+			{
+				for (int32 tileX = tileLeft; tileX <= tileRight; ++tileX)
+				{
+					_vTileOrders[tileY * tileCountX + tileX].emplace_back(order);
+				}
+			}
+		}
+
+		_threadPool.parallelFor(tileCount,
+			[&](uint32 tileIndex, uint32 threadIndex)
+			{
+				(void)threadIndex;
+
+				const std::vector<uint32>& vOrders{ _vTileOrders[tileIndex] };
+				if (vOrders.empty() == true) return;
+
+				const int32 tileX{ static_cast<int32>(tileIndex % tileCountX) * tileSize };
+				const int32 tileY{ static_cast<int32>(tileIndex / tileCountX) * tileSize };
+				Framebuffer tileView{ target.getPixels(), target.getWidth(), target.getHeight(), target.getStride() };
+				tileView.setClipRectangle(tileX, tileY, tileX + tileSize, tileY + tileSize);
+				for (const uint32 order : vOrders)
+				{
+					const DrawCommand& command{ commandList.getCommand(commandList.getSortedIndex(order)) };
+					executor.executeOn(tileView, command, commandList.getPoints(command), commandList.getText(command));
+				}
+			});
+
+		executor.endReplay();
+	}
+
+	uint32 TileRasterizer::getThreadCount() const noexcept
+	{
+		return _threadPool.getThreadCount();
+	}
+
+	uint32 TileRasterizer::getTileSize() const noexcept
+	{
+		return _tileSize;
+	}
+}
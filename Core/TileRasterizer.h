@@ -0,0 +1,55 @@
+﻿#pragma once
+
+
+#ifndef FS_TILE_RASTERIZER_H
+#define FS_TILE_RASTERIZER_H
+// === HEADER BEGINS ===
+
+
+#include <Core/_CommonTypes.h>
+#include <Utilities/ThreadPool.h>
+
+
+namespace fs
+{
+	class Framebuffer;
+	class DrawCommandList;
+	class FramebufferCommandExecutor;
+
+
+	// DrawCommandList를 화면 타일 단위로 나누어 여러 스레드에서 그린다.
+	// 명령마다 영역이 겹치는 타일에만 등록(binning)하고, 각 타일은 자기 영역으로 clip된 view에
+	// 정렬된 순서대로 명령을 실행한다. 타일끼리는 픽셀을 공유하지 않으므로 잠금이 필요 없고,
+	// 결과는 DrawCommandList::replay()와 픽셀 단위로 같다.
+	class TileRasterizer final
+	{
+	public:
+		static constexpr uint32 kDefaultTileSize{ 64 };
+
+	public:
+		// threadCount는 호출한 스레드를 포함한 수. 0이면 하드웨어 스레드 수
+		explicit TileRasterizer(uint32 threadCount = 0, uint32 tileSize = kDefaultTileSize);
+		~TileRasterizer();
+
+	public:
+		// Text 명령은 binning할 때 호출한 스레드에서 executor.prepareText()로 글자를 준비하고 영역을 구한 뒤,
+		// 다른 명령과 같이 각 타일 안에서 정렬된 순서대로 그린다.
+		void rasterize(DrawCommandList& commandList, Framebuffer& target, FramebufferCommandExecutor& executor);
+
+	public:
+		uint32 getThreadCount() const noexcept;
+		uint32 getTileSize() const noexcept;
+
+	private:
+		ThreadPool							_threadPool;
+		uint32								_tileSize{};
+
+	private:
+		// 타일마다 그릴 명령의 실행 순서(DrawCommandList::getSortedIndex()의 order). 프레임마다 재사용한다.
+		std::vector<std::vector<uint32>>	_vTileOrders{};
+	};
+}
+
+
+// === HEADER ENDS ===
+#endif // !FS_TILE_RASTERIZER_H
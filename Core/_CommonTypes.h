@@ -7,7 +7,15 @@
 
 
 #include <Core/pch.h>
+#if defined(_WIN32)
 #include <sal.h>
+#endif
+
+
+// MSVC 전용 키워드를 다른 컴파일러(Linux 빌드)에서도 쓸 수 있게 한다.
+#if !defined(_MSC_VER)
+#define __noop ((void)0)
+#endif
 
 
 namespace fs
@@ -24,7 +32,7 @@ namespace fs
 	using uint64	= uint64_t;
 	using byte		= uint8;
 
-	static constexpr fs::uint32		kUint32Max{ 0xFFFFFFFFui32 };
+	static constexpr fs::uint32		kUint32Max{ 0xFFFFFFFFu };
 #endif // FS_INT_TYPE_ALIASES
 }
 
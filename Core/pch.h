@@ -8,8 +8,10 @@
 
 #include <cstdint>
 
+#if defined(_WIN32)
 #define WIN32_LEAN_AND_MEAN // 거의 사용되지 않는 내용을 Windows 헤더에서 제외합니다.
 #include <Windows.h>
+#endif
 
 #include <vector>
 
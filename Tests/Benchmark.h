@@ -0,0 +1,40 @@
+﻿#pragma once
+
+
+#ifndef FS_BENCHMARK_H
+#define FS_BENCHMARK_H
+// === HEADER BEGINS ===
+
+
+#include <Core/_CommonTypes.h>
+
+#include <chrono>
+
+
+namespace fs
+{
+	// work()를 repeatCount번 실행하고 한 번에 걸린 평균 시간(ms)
+	template <typename Work>
+	inline double measureMilliseconds(uint32 repeatCount, const Work& work)
+	{
+		const auto begin{ std::chrono::steady_clock::now() };
+		for (uint32 repeat = 0; repeat < repeatCount; ++repeat)
+		{
+			work();
+		}
+		const auto end{ std::chrono::steady_clock::now() };
+		return std::chrono::duration<double, std::milli>(end - begin).count() / repeatCount;
+	}
+
+	// 결과를 쓰지 않는 계산이 최적화로 없어지지 않게 한다.
+	template <typename T>
+	inline void keepResult(const T& value) noexcept
+	{
+		static volatile T sSink{};
+		sSink = value;
+	}
+}
+
+
+// === HEADER ENDS ===
+#endif // !FS_BENCHMARK_H
@@ -0,0 +1,223 @@
+﻿#include <Core/FastMath.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+
+// Sweeps the ranges documented in FastMath.h against double precision libm and checks the stated max ulp:
+// the span kernels (AVX2 when available), fastmath::Fast (SSE2, lane 0), the scalar polynomials used in
+// constant evaluation, and fastmath::Precise (libm).
+namespace fs
+{
+	static constexpr double kPi{ 3.14159265358979323846 };
+
+	static constexpr double kSinCosMaxUlp{ 2.0 };
+	static constexpr double kTanMaxUlp{ 3.0 };
+	static constexpr double kSqrtMaxUlp{ 4.0 };
+	static constexpr double kPreciseMaxUlp{ 1.0 };
+	// 1 / sqrtf(x) rounds twice
+	static constexpr double kPreciseRsqrtMaxUlp{ 1.5 };
+
+	// |value - reference| in units of the float ulp at the reference
+	static double getUlpError(float value, double reference) noexcept
+	{
+		const float rounded{ std::fabs(static_cast<float>(reference)) };
+		float ulp{ std::nextafter(rounded, INFINITY) - rounded };
+		if (ulp == 0.0f)
+		{
+			ulp = std::numeric_limits<float>::denorm_min();
+		}
+		return std::fabs(static_cast<double>(value) - reference) / ulp;
+	}
+
+	class MaxUlpError final
+	{
+	public:
+		MaxUlpError(const char* name, double maxUlp) : _name{ name }, _maxUlp{ maxUlp } { __noop; }
+
+	public:
+		void add(float input, float value, double reference) noexcept
+		{
+			const double error{ getUlpError(value, reference) };
+			if (error > _error)
+			{
+				_error = error;
+				_worstInput = input;
+			}
+		}
+
+		bool report() const noexcept
+		{
+			const bool bPassed{ _error <= _maxUlp };
+			std::printf("  %-24s %6.2f ulp (max %.1f) at %.9g  %s\n", _name, _error, _maxUlp, _worstInput, (bPassed == true) ? "ok" : "FAILED");
+			return bPassed;
+		}
+
+	private:
+		const char*	_name{};
+		double		_maxUlp{};
+		double		_error{};
+		float		_worstInput{};
+	};
+
+	// |x| <= pi, evenly spaced. The odd count puts the sweep off the multiples of pi / 4.
+	static std::vector<float> makeAngles() noexcept
+	{
+		constexpr uint32 kCount{ 1000001 };
+		std::vector<float> vAngles(kCount);
+		for (uint32 i = 0; i < kCount; ++i)
+		{
+			vAngles[i] = static_cast<float>(-kPi + 2.0 * kPi * i / (kCount - 1));
+		}
+		return vAngles;
+	}
+
+	// [1e-30, 1e30], logarithmically spaced
+	static std::vector<float> makeRootInputs() noexcept
+	{
+		std::vector<float> vValues{};
+		for (double x = 1e-30; x <= 1e30; x *= 1.0001)
+		{
+			vValues.emplace_back(static_cast<float>(x));
+		}
+		return vValues;
+	}
+
+	static bool testSinCos(const std::vector<float>& vAngles)
+	{
+		std::vector<float> vSines(vAngles.size());
+		std::vector<float> vCosines(vAngles.size());
+		fastmath::sinCos(vAngles, vSines, vCosines);
+
+		MaxUlpError kernelSin{ "sin (span kernel)", kSinCosMaxUlp };
+		MaxUlpError kernelCos{ "cos (span kernel)", kSinCosMaxUlp };
+		MaxUlpError fastSin{ "sin (Fast)", kSinCosMaxUlp };
+		MaxUlpError fastCos{ "cos (Fast)", kSinCosMaxUlp };
+		MaxUlpError scalarSin{ "sin (constexpr scalar)", kSinCosMaxUlp };
+		MaxUlpError scalarCos{ "cos (constexpr scalar)", kSinCosMaxUlp };
+		MaxUlpError preciseSin{ "sin (Precise)", kPreciseMaxUlp };
+		MaxUlpError preciseCos{ "cos (Precise)", kPreciseMaxUlp };
+		for (size_t i = 0; i < vAngles.size(); ++i)
+		{
+			const float angle{ vAngles[i] };
+			const double referenceSin{ std::sin(static_cast<double>(angle)) };
+			const double referenceCos{ std::cos(static_cast<double>(angle)) };
+			kernelSin.add(angle, vSines[i], referenceSin);
+			kernelCos.add(angle, vCosines[i], referenceCos);
+
+			float sine{};
+			float cosine{};
+			fastmath::Fast::sinCos(angle, sine, cosine);
+			fastSin.add(angle, sine, referenceSin);
+			fastCos.add(angle, cosine, referenceCos);
+
+			fastmath::sinCosScalar(angle, sine, cosine);
+			scalarSin.add(angle, sine, referenceSin);
+			scalarCos.add(angle, cosine, referenceCos);
+
+			fastmath::Precise::sinCos(angle, sine, cosine);
+			preciseSin.add(angle, sine, referenceSin);
+			preciseCos.add(angle, cosine, referenceCos);
+		}
+
+		bool bPassed{ true };
+		for (const MaxUlpError* maxUlpError : { &kernelSin, &kernelCos, &fastSin, &fastCos, &scalarSin, &scalarCos, &preciseSin, &preciseCos })
+		{
+			bPassed = maxUlpError->report() && bPassed;
+		}
+		return bPassed;
+	}
+
+	static bool testTan(const std::vector<float>& vAngles)
+	{
+		std::vector<float> vTangents(vAngles.size());
+		fastmath::tan(vAngles, vTangents);
+
+		MaxUlpError kernelTan{ "tan (span kernel)", kTanMaxUlp };
+		MaxUlpError fastTan{ "tan (Fast)", kTanMaxUlp };
+		MaxUlpError scalarTan{ "tan (constexpr scalar)", kTanMaxUlp };
+		MaxUlpError preciseTan{ "tan (Precise)", kPreciseMaxUlp };
+		for (size_t i = 0; i < vAngles.size(); ++i)
+		{
+			const float angle{ vAngles[i] };
+			// documented away from the poles only
+			if (std::fabs(std::cos(static_cast<double>(angle))) <= 0.01) continue;
+
+			const double reference{ std::tan(static_cast<double>(angle)) };
+			kernelTan.add(angle, vTangents[i], reference);
+			fastTan.add(angle, fastmath::Fast::tan(angle), reference);
+			scalarTan.add(angle, fastmath::tanScalar(angle), reference);
+			preciseTan.add(angle, fastmath::Precise::tan(angle), reference);
+		}
+
+		bool bPassed{ true };
+		for (const MaxUlpError* maxUlpError : { &kernelTan, &fastTan, &scalarTan, &preciseTan })
+		{
+			bPassed = maxUlpError->report() && bPassed;
+		}
+		return bPassed;
+	}
+
+	static bool testRoots(const std::vector<float>& vValues)
+	{
+		std::vector<float> vRsqrts(vValues.size());
+		std::vector<float> vSqrts(vValues.size());
+		fastmath::rsqrt(vValues, vRsqrts);
+		fastmath::sqrt(vValues, vSqrts);
+
+		MaxUlpError kernelRsqrt{ "rsqrt (span kernel)", kSqrtMaxUlp };
+		MaxUlpError kernelSqrt{ "sqrt (span kernel)", kSqrtMaxUlp };
+		MaxUlpError fastRsqrt{ "rsqrt (Fast)", kSqrtMaxUlp };
+		MaxUlpError fastSqrt{ "sqrt (Fast)", kSqrtMaxUlp };
+		MaxUlpError preciseRsqrt{ "rsqrt (Precise)", kPreciseRsqrtMaxUlp };
+		MaxUlpError preciseSqrt{ "sqrt (Precise)", kPreciseMaxUlp };
+		for (size_t i = 0; i < vValues.size(); ++i)
+		{
+			const float value{ vValues[i] };
+			const double referenceSqrt{ std::sqrt(static_cast<double>(value)) };
+			const double referenceRsqrt{ 1.0 / referenceSqrt };
+			kernelRsqrt.add(value, vRsqrts[i], referenceRsqrt);
+			kernelSqrt.add(value, vSqrts[i], referenceSqrt);
+			fastRsqrt.add(value, fastmath::Fast::rsqrt(value), referenceRsqrt);
+			fastSqrt.add(value, fastmath::Fast::sqrt(value), referenceSqrt);
+			preciseRsqrt.add(value, fastmath::Precise::rsqrt(value), referenceRsqrt);
+			preciseSqrt.add(value, fastmath::Precise::sqrt(value), referenceSqrt);
+		}
+
+		// sqrt(0) is documented as 0, not NaN
+		const float zero{};
+		float sqrtOfZero{ 1.0f };
+		fastmath::sqrt(std::span<const float>(&zero, 1), std::span<float>(&sqrtOfZero, 1));
+		const bool bZeroPassed{ sqrtOfZero == 0.0f && fastmath::Fast::sqrt(0.0f) == 0.0f };
+		std::printf("  %-24s %s\n", "sqrt(0) == 0", (bZeroPassed == true) ? "ok" : "FAILED");
+
+		bool bPassed{ bZeroPassed };
+		for (const MaxUlpError* maxUlpError : { &kernelRsqrt, &kernelSqrt, &fastRsqrt, &fastSqrt, &preciseRsqrt, &preciseSqrt })
+		{
+			bPassed = maxUlpError->report() && bPassed;
+		}
+		return bPassed;
+	}
+}
+
+int main()
+{
+	using namespace fs;
+
+	const std::vector<float> vAngles{ makeAngles() };
+	const std::vector<float> vRootInputs{ makeRootInputs() };
+
+	bool bPassed{ true };
+	std::printf("sin, cos: |x| <= pi\n");
+	bPassed = testSinCos(vAngles) && bPassed;
+	std::printf("tan: |x| <= pi, |cos x| > 0.01\n");
+	bPassed = testTan(vAngles) && bPassed;
+	std::printf("rsqrt, sqrt: [1e-30, 1e30], %zu values\n", vRootInputs.size());
+	bPassed = testRoots(vRootInputs) && bPassed;
+	std::printf("%s\n", (bPassed == true) ? "PASSED" : "FAILED");
+	return (bPassed == true) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,82 @@
+﻿#include <Core/Float4Stream.h>
+#include "Benchmark.h"
+#include "SimdLevelOption.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+
+// Throughput of the Float4Stream kernels against the same work done one Float4 at a time (AoS).
+// Without an argument, runs once per supported SIMD level.
+// usage: Float4StreamBench [sse2|sse41|avx2|avx512]
+namespace fs
+{
+	// 64K vectors: 1 MB per AoS array, the streams stay in L2/L3 on most CPUs
+	static constexpr size_t kVectorCount{ 1 << 16 };
+	static constexpr uint32 kRepeatCount{ 200 };
+
+	static void report(const char* name, double aosMilliseconds, double streamMilliseconds) noexcept
+	{
+		const double aosRate{ kVectorCount / aosMilliseconds / 1000.0 };
+		const double streamRate{ kVectorCount / streamMilliseconds / 1000.0 };
+		std::printf("  %-10s Float4 %8.1f M/s   Float4Stream %8.1f M/s   x%.2f\n", name, aosRate, streamRate, streamRate / aosRate);
+	}
+
+	static void runBenchmark()
+	{
+		std::mt19937 random{ 5489u };
+		std::uniform_real_distribution<float> element{ -10.0f, 10.0f };
+
+		std::vector<Float4> vA(kVectorCount);
+		std::vector<Float4> vB(kVectorCount);
+		for (size_t i = 0; i < kVectorCount; ++i)
+		{
+			vA[i] = Float4(element(random), element(random), element(random), element(random));
+			vB[i] = Float4(element(random), element(random), element(random), element(random));
+		}
+		const Float4x4 m{ Float4x4::rotationMatrixY(0.5f) * Float4x4::projectionMatrixPerspective(1.0f, 0.1f, 100.0f, 1.5f) };
+
+		const Float4Stream a{ vA };
+		const Float4Stream b{ vB };
+		Float4Stream streamOut{ kVectorCount };
+		std::vector<Float4> vOut(kVectorCount);
+		std::vector<float> vFloats(kVectorCount);
+
+		report("dot",
+			measureMilliseconds(kRepeatCount, [&]() { for (size_t i = 0; i < kVectorCount; ++i) vFloats[i] = Float4::dot(vA[i], vB[i]); keepResult(vFloats[7]); }),
+			measureMilliseconds(kRepeatCount, [&]() { Float4Stream::dot(a, b, vFloats.data()); keepResult(vFloats[7]); }));
+		report("cross",
+			measureMilliseconds(kRepeatCount, [&]() { for (size_t i = 0; i < kVectorCount; ++i) vOut[i] = Float4::cross(vA[i], vB[i]); keepResult(vOut[7].getX()); }),
+			measureMilliseconds(kRepeatCount, [&]() { Float4Stream::cross(a, b, streamOut); keepResult(streamOut.getX()[7]); }));
+		report("length",
+			measureMilliseconds(kRepeatCount, [&]() { for (size_t i = 0; i < kVectorCount; ++i) vFloats[i] = Float4::length(vA[i]); keepResult(vFloats[7]); }),
+			measureMilliseconds(kRepeatCount, [&]() { Float4Stream::length(a, vFloats.data()); keepResult(vFloats[7]); }));
+		report("normalize",
+			measureMilliseconds(kRepeatCount, [&]() { for (size_t i = 0; i < kVectorCount; ++i) vOut[i] = Float4::normalize(vA[i]); keepResult(vOut[7].getX()); }),
+			measureMilliseconds(kRepeatCount, [&]() { Float4Stream::normalize(a, streamOut); keepResult(streamOut.getX()[7]); }));
+		report("transform",
+			measureMilliseconds(kRepeatCount, [&]() { for (size_t i = 0; i < kVectorCount; ++i) vOut[i] = Float4x4::mul(m, vA[i]); keepResult(vOut[7].getX()); }),
+			measureMilliseconds(kRepeatCount, [&]() { Float4Stream::transform(m, a, streamOut); keepResult(streamOut.getX()[7]); }));
+	}
+}
+
+int main(int argc, char** argv)
+{
+	using namespace fs;
+
+	if (argc < 2)
+	{
+		return (runForEachSimdLevel(argv[0]) == true) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	if (applySimdLevelOption(argv[1]) == false)
+	{
+		std::printf("unknown SIMD level: %s\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+	std::printf("%s, %zu vectors\n", getSimdLevelName(getSimdLevel()), kVectorCount);
+	runBenchmark();
+	return EXIT_SUCCESS;
+}
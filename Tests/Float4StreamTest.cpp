@@ -0,0 +1,176 @@
+﻿#include <Core/Float4Stream.h>
+#include "SimdLevelOption.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+
+// Compares the Float4Stream kernels with the scalar Float4 functions for every count in [1, 100] and a few long
+// streams, so each kernel width and every tail length runs. Without an argument, runs once per supported SIMD level.
+namespace fs
+{
+	// The kernels may use FMA and sum in another order than Float4.
+	static constexpr float kMaxRelativeError{ 1e-5f };
+
+	static bool isClose(float value, float reference) noexcept
+	{
+		return std::fabs(value - reference) <= kMaxRelativeError * std::max(1.0f, std::fabs(reference));
+	}
+
+	static bool isClose(const Float4& value, const Float4& reference) noexcept
+	{
+		return isClose(value.getX(), reference.getX()) && isClose(value.getY(), reference.getY())
+			&& isClose(value.getZ(), reference.getZ()) && isClose(value.getW(), reference.getW());
+	}
+
+	static bool isEqual(const Float4& value, const Float4& reference) noexcept
+	{
+		return value.getX() == reference.getX() && value.getY() == reference.getY() && value.getZ() == reference.getZ() && value.getW() == reference.getW();
+	}
+
+	class Check final
+	{
+	public:
+		explicit Check(const char* name) : _name{ name } { __noop; }
+
+	public:
+		void add(bool bPassed, size_t count, size_t index) noexcept
+		{
+			if (bPassed == false && _failureCount++ == 0)
+			{
+				std::printf("  %s: first mismatch at count %zu, index %zu\n", _name, count, index);
+			}
+		}
+
+		bool report() const noexcept
+		{
+			std::printf("  %-20s %s\n", _name, (_failureCount == 0) ? "ok" : "FAILED");
+			return _failureCount == 0;
+		}
+
+	private:
+		const char*	_name{};
+		uint32		_failureCount{};
+	};
+
+	static bool testKernels()
+	{
+		std::mt19937 random{ 5489u };
+		std::uniform_real_distribution<float> element{ -10.0f, 10.0f };
+		auto randomVector = [&]() { return Float4(element(random), element(random), element(random), element(random)); };
+
+		const Float4x4 m
+		{
+			element(random), element(random), element(random), element(random),
+			element(random), element(random), element(random), element(random),
+			element(random), element(random), element(random), element(random),
+			element(random), element(random), element(random), element(random),
+		};
+
+		std::vector<size_t> vCounts{};
+		for (size_t count = 1; count <= 100; ++count)
+		{
+			vCounts.emplace_back(count);
+		}
+		vCounts.emplace_back(1000);
+		vCounts.emplace_back(4099);
+
+		Check conversion{ "assign / toVector" };
+		Check dot{ "dot" };
+		Check cross{ "cross" };
+		Check length{ "length" };
+		Check normalize{ "normalize" };
+		Check normalizeInPlace{ "normalize in place" };
+		Check transform{ "transform" };
+		Check transformInPlace{ "transform in place" };
+		for (const size_t count : vCounts)
+		{
+			std::vector<Float4> vA(count);
+			std::vector<Float4> vB(count);
+			for (size_t i = 0; i < count; ++i)
+			{
+				vA[i] = randomVector();
+				vB[i] = randomVector();
+			}
+			const Float4Stream a{ vA };
+			const Float4Stream b{ vB };
+
+			const std::vector<Float4> vConverted{ a.toVector() };
+			for (size_t i = 0; i < count; ++i)
+			{
+				conversion.add(isEqual(vConverted[i], vA[i]), count, i);
+			}
+
+			std::vector<float> vFloats(count);
+			Float4Stream::dot(a, b, vFloats.data());
+			for (size_t i = 0; i < count; ++i)
+			{
+				dot.add(isClose(vFloats[i], Float4::dot(vA[i], vB[i])), count, i);
+			}
+
+			Float4Stream out{};
+			Float4Stream::cross(a, b, out);
+			for (size_t i = 0; i < count; ++i)
+			{
+				cross.add(out.size() == count && isClose(out.get(i), Float4::cross(vA[i], vB[i])), count, i);
+			}
+
+			Float4Stream::length(a, vFloats.data());
+			for (size_t i = 0; i < count; ++i)
+			{
+				length.add(isClose(vFloats[i], Float4::length(vA[i])), count, i);
+			}
+
+			Float4Stream::normalize(a, out);
+			Float4Stream inPlace{ a };
+			Float4Stream::normalize(inPlace, inPlace);
+			for (size_t i = 0; i < count; ++i)
+			{
+				const Float4 reference{ Float4::normalize(vA[i]) };
+				normalize.add(isClose(out.get(i), reference), count, i);
+				normalizeInPlace.add(isClose(inPlace.get(i), reference), count, i);
+			}
+
+			Float4Stream::transform(m, a, out);
+			inPlace = a;
+			Float4Stream::transform(m, inPlace, inPlace);
+			for (size_t i = 0; i < count; ++i)
+			{
+				const Float4 reference{ Float4x4::mul(m, vA[i]) };
+				transform.add(isClose(out.get(i), reference), count, i);
+				transformInPlace.add(isClose(inPlace.get(i), reference), count, i);
+			}
+		}
+
+		bool bPassed{ true };
+		for (const Check* check : { &conversion, &dot, &cross, &length, &normalize, &normalizeInPlace, &transform, &transformInPlace })
+		{
+			bPassed = check->report() && bPassed;
+		}
+		return bPassed;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	using namespace fs;
+
+	if (argc < 2)
+	{
+		const bool bPassed{ runForEachSimdLevel(argv[0]) };
+		std::printf("%s\n", (bPassed == true) ? "PASSED" : "FAILED");
+		return (bPassed == true) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	if (applySimdLevelOption(argv[1]) == false)
+	{
+		std::printf("unknown SIMD level: %s\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+	std::printf("%s\n", getSimdLevelName(getSimdLevel()));
+	return (testKernels() == true) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
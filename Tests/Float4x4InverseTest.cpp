@@ -0,0 +1,116 @@
+﻿#include <Core/Float4x4.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+
+// Compares Float4x4::inverse() (2x2 block method) and Float4x4::inverseAffine() (cross products)
+// with the cofactor expansion adjugate() / determinant() they replaced, on random general and affine matrices.
+namespace fs
+{
+	static constexpr uint32 kMatrixCount{ 10000 };
+	// relative to the largest element of the reference inverse
+	static constexpr float kMaxRelativeError{ 1e-4f };
+
+	class MaxError final
+	{
+	public:
+		explicit MaxError(const char* name) : _name{ name } { __noop; }
+
+	public:
+		void add(const Float4x4& value, const Float4x4& reference) noexcept
+		{
+			float scale{ 1.0f };
+			float error{};
+			for (uint32 row = 0; row < 4; ++row)
+			{
+				for (uint32 column = 0; column < 4; ++column)
+				{
+					const float referenceElement{ reference.getRow(row).get(column) };
+					scale = std::max(scale, std::fabs(referenceElement));
+					error = std::max(error, std::fabs(value.getRow(row).get(column) - referenceElement));
+				}
+			}
+			_error = std::max(_error, error / scale);
+			++_count;
+		}
+
+		bool report() const noexcept
+		{
+			const bool bPassed{ _error <= kMaxRelativeError && _count > 0 };
+			std::printf("  %-36s %5u matrices, max relative error %.3g (max %.0e)  %s\n", _name, _count, _error, kMaxRelativeError,
+				(bPassed == true) ? "ok" : "FAILED");
+			return bPassed;
+		}
+
+	private:
+		const char*	_name{};
+		float		_error{};
+		uint32		_count{};
+	};
+
+	static Float4x4 getReferenceInverse(const Float4x4& m) noexcept
+	{
+		return m.adjugate() / m.determinant();
+	}
+}
+
+int main()
+{
+	using namespace fs;
+
+	std::mt19937 random{ 5489u };
+	std::uniform_real_distribution<float> element{ -2.0f, 2.0f };
+	std::uniform_real_distribution<float> translation{ -100.0f, 100.0f };
+
+	MaxError generalInverse{ "inverse(), general" };
+	MaxError affineInverse{ "inverse(), affine" };
+	MaxError affineInverseAffine{ "inverseAffine(), affine" };
+	bool bLastRowExact{ true };
+	for (uint32 i = 0; i < kMatrixCount; ++i)
+	{
+		// ill-conditioned matrices would measure the reference, not the inverse
+		const Float4x4 general
+		{
+			element(random), element(random), element(random), element(random),
+			element(random), element(random), element(random), element(random),
+			element(random), element(random), element(random), element(random),
+			element(random), element(random), element(random), element(random),
+		};
+		if (std::fabs(general.determinant()) >= 0.5f)
+		{
+			generalInverse.add(general.inverse(), getReferenceInverse(general));
+		}
+
+		const Float4x4 affine
+		{
+			element(random), element(random), element(random), translation(random),
+			element(random), element(random), element(random), translation(random),
+			element(random), element(random), element(random), translation(random),
+			0.0f, 0.0f, 0.0f, 1.0f,
+		};
+		if (std::fabs(affine.determinant()) >= 0.5f)
+		{
+			const Float4x4 reference{ getReferenceInverse(affine) };
+			affineInverse.add(affine.inverse(), reference);
+
+			const Float4x4 inverse{ affine.inverseAffine() };
+			affineInverseAffine.add(inverse, reference);
+			const Float4& lastRow{ inverse.getRow(3) };
+			bLastRowExact = bLastRowExact && lastRow.getX() == 0.0f && lastRow.getY() == 0.0f && lastRow.getZ() == 0.0f && lastRow.getW() == 1.0f;
+		}
+	}
+
+	bool bPassed{ true };
+	bPassed = generalInverse.report() && bPassed;
+	bPassed = affineInverse.report() && bPassed;
+	bPassed = affineInverseAffine.report() && bPassed;
+	std::printf("  %-36s %s\n", "inverseAffine() last row == (0, 0, 0, 1)", (bLastRowExact == true) ? "ok" : "FAILED");
+	bPassed = bPassed && bLastRowExact;
+
+	std::printf("%s\n", (bPassed == true) ? "PASSED" : "FAILED");
+	return (bPassed == true) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,98 @@
+﻿#include <Core/Float4x4.h>
+#include "Benchmark.h"
+#include "SimdLevelOption.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+
+#if defined(_MSC_VER)
+#define FS_NOINLINE __declspec(noinline)
+#else
+#define FS_NOINLINE __attribute__((noinline))
+#endif
+
+
+// Float4x4 * Float4 before and after the header-only rewrite.
+// "before" reproduces the old out-of-line Float4x4::mul(): four Float4::dot() calls, each reducing the product through scalar lane reads.
+// Without an argument, runs once per supported SIMD level.
+// usage: Float4x4MulBench [sse2|sse41|avx2|avx512]
+namespace fs
+{
+	// 64K vectors: 1 MB per array, so the loop is bound by the arithmetic and not by memory
+	static constexpr size_t kVectorCount{ 1 << 16 };
+	static constexpr uint32 kRepeatCount{ 200 };
+
+	static float dotBefore(const Float4& a, const Float4& b) noexcept
+	{
+		const Float4 result{ a * b };
+		return (result.getX() + result.getY() + result.getZ() + result.getW());
+	}
+
+	// The old definition lived in float4x4.cpp, so every call site paid for a call.
+	FS_NOINLINE static Float4 mulBefore(const Float4x4& m, const Float4& v) noexcept
+	{
+		return Float4(
+			dotBefore(m.getRow(0), v),
+			dotBefore(m.getRow(1), v),
+			dotBefore(m.getRow(2), v),
+			dotBefore(m.getRow(3), v)
+		);
+	}
+
+	static void report(const char* name, double milliseconds, double beforeMilliseconds) noexcept
+	{
+		const double nanoseconds{ milliseconds * 1000000.0 / kVectorCount };
+		std::printf("  %-12s %6.2f ns/op %8.1f M/s   x%.2f\n", name, nanoseconds, kVectorCount / milliseconds / 1000.0, beforeMilliseconds / milliseconds);
+	}
+
+	static void runBenchmark()
+	{
+		std::mt19937 random{ 5489u };
+		std::uniform_real_distribution<float> element{ -10.0f, 10.0f };
+
+		std::vector<Float4> vIn(kVectorCount);
+		for (Float4& v : vIn)
+		{
+			v = Float4(element(random), element(random), element(random), 1.0f);
+		}
+		std::vector<Float4> vOut(kVectorCount);
+		const Float4x4 m{ Float4x4::rotationMatrixY(0.5f) * Float4x4::projectionMatrixPerspective(1.0f, 0.1f, 100.0f, 1.5f) };
+
+		const double beforeMilliseconds
+		{
+			measureMilliseconds(kRepeatCount, [&]() { for (size_t i = 0; i < kVectorCount; ++i) vOut[i] = mulBefore(m, vIn[i]); keepResult(vOut[7].getX()); })
+		};
+		report("before", beforeMilliseconds, beforeMilliseconds);
+		report("mul(m, v)",
+			measureMilliseconds(kRepeatCount, [&]() { for (size_t i = 0; i < kVectorCount; ++i) vOut[i] = Float4x4::mul(m, vIn[i]); keepResult(vOut[7].getX()); }),
+			beforeMilliseconds);
+		report("m * v",
+			measureMilliseconds(kRepeatCount, [&]() { for (size_t i = 0; i < kVectorCount; ++i) vOut[i] = m * vIn[i]; keepResult(vOut[7].getX()); }),
+			beforeMilliseconds);
+		report("mulBatch",
+			measureMilliseconds(kRepeatCount, [&]() { Float4x4::mulBatch(m, vIn.data(), vOut.data(), kVectorCount); keepResult(vOut[7].getX()); }),
+			beforeMilliseconds);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	using namespace fs;
+
+	if (argc < 2)
+	{
+		return (runForEachSimdLevel(argv[0]) == true) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	if (applySimdLevelOption(argv[1]) == false)
+	{
+		std::printf("unknown SIMD level: %s\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+	std::printf("%s, %zu vectors\n", getSimdLevelName(getSimdLevel()), kVectorCount);
+	runBenchmark();
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,127 @@
+﻿#include <Core/Framebuffer.h>
+#include "Benchmark.h"
+#include "SimdLevelOption.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+
+// Framebuffer::fillRectangle()의 초당 사각형 수. 불투명(행 단위 store)과 alpha < 255(src-over blend)를
+// 픽셀마다 계산하는 scalar 반복문과 비교한다. (GDI는 Windows가 필요하므로 여기서는 잴 수 없다.)
+// 인자가 없으면 이 CPU가 지원하는 SIMD 수준마다 실행한다. (fill/blend kernel은 SSE2와 AVX2 두 가지)
+// 사용법: FramebufferFillBench [sse2|sse41|avx2|avx512]
+namespace fs
+{
+	static constexpr uint32 kTargetWidth{ 800 };
+	static constexpr uint32 kTargetHeight{ 600 };
+	static constexpr uint32 kRectCount{ 1024 };
+
+	struct Rect
+	{
+		int32	x{};
+		int32	y{};
+		uint32	color{};
+	};
+
+	// Framebuffer.cpp의 blendPixel()과 같은 식을 픽셀마다 계산한다. (불투명한 경우는 컴파일러가 벡터화할 수도 있다.)
+	static void fillRectangleScalar(Framebuffer& target, int32 x, int32 y, int32 width, int32 height, uint32 color, uint8 alpha) noexcept
+	{
+		const int32 right{ std::min(x + width, static_cast<int32>(target.getWidth())) };
+		const int32 bottom{ std::min(y + height, static_cast<int32>(target.getHeight())) };
+		for (int32 row = std::max(y, 0); row < bottom; ++row)
+		{
+			uint32* const pixels{ target.getPixels() + static_cast<size_t>(row) * target.getStride() };
+			for (int32 column = std::max(x, 0); column < right; ++column)
+			{
+				if (alpha == 255)
+				{
+					pixels[column] = color;
+					continue;
+				}
+
+				uint32 result{};
+				for (uint32 shift = 0; shift < 32; shift += 8)
+				{
+					const uint32 t{ ((color >> shift) & 0xFF) * alpha + ((pixels[column] >> shift) & 0xFF) * (255 - alpha) + 128 };
+					result |= (((t + (t >> 8)) >> 8) & 0xFF) << shift;
+				}
+				pixels[column] = result;
+			}
+		}
+	}
+
+	static void runBenchmark()
+	{
+		std::mt19937 random{ 5489u };
+		Framebuffer target{ kTargetWidth, kTargetHeight };
+		target.clear(0xFF202020);
+
+		const uint32 kSizes[]{ 16, 64, 256, kTargetWidth };
+		for (const uint32 size : kSizes)
+		{
+			const uint32 width{ size };
+			const uint32 height{ std::min(size, kTargetHeight) };
+			std::vector<Rect> vRects(kRectCount);
+			for (Rect& rect : vRects)
+			{
+				rect.x = static_cast<int32>(random() % (kTargetWidth - width + 1));
+				rect.y = static_cast<int32>(random() % (kTargetHeight - height + 1));
+				rect.color = static_cast<uint32>(random()) | 0xFF000000;
+			}
+
+			for (const uint8 alpha : { static_cast<uint8>(255), static_cast<uint8>(128) })
+			{
+				// 한 번 잴 때 약 2^26 픽셀
+				const uint32 repeatCount{ std::max(1u, (1u << 26) / (kRectCount * width * height)) };
+				const double scalarMilliseconds
+				{
+					measureMilliseconds(repeatCount, [&]()
+						{
+							for (const Rect& rect : vRects)
+							{
+								fillRectangleScalar(target, rect.x, rect.y, width, height, rect.color, alpha);
+							}
+						})
+				};
+				const double kernelMilliseconds
+				{
+					measureMilliseconds(repeatCount, [&]()
+						{
+							for (const Rect& rect : vRects)
+							{
+								target.fillRectangle(rect.x, rect.y, width, height, rect.color, alpha);
+							}
+						})
+				};
+				keepResult(target.getPixel(7, 7));
+
+				const double scalarRate{ kRectCount / scalarMilliseconds / 1000.0 };
+				const double kernelRate{ kRectCount / kernelMilliseconds / 1000.0 };
+				std::printf("  %3ux%-3u alpha %3u  scalar %10.3f M rects/s   fillRectangle %10.3f M rects/s (%7.0f M pixels/s)   x%.2f\n",
+					width, height, alpha, scalarRate, kernelRate, kernelRate * width * height, kernelRate / scalarRate);
+			}
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	using namespace fs;
+
+	if (argc < 2)
+	{
+		return (runForEachSimdLevel(argv[0]) == true) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	if (applySimdLevelOption(argv[1]) == false)
+	{
+		std::printf("unknown SIMD level: %s\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+	std::printf("%s, %ux%u target\n", getSimdLevelName(getSimdLevel()), kTargetWidth, kTargetHeight);
+	runBenchmark();
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,142 @@
+﻿#include <Core/Affine3x4.h>
+#include <Core/LineClipper.h>
+#include "Benchmark.h"
+#include "SimdLevelOption.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+
+// Throughput of Line3DWindow::drawLines() up to (not including) the rasterizer, for a mesh of 128K lines.
+// "before" is the old per-line path: S matrix, q * v * q^-1, T matrix, projection and perspective divide for both endpoints of every line.
+// "after" is the current path: one combined matrix, Float4x4::mulBatch() over the vertices, then outcodes and frustum clipping.
+// Without an argument, runs once per supported SIMD level.
+// usage: LineTransformBench [sse2|sse41|avx2|avx512]
+namespace fs
+{
+	static constexpr uint32 kLineCount{ 1 << 17 };
+	static constexpr uint32 kRepeatCount{ 20 };
+
+	struct Scene
+	{
+		Float4		translation{ 0, 0, -4.0f, 0 };
+		Float4		scaling{ 1.5f, 1.5f, 1.5f, 0 };
+		Float4		rotationAxis{ Float4::normalize(Float4(1, 2, -1, 0)) };
+		float		rotationAngle{ 0.7f };
+		Float4x4	projectionMatrix{ Float4x4::projectionMatrixPerspective(3.14f / 3.0f, 0.1f, 10.0f, 1.5f) };
+	};
+
+	// The body of the old Line3DWindow::drawLines() loop, without drawLineToScreenNormalized()
+	static uint32 transformLinesBefore(const Scene& scene, const std::vector<Float4>& vVertices, std::vector<Float2>& vEndpoints) noexcept
+	{
+		const Float4x4 scalingMatrix{ Float4x4::scalingMatrix(scene.scaling.getX(), scene.scaling.getY(), scene.scaling.getZ()) };
+		const Float4x4 translationMatrix{ Float4x4::translationMatrix(scene.translation.getX(), scene.translation.getY(), scene.translation.getZ()) };
+
+		uint32 visibleLineCount{};
+		for (uint32 i = 0; i < kLineCount; ++i)
+		{
+			Float4 vertexA{ vVertices[static_cast<size_t>(i) * 2 + 0] };
+			Float4 vertexB{ vVertices[static_cast<size_t>(i) * 2 + 1] };
+
+			vertexA = scalingMatrix * vertexA;
+			vertexB = scalingMatrix * vertexB;
+
+			const Quaternion q = Quaternion::rotationQuaternion(scene.rotationAxis, scene.rotationAngle);
+			const Quaternion qReciprocal = q.reciprocal();
+			vertexA = Float4(q * Quaternion(vertexA) * qReciprocal);
+			vertexB = Float4(q * Quaternion(vertexB) * qReciprocal);
+
+			vertexA = translationMatrix * vertexA;
+			vertexB = translationMatrix * vertexB;
+
+			if (vertexA.getZ() > 0 && vertexB.getZ() > 0) continue;
+
+			vertexA = scene.projectionMatrix * vertexA;
+			vertexB = scene.projectionMatrix * vertexB;
+			if (vertexA.getW() == 0)
+			{
+				vertexA.setW(1.0f);
+			}
+			if (vertexB.getW() == 0)
+			{
+				vertexB.setW(1.0f);
+			}
+			vertexA /= vertexA.getW();
+			vertexB /= vertexB.getW();
+
+			vEndpoints[static_cast<size_t>(visibleLineCount) * 2] = Float2(vertexA.getX(), vertexA.getY());
+			vEndpoints[static_cast<size_t>(visibleLineCount) * 2 + 1] = Float2(vertexB.getX(), vertexB.getY());
+			++visibleLineCount;
+		}
+		return visibleLineCount;
+	}
+
+	// The current Line3DWindow::drawLines(), without drawLinesToScreenNormalized()
+	static uint32 transformLinesAfter(const Scene& scene, const std::vector<Float4>& vVertices, const std::vector<uint32>& vIndices,
+		std::vector<Float4>& vClipVertices, std::vector<uint8>& vOutcodes, std::vector<ClippedLine>& vClippedLines) noexcept
+	{
+		const Quaternion rotation{ Quaternion::rotationQuaternion(scene.rotationAxis, scene.rotationAngle) };
+		const Float4x4 worldProjectionMatrix{ scene.projectionMatrix * Affine3x4::translationRotationScaling(scene.translation, rotation, scene.scaling).toFloat4x4() };
+		Float4x4::mulBatch(worldProjectionMatrix, vVertices.data(), vClipVertices.data(), vVertices.size());
+		LineClipper::computeOutcodes(vClipVertices.data(), vOutcodes.data(), vClipVertices.size());
+		return LineClipper::clipLines(vClipVertices.data(), vOutcodes.data(), vIndices.data(), kLineCount, vClippedLines.data());
+	}
+
+	static void runBenchmark()
+	{
+		std::mt19937 random{ 5489u };
+		std::uniform_real_distribution<float> coordinate{ -1.0f, 1.0f };
+
+		// Two vertices per line, as the old Line3DWindow stored them
+		std::vector<Float4> vVertices(static_cast<size_t>(kLineCount) * 2);
+		std::vector<uint32> vIndices(vVertices.size());
+		for (size_t i = 0; i < vVertices.size(); ++i)
+		{
+			vVertices[i] = Float4(coordinate(random), coordinate(random), coordinate(random), 1.0f);
+			vIndices[i] = static_cast<uint32>(i);
+		}
+
+		const Scene scene{};
+		std::vector<Float2> vEndpoints(vVertices.size());
+		std::vector<Float4> vClipVertices(vVertices.size());
+		std::vector<uint8> vOutcodes(vVertices.size());
+		std::vector<ClippedLine> vClippedLines(kLineCount);
+
+		uint32 beforeLineCount{};
+		uint32 afterLineCount{};
+		const double beforeMilliseconds
+		{
+			measureMilliseconds(kRepeatCount, [&]() { beforeLineCount = transformLinesBefore(scene, vVertices, vEndpoints); keepResult(vEndpoints[7].x); })
+		};
+		const double afterMilliseconds
+		{
+			measureMilliseconds(kRepeatCount, [&]() { afterLineCount = transformLinesAfter(scene, vVertices, vIndices, vClipVertices, vOutcodes, vClippedLines); keepResult(vClippedLines[7].a.x); })
+		};
+
+		const double beforeRate{ kLineCount / beforeMilliseconds / 1000.0 };
+		const double afterRate{ kLineCount / afterMilliseconds / 1000.0 };
+		std::printf("  before %8.3f ms %8.1f M lines/s (%u drawn)\n", beforeMilliseconds, beforeRate, beforeLineCount);
+		std::printf("  after  %8.3f ms %8.1f M lines/s (%u drawn)   x%.2f\n", afterMilliseconds, afterRate, afterLineCount, afterRate / beforeRate);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	using namespace fs;
+
+	if (argc < 2)
+	{
+		return (runForEachSimdLevel(argv[0]) == true) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	if (applySimdLevelOption(argv[1]) == false)
+	{
+		std::printf("unknown SIMD level: %s\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+	std::printf("%s, %u lines\n", getSimdLevelName(getSimdLevel()), kLineCount);
+	runBenchmark();
+	return EXIT_SUCCESS;
+}
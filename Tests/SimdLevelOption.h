@@ -0,0 +1,60 @@
+﻿#pragma once
+
+
+#ifndef FS_SIMD_LEVEL_OPTION_H
+#define FS_SIMD_LEVEL_OPTION_H
+// === HEADER BEGINS ===
+
+
+#include <Core/CpuFeatures.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <string>
+
+
+// 커널은 프로세스마다 한 번만 고르므로, SIMD 수준마다 자기 자신을 다시 실행해서 모든 커널을 확인한다.
+//   Test           이 CPU가 지원하는 수준마다 "Test <level>"을 실행한다.
+//   Test <level>   sse2, sse41, avx2, avx512 중 하나로 제한하고 실행한다.
+namespace fs
+{
+	static constexpr const char* kSimdLevelNames[]{ "sse2", "sse41", "avx2", "avx512" };
+
+	inline const char* getSimdLevelName(ESimdLevel eSimdLevel) noexcept
+	{
+		return kSimdLevelNames[static_cast<uint32>(eSimdLevel)];
+	}
+
+	// 이름이 맞으면 limitSimdLevel()을 호출하고 true
+	inline bool applySimdLevelOption(const char* name) noexcept
+	{
+		for (uint32 level = 0; level < std::size(kSimdLevelNames); ++level)
+		{
+			if (std::strcmp(name, kSimdLevelNames[level]) == 0)
+			{
+				limitSimdLevel(static_cast<ESimdLevel>(level));
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// 이 CPU가 지원하는 SIMD 수준마다 executable을 다시 실행한다. 모두 성공하면 true
+	inline bool runForEachSimdLevel(const char* executable, const char* arguments = "")
+	{
+		bool bPassed{ true };
+		for (uint32 level = 0; level <= static_cast<uint32>(getSimdLevel()); ++level)
+		{
+			const std::string command{ std::string("\"") + executable + "\" " + kSimdLevelNames[level] + " " + arguments };
+			std::fflush(stdout);
+			bPassed = (std::system(command.c_str()) == 0) && bPassed;
+		}
+		return bPassed;
+	}
+}
+
+
+// === HEADER ENDS ===
+#endif // !FS_SIMD_LEVEL_OPTION_H
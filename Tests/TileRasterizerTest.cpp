@@ -0,0 +1,262 @@
+﻿#include <Core/DrawCommandList.h>
+#include <Core/Framebuffer.h>
+#include <Core/GlyphAtlas.h>
+#include <Core/TextLayout.h>
+#include <Core/TileRasterizer.h>
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <string_view>
+
+
+// 같은 DrawCommandList를 DrawCommandList::replay()와 TileRasterizer로 그려 픽셀이 같은지 확인하고,
+// 스레드 수 1..N에서 걸린 시간을 출력한다. (Windows 없이 빌드된다.)
+// 사용법: TileRasterizerTest [frameCount] [maxThreadCount]
+namespace fs
+{
+	static constexpr uint32 kGlyphWidth{ 7 };
+	static constexpr uint32 kGlyphHeight{ 11 };
+
+	// 글자마다 모양이 다른 가짜 글꼴. 실제 글꼴 대신 coverage를 만들어 넣는다.
+	static void buildTestGlyphAtlas(GlyphAtlas& glyphAtlas)
+	{
+		glyphAtlas.setFontMetrics(14, 11);
+
+		uint8 coverage[kGlyphWidth * kGlyphHeight]{};
+		const std::wstring_view kCharacters{ L"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789" };
+		for (const wchar_t character : kCharacters)
+		{
+			for (uint32 y = 0; y < kGlyphHeight; ++y)
+			{
+				for (uint32 x = 0; x < kGlyphWidth; ++x)
+				{
+					coverage[y * kGlyphWidth + x] = static_cast<uint8>((character * 37 + x * 53 + y * 91) & 0xFF);
+				}
+			}
+			glyphAtlas.addGlyph(character, kGlyphWidth, kGlyphHeight, 0, 1, kGlyphWidth + 1, coverage, kGlyphWidth);
+		}
+		glyphAtlas.addGlyph(L' ', 0, 0, 0, 0, kGlyphWidth + 1, nullptr, 0);
+	}
+
+	// Text 명령은 TextLayout으로 배치해서 그린다. 이미지, 글꼴, TextLayout은 하나씩만 있다.
+	class TestCommandExecutor final : public FramebufferCommandExecutor
+	{
+	public:
+		TestCommandExecutor(Framebuffer& target, const Framebuffer& image, const GlyphAtlas& glyphAtlas, const std::vector<TextLayout>& vTextLayouts)
+			: FramebufferCommandExecutor(target)
+			, _image{ image }
+			, _glyphAtlas{ glyphAtlas }
+			, _vTextLayouts{ vTextLayouts }
+		{
+			__noop;
+		}
+
+	public:
+		virtual void prepareText(const DrawCommand& command, const wchar_t* text, int32& left, int32& top, int32& right, int32& bottom) override
+		{
+			TextLayout textLayout{};
+			textLayout.build(_glyphAtlas, std::wstring_view(text, command.textLength), command.x0, command.y0);
+			textLayout.getBounds(left, top, right, bottom);
+		}
+
+	protected:
+		virtual const Framebuffer* getImage(uint32 imageIndex) const override
+		{
+			return (imageIndex == 0) ? &_image : nullptr;
+		}
+
+		virtual const TextLayout* getTextLayout(uint32 layoutIndex) const override
+		{
+			return (layoutIndex < _vTextLayouts.size()) ? &_vTextLayouts[layoutIndex] : nullptr;
+		}
+
+		virtual const GlyphAtlas* getGlyphAtlas(uint32 fontIndex) const override
+		{
+			return (fontIndex == 0) ? &_glyphAtlas : nullptr;
+		}
+
+		virtual void drawText(Framebuffer& target, const DrawCommand& command, const wchar_t* text) const override
+		{
+			TextLayout textLayout{};
+			textLayout.build(_glyphAtlas, std::wstring_view(text, command.textLength), command.x0, command.y0);
+			textLayout.draw(target, _glyphAtlas, command.color);
+		}
+
+	private:
+		const Framebuffer&				_image;
+		const GlyphAtlas&				_glyphAtlas;
+		const std::vector<TextLayout>&	_vTextLayouts;
+	};
+
+	// 명령 종류를 골고루 섞은 한 프레임. 명령 수는 화면 넓이에 비례한다.
+	static void buildTestScene(DrawCommandList& commandList, std::vector<TextLayout>& vTextLayouts, const GlyphAtlas& glyphAtlas, uint32 width, uint32 height)
+	{
+		std::mt19937 random{ 5489u };
+		auto randomInt = [&random](int32 min, int32 max) { return std::uniform_int_distribution<int32>(min, max)(random); };
+		auto randomColor = [&random]() { return static_cast<uint32>(random()) & 0x00FFFFFF; };
+
+		const int32 w{ static_cast<int32>(width) };
+		const int32 h{ static_cast<int32>(height) };
+		const uint32 commandCount{ static_cast<uint32>(static_cast<uint64>(2000) * width * height / (800 * 600)) };
+
+		vTextLayouts.clear();
+		vTextLayouts.resize(16);
+		for (TextLayout& textLayout : vTextLayouts)
+		{
+			textLayout.build(glyphAtlas, L"The quick brown fox jumps over 13 lazy dogs", randomInt(-100, w), randomInt(-10, h));
+		}
+
+		const std::wstring_view kTexts[]{ L"Hello", L"Tile binning 64x64", L"FPS 60", L"0123456789 abc XYZ" };
+		std::vector<Float2> vPoints{};
+		commandList.clear();
+		for (uint32 i = 0; i < commandCount; ++i)
+		{
+			// layer가 섞여 있어야 타일 안의 실행 순서를 제대로 확인할 수 있다.
+			commandList.setLayer(static_cast<uint16>(randomInt(0, 3)));
+
+			const int32 x{ randomInt(-40, w) };
+			const int32 y{ randomInt(-40, h) };
+			switch (randomInt(0, 9))
+			{
+			case 0:
+			case 1:
+				commandList.add(DrawCommandList::makeRectangle(x, y, randomInt(1, 120), randomInt(1, 120), randomColor(), static_cast<uint8>(randomInt(0, 1) * 127 + 128)));
+				break;
+			case 2:
+				commandList.add(DrawCommandList::makeImage(static_cast<EDrawCommandType>(randomInt(static_cast<int32>(EDrawCommandType::Image), static_cast<int32>(EDrawCommandType::ImagePremultipliedAlpha))),
+					0, x, y, 48, 48, static_cast<uint8>(randomInt(32, 255))));
+				break;
+			case 3:
+				commandList.add(DrawCommandList::makeLine(x, y, x + randomInt(-200, 200), y + randomInt(-200, 200), randomColor()));
+				break;
+			case 4:
+				commandList.add(DrawCommandList::makeLineAntialiased(x + 0.25f, y + 0.5f, x + randomInt(-200, 200) + 0.75f, y + randomInt(-200, 200) + 0.125f, randomColor()));
+				break;
+			case 5:
+			case 6:
+			{
+				vPoints.clear();
+				const int32 pointCount{ randomInt(2, 6) };
+				for (int32 pointIndex = 0; pointIndex < pointCount; ++pointIndex)
+				{
+					vPoints.emplace_back(Float2(static_cast<float>(x + randomInt(-60, 60)) + 0.5f, static_cast<float>(y + randomInt(-60, 60))));
+				}
+				const DrawCommand command{ DrawCommandList::makePolyline(vPoints, static_cast<float>(randomInt(1, 12)) * 0.75f,
+					static_cast<ELineJoin>(randomInt(0, 2)), static_cast<ELineCap>(randomInt(0, 2)), randomColor(), static_cast<uint8>(randomInt(64, 255))) };
+				commandList.add(command, vPoints);
+				break;
+			}
+			case 7:
+			case 8:
+			{
+				const std::wstring_view text{ kTexts[randomInt(0, 3)] };
+				commandList.add(DrawCommandList::makeText(0, x, y, x + 200, y + 20, randomColor(), 0, static_cast<uint32>(text.size())), text.data());
+				break;
+			}
+			default:
+			{
+				const uint32 layoutIndex{ static_cast<uint32>(randomInt(0, static_cast<int32>(vTextLayouts.size()) - 1)) };
+				int32 left{}, top{}, right{}, bottom{};
+				vTextLayouts[layoutIndex].getBounds(left, top, right, bottom);
+				commandList.add(DrawCommandList::makeTextLayout(layoutIndex, 0, left, top, right, bottom, randomColor()));
+				break;
+			}
+			}
+		}
+	}
+
+	static void buildTestImage(Framebuffer& image)
+	{
+		image.resize(48, 48);
+		for (uint32 y = 0; y < image.getHeight(); ++y)
+		{
+			uint32* const row{ image.getPixels() + static_cast<size_t>(y) * image.getStride() };
+			for (uint32 x = 0; x < image.getWidth(); ++x)
+			{
+				// premultiplied alpha로도 올바른 값이 되도록 색은 alpha 이하로 둔다. 0은 color key
+				const uint32 alpha{ (x * 5 + y * 3) & 0xFF };
+				row[x] = ((x + y) % 7 == 0) ? 0 : (alpha << 24) | ((alpha * x / 48) << 16) | ((alpha * y / 48) << 8) | (alpha / 2);
+			}
+		}
+	}
+
+	static bool comparePixels(const Framebuffer& a, const Framebuffer& b)
+	{
+		for (uint32 y = 0; y < a.getHeight(); ++y)
+		{
+			for (uint32 x = 0; x < a.getWidth(); ++x)
+			{
+				if (a.getPixel(x, y) != b.getPixel(x, y))
+				{
+					std::printf("  mismatch at (%u, %u): replay 0x%08X, tiled 0x%08X\n", x, y, a.getPixel(x, y), b.getPixel(x, y));
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	static bool runTest(uint32 width, uint32 height, uint32 frameCount, uint32 maxThreadCount, const Framebuffer& image, const GlyphAtlas& glyphAtlas)
+	{
+		DrawCommandList commandList{};
+		std::vector<TextLayout> vTextLayouts{};
+		buildTestScene(commandList, vTextLayouts, glyphAtlas, width, height);
+
+		Framebuffer replayTarget{ width, height };
+		TestCommandExecutor executor{ replayTarget, image, glyphAtlas, vTextLayouts };
+		const double replayMilliseconds
+		{
+			measureMilliseconds(frameCount, [&]()
+				{
+					replayTarget.clear(0xFF202020);
+					commandList.replay(executor);
+				})
+		};
+		std::printf("%ux%u, %u commands\n", width, height, commandList.getCommandCount());
+		std::printf("  replay            %8.3f ms\n", replayMilliseconds);
+
+		bool bPassed{ true };
+		Framebuffer tiledTarget{ width, height };
+		for (uint32 threadCount = 1; threadCount <= maxThreadCount; ++threadCount)
+		{
+			TileRasterizer tileRasterizer{ threadCount };
+			const double tiledMilliseconds
+			{
+				measureMilliseconds(frameCount, [&]()
+					{
+						tiledTarget.clear(0xFF202020);
+						tileRasterizer.rasterize(commandList, tiledTarget, executor);
+					})
+			};
+			const bool bSame{ comparePixels(replayTarget, tiledTarget) };
+			std::printf("  tiled %2u threads  %8.3f ms  x%.2f  %s\n", threadCount, tiledMilliseconds, replayMilliseconds / tiledMilliseconds,
+				(bSame == true) ? "same" : "DIFFERENT");
+			bPassed = bPassed && bSame;
+		}
+		return bPassed;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	using namespace fs;
+
+	const uint32 frameCount{ (argc > 1) ? static_cast<uint32>(std::max(1, std::atoi(argv[1]))) : 3u };
+	// 기본은 하드웨어 스레드 수. 코어가 적은 환경에서도 여러 스레드의 결과를 확인할 수 있도록 4개보다 적게는 하지 않는다.
+	const uint32 maxThreadCount{ (argc > 2) ? static_cast<uint32>(std::max(1, std::atoi(argv[2]))) : std::max(4u, std::thread::hardware_concurrency()) };
+
+	Framebuffer image{};
+	buildTestImage(image);
+	GlyphAtlas glyphAtlas{};
+	buildTestGlyphAtlas(glyphAtlas);
+
+	bool bPassed{ true };
+	bPassed = runTest(800, 600, frameCount, maxThreadCount, image, glyphAtlas) && bPassed;
+	bPassed = runTest(3840, 2160, frameCount, maxThreadCount, image, glyphAtlas) && bPassed;
+	std::printf("%s\n", (bPassed == true) ? "PASSED" : "FAILED");
+	return (bPassed == true) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
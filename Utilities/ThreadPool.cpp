@@ -0,0 +1,161 @@
+﻿#include "ThreadPool.h"
+
+
+namespace fs
+{
+	ThreadPool::ThreadPool(uint32 threadCount)
+	{
+		_threadCount = (threadCount == 0) ? static_cast<uint32>(std::thread::hardware_concurrency()) : threadCount;
+		if (_threadCount == 0)
+		{
+			_threadCount = 1;
+		}
+
+		_taskRanges.reset(new TaskRange[_threadCount]);
+
+		// 0번은 parallelFor()를 호출한 스레드
+		for (uint32 threadIndex = 1; threadIndex < _threadCount; ++threadIndex)
+		{
+			_vThreads.emplace_back(&ThreadPool::workerLoop, this, threadIndex);
+		}
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock{ _mutex };
+			_bStop = true;
+		}
+		_startCondition.notify_all();
+
+		for (auto& thread : _vThreads)
+		{
+			thread.join();
+		}
+	}
+
+	void ThreadPool::run(uint32 taskCount, TaskFunction taskFunction, const void* taskContext)
+	{
+		if (taskCount == 0) return;
+
+		if (_threadCount == 1 || taskCount == 1)
+		{
+			for (uint32 taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+			{
+				taskFunction(taskContext, taskIndex, 0);
+			}
+			return;
+		}
+
+		// task를 스레드 수만큼 연속된 구간으로 나눈다.
+		for (uint32 threadIndex = 0; threadIndex < _threadCount; ++threadIndex)
+		{
+			TaskRange& taskRange{ _taskRanges[threadIndex] };
+			std::lock_guard<std::mutex> lock{ taskRange.mutex };
+			taskRange.begin = static_cast<uint32>(static_cast<uint64>(taskCount) * threadIndex / _threadCount);
+			taskRange.end = static_cast<uint32>(static_cast<uint64>(taskCount) * (threadIndex + 1) / _threadCount);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock{ _mutex };
+			_taskFunction = taskFunction;
+			_taskContext = taskContext;
+			_runningWorkerCount = _threadCount - 1;
+			++_generation;
+		}
+		_startCondition.notify_all();
+
+		runTasks(0);
+
+		std::unique_lock<std::mutex> lock{ _mutex };
+		_finishCondition.wait(lock, [this] { return _runningWorkerCount == 0; });
+		_taskFunction = nullptr;
+		_taskContext = nullptr;
+	}
+
+	uint32 ThreadPool::getThreadCount() const noexcept
+	{
+		return _threadCount;
+	}
+
+	void ThreadPool::workerLoop(uint32 threadIndex)
+	{
+		uint64 generation{};
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock{ _mutex };
+				_startCondition.wait(lock, [this, generation] { return _bStop == true || _generation != generation; });
+				if (_bStop == true) return;
+				generation = _generation;
+			}
+
+			runTasks(threadIndex);
+
+			{
+				std::lock_guard<std::mutex> lock{ _mutex };
+				--_runningWorkerCount;
+				if (_runningWorkerCount == 0)
+				{
+					_finishCondition.notify_one();
+				}
+			}
+		}
+	}
+
+	void ThreadPool::runTasks(uint32 threadIndex)
+	{
+		const TaskFunction taskFunction{ _taskFunction };
+		const void* const taskContext{ _taskContext };
+		while (true)
+		{
+			uint32 taskIndex{};
+			if (popTask(threadIndex, taskIndex) == true)
+			{
+				taskFunction(taskContext, taskIndex, threadIndex);
+			}
+			else if (stealTasks(threadIndex) == false)
+			{
+				return;
+			}
+		}
+	}
+
+	bool ThreadPool::popTask(uint32 threadIndex, uint32& taskIndex) noexcept
+	{
+		TaskRange& taskRange{ _taskRanges[threadIndex] };
+		std::lock_guard<std::mutex> lock{ taskRange.mutex };
+		if (taskRange.begin == taskRange.end) return false;
+
+		taskIndex = taskRange.begin++;
+		return true;
+	}
+
+	bool ThreadPool::stealTasks(uint32 threadIndex) noexcept
+	{
+		for (uint32 offset = 1; offset < _threadCount; ++offset)
+		{
+			TaskRange& victim{ _taskRanges[(threadIndex + offset) % _threadCount] };
+			uint32 begin{};
+			uint32 end{};
+			{
+				std::lock_guard<std::mutex> lock{ victim.mutex };
+				const uint32 remaining{ victim.end - victim.begin };
+				if (remaining == 0) continue;
+
+				// 남은 구간의 뒤쪽 절반(홀수면 더 큰 쪽)을 가져온다.
+				end = victim.end;
+				begin = victim.end - (remaining + 1) / 2;
+				victim.end = begin;
+			}
+
+			// 자기 구간은 비어 있으므로 다른 스레드가 여기서 가져갈 것은 없다.
+			TaskRange& own{ _taskRanges[threadIndex] };
+			std::lock_guard<std::mutex> lock{ own.mutex };
+			own.begin = begin;
+			own.end = end;
+			return true;
+		}
+		return false;
+	}
+}
@@ -0,0 +1,88 @@
+﻿#pragma once
+
+
+#ifndef FS_THREAD_POOL_H
+#define FS_THREAD_POOL_H
+// === HEADER BEGINS ===
+
+
+#include <Core/_CommonTypes.h>
+
+#include <condition_variable>
+#include <memory>
+
+
+namespace fs
+{
+	// parallelFor() 전용 스레드 풀.
+	// task들을 스레드마다 연속된 구간으로 나누어 주고, 자기 구간을 다 끝낸 스레드는
+	// 다른 스레드의 남은 구간 뒤쪽 절반을 가져와서(work stealing) 실행한다.
+	class ThreadPool final
+	{
+	public:
+		// threadCount는 호출한 스레드를 포함한 수. 0이면 std::thread::hardware_concurrency()
+		explicit ThreadPool(uint32 threadCount = 0);
+		~ThreadPool();
+
+	public:
+		// task(taskIndex, threadIndex)를 [0, taskCount)에 대해 한 번씩 실행하고, 모두 끝나면 돌아온다.
+		// 호출한 스레드도 threadIndex 0으로 함께 실행한다.
+		// task는 std::function으로 감싸지 않고 주소만 넘기므로 힙 할당이 없다.
+		template <typename Task>
+		void parallelFor(uint32 taskCount, const Task& task);
+
+	public:
+		uint32 getThreadCount() const noexcept;
+
+	private:
+		using TaskFunction = void(*)(const void* context, uint32 taskIndex, uint32 threadIndex);
+
+		void run(uint32 taskCount, TaskFunction taskFunction, const void* taskContext);
+		void workerLoop(uint32 threadIndex);
+
+		// 자기 구간과 훔쳐 온 구간의 task를 더 이상 없을 때까지 실행한다.
+		void runTasks(uint32 threadIndex);
+		bool popTask(uint32 threadIndex, uint32& taskIndex) noexcept;
+		bool stealTasks(uint32 threadIndex) noexcept;
+
+	private:
+		// false sharing을 막기 위해 캐시 라인 단위로 정렬한다.
+		struct alignas(64) TaskRange
+		{
+			std::mutex	mutex{};
+			uint32		begin{};
+			uint32		end{};
+		};
+
+	private:
+		uint32											_threadCount{};
+		std::vector<std::thread>						_vThreads{};
+		std::unique_ptr<TaskRange[]>					_taskRanges{};
+
+	private:
+		std::mutex										_mutex{};
+		std::condition_variable							_startCondition{};
+		std::condition_variable							_finishCondition{};
+		TaskFunction									_taskFunction{};
+		const void*										_taskContext{};
+		uint64											_generation{};
+		uint32											_runningWorkerCount{};
+		bool											_bStop{ false };
+	};
+
+
+	template <typename Task>
+	inline void ThreadPool::parallelFor(uint32 taskCount, const Task& task)
+	{
+		run(taskCount,
+			[](const void* context, uint32 taskIndex, uint32 threadIndex)
+			{
+				(*static_cast<const Task*>(context))(taskIndex, threadIndex);
+			},
+			&task);
+	}
+}
+
+
+// === HEADER ENDS ===
+#endif // !FS_THREAD_POOL_H
@@ -1,12 +1,13 @@
 ﻿#include "Line3DWindow.h"
 
+#include <cassert>
+
 
 namespace fs
 {
-	Line3DWindow::Line3DWindow(float width, float height) : IWin32GdiWindow(width, height)
+	Line3DWindow::Line3DWindow(float width, float height) : IWin32GdiWindow(width, height), _rotation{ 1, 0, 0, 0 }, _scaling{ 1, 1, 1, 0 }
 	{
-		_rotationAxis = float4(1, 0, 0, 0);
-		_rotationAngle = 0;
+		__noop;
 	}
 
 	Line3DWindow::~Line3DWindow()
@@ -25,96 +26,133 @@ namespace fs
 
 	void Line3DWindow::translate(float x, float y, float z) noexcept
 	{
-		_translationMatrix = float4x4::translationMatrix(x, y, z);
+		_translation = float4(x, y, z, 0);
 	}
 
 	void Line3DWindow::scale(float x, float y, float z) noexcept
 	{
-		_scalingMatrix = float4x4::scalingMatrix(x, y, z);
+		_scaling = float4(x, y, z, 0);
 	}
 
 	void Line3DWindow::rotateAroundXAxis(float angle) noexcept
 	{
-		_rotationMatrix = float4x4::rotationMatrixX(angle) * _rotationMatrix;
+		rotateAxisAngle(float4(1, 0, 0, 0), angle);
 	}
 
 	void Line3DWindow::rotateAroundYAxis(float angle) noexcept
 	{
-		_rotationMatrix = float4x4::rotationMatrixY(angle) * _rotationMatrix;
+		rotateAxisAngle(float4(0, 1, 0, 0), angle);
 	}
 
 	void Line3DWindow::rotateAroundZAxis(float angle) noexcept
 	{
-		_rotationMatrix = float4x4::rotationMatrixZ(angle) * _rotationMatrix;
+		rotateAxisAngle(float4(0, 0, 1, 0), angle);
 	}
 
 	void Line3DWindow::rotateAxisAngle(const float4& axis, float angle) noexcept
 	{
-		_rotationAxis = axis;
-		_rotationAngle += angle;
+		// Renormalized so the rounding error of many small rotations does not add up.
+		_rotation = quaternion::normalize(quaternion::rotationQuaternion(axis, angle) * _rotation);
+	}
+
+	uint32 Line3DWindow::addVertex(const float4& position, const Color& color) noexcept
+	{
+		_vVertices.emplace_back(position);
+		_vVertexColors.emplace_back(color);
+		return static_cast<uint32>(_vVertices.size() - 1);
+	}
+
+	void Line3DWindow::addEdge(uint32 indexA, uint32 indexB) noexcept
+	{
+		assert(indexA < static_cast<uint32>(_vVertices.size()) && indexB < static_cast<uint32>(_vVertices.size()));
 
-		_rotationMatrix = float4x4::rotationMatrixAxisAngle(_rotationAxis, _rotationAngle);
+		addEdge(indexA, indexB, _vVertexColors[indexA]);
+	}
+
+	void Line3DWindow::addEdge(uint32 indexA, uint32 indexB, const Color& color) noexcept
+	{
+		assert(indexA < static_cast<uint32>(_vVertices.size()) && indexB < static_cast<uint32>(_vVertices.size()));
+
+		if (_vIndices32.empty() == true && indexA <= 0xFFFF && indexB <= 0xFFFF)
+		{
+			_vIndices16.emplace_back(static_cast<uint16>(indexA));
+			_vIndices16.emplace_back(static_cast<uint16>(indexB));
+		}
+		else
+		{
+			if (_vIndices16.empty() == false)
+			{
+				_vIndices32.assign(_vIndices16.begin(), _vIndices16.end());
+				_vIndices16.clear();
+				_vIndices16.shrink_to_fit();
+			}
+			_vIndices32.emplace_back(indexA);
+			_vIndices32.emplace_back(indexB);
+		}
+		_vEdgeColors.emplace_back(color);
 	}
 
 	void Line3DWindow::addLine(const float4& positionA, const float4& positionB, const Color& color) noexcept
 	{
-		_vVertices.emplace_back(positionA);
-		_vVertices.emplace_back(positionB);
-		_vLineColors.emplace_back(color);
+		const uint32 indexA{ addVertex(positionA, color) };
+		const uint32 indexB{ addVertex(positionB, color) };
+		addEdge(indexA, indexB, color);
 	}
 
 	void Line3DWindow::drawLines() const noexcept
 	{
-		if (_vVertices.size() > 0)
+		if (_vEdgeColors.size() > 0)
 		{
-			for (uint32 i = 0; i < static_cast<uint32>(_vLineColors.size()); ++i)
+			// transform every vertex once
+			_vClipVertices.resize(_vVertices.size());
+			float4x4::mulBatch(getWorldProjectionMatrix(), _vVertices.data(), _vClipVertices.data(), _vVertices.size());
+
+			// clip against the view frustum before the perspective divide
+			const uint32 edgeCount{ getEdgeCount() };
+			_vOutcodes.resize(_vClipVertices.size());
+			_vClippedLines.resize(edgeCount);
+			LineClipper::computeOutcodes(_vClipVertices.data(), _vOutcodes.data(), _vClipVertices.size());
+			const uint32 visibleLineCount
 			{
-				float4 vertexA{ _vVertices[static_cast<uint64>(i) * 2 + 0] };
-				float4 vertexB{ _vVertices[static_cast<uint64>(i) * 2 + 1] };
-
-				// SRT world
-				//const float4x4 worldMatrix = _translationMatrix * _rotationMatrix * _scalingMatrix;
-				//vertexA = worldMatrix * vertexA;
-				//vertexB = worldMatrix * vertexB;
-
-
-				// SRT with Quaternion
-				vertexA = _scalingMatrix * vertexA;
-				vertexB = _scalingMatrix * vertexB;
-
-				const quaternion q = quaternion::rotationQuaternion(_rotationAxis, _rotationAngle);
-				const quaternion qReciprocal = q.reciprocal();
-				vertexA = float4(q * quaternion(vertexA) * qReciprocal);
-				vertexB = float4(q * quaternion(vertexB) * qReciprocal);
-
-				vertexA = _translationMatrix * vertexA;
-				vertexB = _translationMatrix * vertexB;
-
-
-				// behind the eye
-				if (vertexA.getZ() > 0 && vertexB.getZ() > 0) continue;
-
-				// project
-				vertexA = _projectionMatrix * vertexA;
-				vertexB = _projectionMatrix * vertexB;
-				if (vertexA.getW() == 0)
-				{
-					vertexA.setW(1.0f);
-				}
-				if (vertexB.getW() == 0)
-				{
-					vertexA.setW(1.0f);
-
-				}
-				vertexA /= vertexA.getW();
-				vertexB /= vertexB.getW();
-
-				__super::drawLineToScreenNormalized(
-					Position2(vertexA.getX(), vertexA.getY()),
-					Position2(vertexB.getX(), vertexB.getY()),
-					_vLineColors[i]);
+				(_vIndices32.empty() == true)
+				? LineClipper::clipLines(_vClipVertices.data(), _vOutcodes.data(), _vIndices16.data(), edgeCount, _vClippedLines.data())
+				: LineClipper::clipLines(_vClipVertices.data(), _vOutcodes.data(), _vIndices32.data(), edgeCount, _vClippedLines.data())
+			};
+
+			// submit every visible line in one batch
+			_vLineEndpoints.resize(static_cast<size_t>(visibleLineCount) * 2);
+			_vLineColors.resize(visibleLineCount);
+			for (uint32 i = 0; i < visibleLineCount; ++i)
+			{
+				const ClippedLine& clippedLine{ _vClippedLines[i] };
+				_vLineEndpoints[static_cast<size_t>(i) * 2] = clippedLine.a;
+				_vLineEndpoints[static_cast<size_t>(i) * 2 + 1] = clippedLine.b;
+				_vLineColors[i] = _vEdgeColors[clippedLine.lineIndex];
 			}
+			__super::drawLinesToScreenNormalized(_vLineEndpoints, _vLineColors);
 		}
 	}
 
+	uint32 Line3DWindow::getVertexCount() const noexcept
+	{
+		return static_cast<uint32>(_vVertices.size());
+	}
+
+	uint32 Line3DWindow::getEdgeCount() const noexcept
+	{
+		return static_cast<uint32>(_vEdgeColors.size());
+	}
+
+	affine3x4 Line3DWindow::getWorldMatrix() const noexcept
+	{
+		// built directly from T, R and S; no matrix products
+		return affine3x4::translationRotationScaling(_translation, _rotation, _scaling);
+	}
+
+	float4x4 Line3DWindow::getWorldProjectionMatrix() const noexcept
+	{
+		// The quaternion becomes a matrix once per frame; the whole mesh is then transformed by the single mulBatch() with the combined matrix.
+		// Projection is not affine, so only this last product is 4x4.
+		return _projectionMatrix * getWorldMatrix().toFloat4x4();
+	}
 }
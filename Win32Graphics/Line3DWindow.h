@@ -9,6 +9,8 @@
 #include <Core/IWin32GdiWindow.h>
 #include <Core/Float4.h>
 #include <Core/Float4x4.h>
+#include <Core/Affine3x4.h>
+#include <Core/LineClipper.h>
 
 
 namespace fs
@@ -33,21 +35,51 @@ namespace fs
 		void rotateAxisAngle(const float4& axis, float angle) noexcept;
 
 	public:
+		// indexed line mesh: each vertex is stored and transformed once, however many edges share it
+		// returns the index of the new vertex
+		uint32 addVertex(const float4& position, const Color& color = Color()) noexcept;
+		// uses the color of vertex A
+		void addEdge(uint32 indexA, uint32 indexB) noexcept;
+		void addEdge(uint32 indexA, uint32 indexB, const Color& color) noexcept;
+
+		// adds two new vertices and an edge between them (nothing is shared)
 		void addLine(const float4& positionA, const float4& positionB, const Color& color) noexcept;
 		void drawLines() const noexcept;
 
+	public:
+		uint32 getVertexCount() const noexcept;
+		uint32 getEdgeCount() const noexcept;
+
 	private:
-		float4				_rotationAxis;
-		float				_rotationAngle;
+		// translation * rotation (quaternion) * scaling
+		affine3x4 getWorldMatrix() const noexcept;
+		// projection * world
+		float4x4 getWorldProjectionMatrix() const noexcept;
+
+	private:
+		// accumulated rotation (unit quaternion)
+		quaternion			_rotation;
+		// w is not used
+		float4				_translation;
+		float4				_scaling;
 
 		float4x4			_projectionMatrix;
-		float4x4			_translationMatrix;
-		float4x4			_rotationMatrix;
-		float4x4			_scalingMatrix;
 
 	private:
 		std::vector<float4>	_vVertices;
-		std::vector<Color>	_vLineColors;
+		std::vector<Color>	_vVertexColors;
+
+		// two indices per edge. 16-bit until an index no longer fits, then all of them move to 32-bit.
+		std::vector<uint16>	_vIndices16;
+		std::vector<uint32>	_vIndices32;
+		std::vector<Color>	_vEdgeColors;
+
+		// clip-space vertices of the current frame (reused every frame)
+		mutable std::vector<float4>	_vClipVertices;
+		mutable std::vector<uint8>	_vOutcodes;
+		mutable std::vector<ClippedLine>	_vClippedLines;
+		mutable std::vector<Position2>		_vLineEndpoints;
+		mutable std::vector<Color>			_vLineColors;
 	};
 }
 
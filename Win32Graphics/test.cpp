@@ -19,27 +19,45 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 
 	g_Line3DWindow.addFont(L"Consolas", 20, false);
 
+	// 큐브는 키를 누를 때만 움직이므로, 대부분의 프레임에서는 FPS 글자만 다시 그려진다.
+	g_Line3DWindow.setDirtyRegionTracking(true);
+
 	static constexpr Color clearColor{ 0.875f, 0.875f, 1.0f };
 
 	g_Line3DWindow.setProjectionMatrix(3.14f / 3.0f, 0.1f, 10.0f);
 
+	// cube corners (front: z = +0.5, back: z = -0.5), built at compile time
+	static constexpr float4 kCubeCorners[8]
+	{
+		float4(-0.5f, +0.5f, +0.5f, 1), float4(+0.5f, +0.5f, +0.5f, 1), float4(+0.5f, -0.5f, +0.5f, 1), float4(-0.5f, -0.5f, +0.5f, 1),
+		float4(-0.5f, +0.5f, -0.5f, 1), float4(+0.5f, +0.5f, -0.5f, 1), float4(+0.5f, -0.5f, -0.5f, 1), float4(-0.5f, -0.5f, -0.5f, 1),
+	};
+	const uint32 frontLT{ g_Line3DWindow.addVertex(kCubeCorners[0]) };
+	const uint32 frontRT{ g_Line3DWindow.addVertex(kCubeCorners[1]) };
+	const uint32 frontRB{ g_Line3DWindow.addVertex(kCubeCorners[2]) };
+	const uint32 frontLB{ g_Line3DWindow.addVertex(kCubeCorners[3]) };
+	const uint32 backLT{ g_Line3DWindow.addVertex(kCubeCorners[4]) };
+	const uint32 backRT{ g_Line3DWindow.addVertex(kCubeCorners[5]) };
+	const uint32 backRB{ g_Line3DWindow.addVertex(kCubeCorners[6]) };
+	const uint32 backLB{ g_Line3DWindow.addVertex(kCubeCorners[7]) };
+
 	// front
-	g_Line3DWindow.addLine(float4(-0.5f, +0.5f, +0.5f, 1), float4(+0.5f, +0.5f, +0.5f, 1), Color(1.0f, 0, 0));
-	g_Line3DWindow.addLine(float4(+0.5f, +0.5f, +0.5f, 1), float4(+0.5f, -0.5f, +0.5f, 1), Color(1.0f, 0, 0));
-	g_Line3DWindow.addLine(float4(-0.5f, -0.5f, +0.5f, 1), float4(+0.5f, -0.5f, +0.5f, 1), Color(1.0f, 0, 0));
-	g_Line3DWindow.addLine(float4(-0.5f, +0.5f, +0.5f, 1), float4(-0.5f, -0.5f, +0.5f, 1), Color(1.0f, 0, 0));
+	g_Line3DWindow.addEdge(frontLT, frontRT, Color(1.0f, 0, 0));
+	g_Line3DWindow.addEdge(frontRT, frontRB, Color(1.0f, 0, 0));
+	g_Line3DWindow.addEdge(frontLB, frontRB, Color(1.0f, 0, 0));
+	g_Line3DWindow.addEdge(frontLT, frontLB, Color(1.0f, 0, 0));
 
 	// back
-	g_Line3DWindow.addLine(float4(-0.5f, +0.5f, -0.5f, 1), float4(+0.5f, +0.5f, -0.5f, 1), Color(0, 0, 1.0f));
-	g_Line3DWindow.addLine(float4(+0.5f, +0.5f, -0.5f, 1), float4(+0.5f, -0.5f, -0.5f, 1), Color(0, 0, 1.0f));
-	g_Line3DWindow.addLine(float4(-0.5f, -0.5f, -0.5f, 1), float4(+0.5f, -0.5f, -0.5f, 1), Color(0, 0, 1.0f));
-	g_Line3DWindow.addLine(float4(-0.5f, +0.5f, -0.5f, 1), float4(-0.5f, -0.5f, -0.5f, 1), Color(0, 0, 1.0f));
+	g_Line3DWindow.addEdge(backLT, backRT, Color(0, 0, 1.0f));
+	g_Line3DWindow.addEdge(backRT, backRB, Color(0, 0, 1.0f));
+	g_Line3DWindow.addEdge(backLB, backRB, Color(0, 0, 1.0f));
+	g_Line3DWindow.addEdge(backLT, backLB, Color(0, 0, 1.0f));
 
 	// sides
-	g_Line3DWindow.addLine(float4(-0.5f, +0.5f, +0.5f, 1), float4(-0.5f, +0.5f, -0.5f, 1), Color(0, 1.0f, 0));
-	g_Line3DWindow.addLine(float4(+0.5f, +0.5f, +0.5f, 1), float4(+0.5f, +0.5f, -0.5f, 1), Color(0, 1.0f, 0));
-	g_Line3DWindow.addLine(float4(-0.5f, -0.5f, +0.5f, 1), float4(-0.5f, -0.5f, -0.5f, 1), Color(0, 1.0f, 0));
-	g_Line3DWindow.addLine(float4(+0.5f, -0.5f, +0.5f, 1), float4(+0.5f, -0.5f, -0.5f, 1), Color(0, 1.0f, 0));
+	g_Line3DWindow.addEdge(frontLT, backLT, Color(0, 1.0f, 0));
+	g_Line3DWindow.addEdge(frontRT, backRT, Color(0, 1.0f, 0));
+	g_Line3DWindow.addEdge(frontLB, backLB, Color(0, 1.0f, 0));
+	g_Line3DWindow.addEdge(frontRB, backRB, Color(0, 1.0f, 0));
 
 	// world translation
 	g_Line3DWindow.translate(0, 0, -2.0f);
@@ -70,7 +88,9 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 
 			g_Line3DWindow.drawTextToScreen(Position2(100, 0), L"Test Window", Color(0.75f, 0.25f, 0.25f));
 
-			g_Line3DWindow.drawTextToScreen(Position2(300, 0), L"FPS: " + g_Line3DWindow.getFpsWstring(), Color(0, 0.25f, 0.25f));
+			FixedWstring<32> fpsText{ L"FPS: " };
+			fpsText.append(g_Line3DWindow.getFpsText());
+			g_Line3DWindow.drawTextToScreen(Position2(300, 0), fpsText.view(), Color(0, 0.25f, 0.25f));
 
 			g_Line3DWindow.drawLines();
 